@@ -17,6 +17,15 @@
 #include "HeavyContext.hpp"
 #include "HvTable.h"
 
+#if HV_LIGHTPIPE_SPSC
+// the pipes are lock-free for one sending thread and the audio thread, nothing to serialise
+#define HV_QUEUE_LOCK_ACQUIRE(_x)
+#define HV_QUEUE_LOCK_RELEASE(_x)
+#else
+#define HV_QUEUE_LOCK_ACQUIRE(_x) HV_SPINLOCK_ACQUIRE(_x)
+#define HV_QUEUE_LOCK_RELEASE(_x) HV_SPINLOCK_RELEASE(_x)
+#endif
+
 void defaultSendHook(HeavyContextInterface *context,
     const char *sendName, hv_uint32_t sendHash, const HvMessage *msg) {
   HeavyContext *thisContext = reinterpret_cast<HeavyContext *>(context);
@@ -48,6 +57,7 @@ HeavyContext::HeavyContext(double sampleRate, int poolKb, int inQueueKb, int out
   // if outQueueKb is positive, then the outQueue is allocated and the default sendhook is set.
   // Otherwise outQueue and the sendhook are set to NULL.
   sendHook = (outQueueKb > 0) ? &defaultSendHook : nullptr;
+  inQueueReservedBytes = 0;
 
   HV_SPINLOCK_RELEASE(inQueueLock);
   HV_SPINLOCK_RELEASE(outQueueLock);
@@ -57,26 +67,69 @@ HeavyContext::HeavyContext(double sampleRate, int poolKb, int inQueueKb, int out
   numBytes += mq_initWithPoolSize(&mq, poolKb);
   numBytes += hLp_init(&inQueue, inQueueKb * 1024);
   numBytes += hLp_init(&outQueue, outQueueKb * 1024); // outQueueKb value of 0 sets everything to NULL
+  hPb_init(&params, 0); // sized by initParameters() once the subclass can answer getParameterInfo()
 }
 
 HeavyContext::~HeavyContext() {
   mq_free(&mq);
   hLp_free(&inQueue);
   hLp_free(&outQueue);
+  hPb_free(&params);
+}
+
+hv_size_t HeavyContext::initParameters() {
+  const int numParams = getParameterInfo(0, nullptr);
+  if (numParams <= 0) return 0;
+  hPb_free(&params);
+  const hv_size_t paramBytes = hPb_init(&params, (hv_uint32_t) numParams);
+  for (int i = 0; i < numParams; ++i) {
+    HvParameterInfo info;
+    getParameterInfo(i, &info);
+    hPb_setDefault(&params, (hv_uint32_t) i, info.hash, info.defaultVal);
+  }
+  return paramBytes;
+}
+
+void HV_HOT(HeavyContext::processParameters)(int n) {
+  const hv_uint32_t numChanged = hPb_update(&params, (hv_uint32_t) n);
+  for (hv_uint32_t k = 0; k < numChanged; ++k) {
+    // the value at the end of the block, as a float message at the start of the block
+    const hv_uint32_t i = params.changed[k];
+    HvMessage *m = HV_MESSAGE_ON_STACK(1);
+    msg_initWithFloat(m, blockStartTimestamp, hPb_getValue(&params, i));
+    scheduleMessageForReceiver(params.hashes[i], m);
+  }
+}
+
+bool HV_HOT(HeavyContext::setParameter)(int index, float value) {
+  return (index >= 0) && hPb_set(&params, (hv_uint32_t) index, 1, &value);
+}
+
+bool HeavyContext::setParameters(int index, int count, const float *values) {
+  hv_assert(values != nullptr);
+  return (index >= 0) && (count >= 0) && hPb_set(&params, (hv_uint32_t) index, (hv_uint32_t) count, values);
+}
+
+bool HeavyContext::setParameterSmoothing(int index, float ms) {
+  if (index < 0 || index >= (int) params.numParams) return false;
+  hPb_setSmoothing(&params, (hv_uint32_t) index, millisecondsToSamples(ms));
+  return true;
 }
 
 bool HeavyContext::sendBangToReceiver(hv_uint32_t receiverHash) {
-  HvMessage *m = HV_MESSAGE_ON_STACK(1);
-  msg_initWithBang(m, 0);
-  bool success = sendMessageToReceiver(receiverHash, 0.0, m);
-  return success;
+  HvMessage *m = reserveMessageForReceiver(receiverHash, 0.0, 1);
+  if (m == nullptr) return false;
+  msg_setBang(m, 0);
+  commitMessage();
+  return true;
 }
 
-bool HeavyContext::sendFloatToReceiver(hv_uint32_t receiverHash, float f) {
-  HvMessage *m = HV_MESSAGE_ON_STACK(1);
-  msg_initWithFloat(m, 0, f);
-  bool success = sendMessageToReceiver(receiverHash, 0.0, m);
-  return success;
+bool HV_HOT(HeavyContext::sendFloatToReceiver)(hv_uint32_t receiverHash, float f) {
+  HvMessage *m = reserveMessageForReceiver(receiverHash, 0.0, 1);
+  if (m == nullptr) return false;
+  msg_setFloat(m, 0, f);
+  commitMessage();
+  return true;
 }
 
 bool HeavyContext::sendSymbolToReceiver(hv_uint32_t receiverHash, const char *s) {
@@ -94,20 +147,38 @@ bool HeavyContext::sendMessageToReceiverV(hv_uint32_t receiverHash, double delay
   va_list ap;
   va_start(ap, format);
   const int numElem = (int) hv_strlen(format);
-  HvMessage *m = HV_MESSAGE_ON_STACK(numElem);
-  msg_init(m, numElem, blockStartTimestamp + (hv_uint32_t) (hv_max_d(0.0, delayMs)*getSampleRate()/1000.0));
-  for (int i = 0; i < numElem; i++) {
-    switch (format[i]) {
-      case 'b': msg_setBang(m, i); break;
-      case 'f': msg_setFloat(m, i, (float) va_arg(ap, double)); break;
-      case 'h': msg_setHash(m, i, (int) va_arg(ap, int)); break;
-      case 's': msg_setSymbol(m, i, (char *) va_arg(ap, char *)); break;
-      default: break;
+  bool success;
+  if (hv_strchr(format, 's') == nullptr) {
+    // no symbols, the message size is known up front: build it directly in the input queue
+    HvMessage *m = reserveMessageForReceiver(receiverHash, delayMs, numElem);
+    success = (m != nullptr);
+    if (success) {
+      for (int i = 0; i < numElem; i++) {
+        switch (format[i]) {
+          case 'b': msg_setBang(m, i); break;
+          case 'f': msg_setFloat(m, i, (float) va_arg(ap, double)); break;
+          case 'h': msg_setHash(m, i, (int) va_arg(ap, int)); break;
+          default: break;
+        }
+      }
+      commitMessage();
     }
+  } else {
+    HvMessage *m = HV_MESSAGE_ON_STACK(numElem);
+    msg_init(m, numElem, blockStartTimestamp + (hv_uint32_t) (hv_max_d(0.0, delayMs)*getSampleRate()/1000.0));
+    for (int i = 0; i < numElem; i++) {
+      switch (format[i]) {
+        case 'b': msg_setBang(m, i); break;
+        case 'f': msg_setFloat(m, i, (float) va_arg(ap, double)); break;
+        case 'h': msg_setHash(m, i, (int) va_arg(ap, int)); break;
+        case 's': msg_setSymbol(m, i, (char *) va_arg(ap, char *)); break;
+        default: break;
+      }
+    }
+    success = sendMessageToReceiver(receiverHash, delayMs, m);
   }
   va_end(ap);
 
-  bool success = sendMessageToReceiver(receiverHash, delayMs, m);
   return success;
 }
 
@@ -119,7 +190,7 @@ bool HeavyContext::sendMessageToReceiver(hv_uint32_t receiverHash, double delayM
       (hv_uint32_t) (hv_max_d(0.0, delayMs)*(getSampleRate()/1000.0));
 
   ReceiverMessagePair *p = nullptr;
-  HV_SPINLOCK_ACQUIRE(inQueueLock);
+  HV_QUEUE_LOCK_ACQUIRE(inQueueLock);
   const hv_uint32_t numBytes = sizeof(ReceiverMessagePair) + msg_getSize(m) - sizeof(HvMessage);
   p = (ReceiverMessagePair *) hLp_getWriteBuffer(&inQueue, numBytes);
   if (p != nullptr) {
@@ -132,10 +203,41 @@ bool HeavyContext::sendMessageToReceiver(hv_uint32_t receiverHash, double delayM
         "::sendMessageToReceiver - The input message queue is full and cannot accept more messages until they "
         "have been processed. Try increasing the inQueueKb size in the new_with_options() constructor.");
   }
-  HV_SPINLOCK_RELEASE(inQueueLock);
+  HV_QUEUE_LOCK_RELEASE(inQueueLock);
   return (p != nullptr);
 }
 
+HvMessage *HV_HOT(HeavyContext::reserveMessageForReceiver)(hv_uint32_t receiverHash, double delayMs, int numElements) {
+  hv_assert(delayMs >= 0.0);
+  hv_assert(numElements > 0);
+  hv_assert((inQueueReservedBytes == 0) && "::reserveMessageForReceiver - the previous reservation was not committed.");
+
+  const hv_uint32_t timestamp = blockStartTimestamp +
+      (hv_uint32_t) (hv_max_d(0.0, delayMs)*(getSampleRate()/1000.0));
+
+  // without HV_LIGHTPIPE_SPSC the lock is held until commitMessage()
+  HV_QUEUE_LOCK_ACQUIRE(inQueueLock);
+  const hv_uint32_t numBytes = (hv_uint32_t) (sizeof(ReceiverMessagePair) + msg_getCoreSize(numElements) - sizeof(HvMessage));
+  ReceiverMessagePair *p = (ReceiverMessagePair *) hLp_getWriteBuffer(&inQueue, numBytes);
+  if (p == nullptr) {
+    hv_assert(false &&
+        "::reserveMessageForReceiver - The input message queue is full and cannot accept more messages until they "
+        "have been processed. Try increasing the inQueueKb size in the new_with_options() constructor.");
+    HV_QUEUE_LOCK_RELEASE(inQueueLock);
+    return nullptr;
+  }
+  p->receiverHash = receiverHash;
+  inQueueReservedBytes = numBytes;
+  return msg_init(&p->msg, numElements, timestamp);
+}
+
+void HV_HOT(HeavyContext::commitMessage)() {
+  hv_assert((inQueueReservedBytes > 0) && "::commitMessage - there is no reserved message to commit.");
+  hLp_produce(&inQueue, inQueueReservedBytes);
+  inQueueReservedBytes = 0;
+  HV_QUEUE_LOCK_RELEASE(inQueueLock);
+}
+
 bool HeavyContext::cancelMessage(HvMessage *m, void (*sendMessage)(HeavyContextInterface *, int, const HvMessage *)) {
   return mq_removeMessage(&mq, m, sendMessage);
 }
@@ -150,7 +252,8 @@ HvMessage *HeavyContext::scheduleMessageForObject(const HvMessage *m,
 float *HeavyContext::getBufferForTable(hv_uint32_t tableHash) {
   HvTable *t = getTableForHash(tableHash);
   if (t != nullptr) {
-    return hTable_getBuffer(t);
+    // the caller may write through it, so a flash-resident table is copied first
+    return hTable_getWritableBuffer(t);
   } else return nullptr;
 }
 
@@ -165,7 +268,8 @@ bool HeavyContext::setLengthForTable(hv_uint32_t tableHash, hv_uint32_t newSampl
   HvTable *t = getTableForHash(tableHash);
   if (t != nullptr) {
     hTable_resize(t, newSampleLength);
-    return true;
+    // the heap may not take the new buffer (or the copy of a flash-resident table)
+    return hTable_getSize(t) == ((newSampleLength + HV_N_SIMD_MASK) & ~HV_N_SIMD_MASK);
   } else return false;
 }
 
@@ -200,7 +304,7 @@ bool HeavyContext::getNextSentMessage(hv_uint32_t *destinationHash, HvMessage *o
       "::getNextSentMessage - this function won't do anything if the msg outQueue "
       "size is 0, or you've overriden the default sendhook.");
   if (sendHook == &defaultSendHook) {
-    HV_SPINLOCK_ACQUIRE(outQueueLock);
+    HV_QUEUE_LOCK_ACQUIRE(outQueueLock);
     if (hLp_hasData(&outQueue)) {
       hv_uint32_t numBytes = 0;
       p = reinterpret_cast<ReceiverMessagePair *>(hLp_getReadBuffer(&outQueue, &numBytes));
@@ -213,7 +317,7 @@ bool HeavyContext::getNextSentMessage(hv_uint32_t *destinationHash, HvMessage *o
       hv_memcpy(outMsg, &p->msg, numBytes);
       hLp_consume(&outQueue);
     }
-    HV_SPINLOCK_RELEASE(outQueueLock);
+    HV_QUEUE_LOCK_RELEASE(outQueueLock);
   }
   return (p != nullptr);
 }
@@ -19,6 +19,7 @@
 
 #include "HeavyContextInterface.hpp"
 #include "HvLightPipe.h"
+#include "HvParameterBlock.h"
 #include "HvMessageQueue.h"
 #include "HvMath.h"
 
@@ -54,8 +55,15 @@ class HeavyContext : public HeavyContextInterface {
   bool sendFloatToReceiver(hv_uint32_t receiverHash, float f) override;
   bool sendBangToReceiver(hv_uint32_t receiverHash) override;
   bool sendSymbolToReceiver(hv_uint32_t receiverHash, const char *symbol) override;
+  HvMessage *reserveMessageForReceiver(hv_uint32_t receiverHash, double delayMs, int numElements) override;
+  void commitMessage() override;
   bool cancelMessage(HvMessage *m, void (*sendMessage)(HeavyContextInterface *, int, const HvMessage *)) override;
 
+  // parameter block
+  bool setParameter(int index, float value) override;
+  bool setParameters(int index, int count, const float *values) override;
+  bool setParameterSmoothing(int index, float ms) override;
+
   // table manipulation
   float *getBufferForTable(hv_uint32_t tableHash) override;
   int getLengthForTable(hv_uint32_t tableHash) override;
@@ -90,6 +98,12 @@ class HeavyContext : public HeavyContextInterface {
 
   friend void defaultSendHook(HeavyContextInterface *, const char *, hv_uint32_t, const HvMessage *);
 
+  // sizes the parameter block from getParameterInfo(), called at the end of the subclass constructor
+  hv_size_t initParameters();
+
+  // applies the parameter block at the start of process(), before the inQueue is drained
+  void processParameters(int n);
+
   // object state
   double sampleRate;
   hv_uint32_t blockStartTimestamp;
@@ -102,6 +116,8 @@ class HeavyContext : public HeavyContextInterface {
   HvLightPipe outQueue;
   hv_atomic_bool inQueueLock;
   hv_atomic_bool outQueueLock;
+  hv_uint32_t inQueueReservedBytes; // size of the open reserveMessageForReceiver() record, 0 if none
+  HvParameterBlock params;
 };
 
 #endif // _HEAVY_CONTEXT_H_
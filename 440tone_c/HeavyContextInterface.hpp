@@ -190,6 +190,26 @@ class HeavyContextInterface {
    */
   virtual bool sendSymbolToReceiver(hv_uint32_t receiverHash, const char *symbol)  = 0;
 
+  /**
+   * Reserves a message of numElements elements directly in the input message queue, so
+   * that it can be built in place without a copy. The message is initialised with the
+   * timestamp for delayMs; set each element with msg_setFloat(), msg_setBang() or
+   * msg_setHash() and then publish it with commitMessage(). Symbols are not supported,
+   * use sendMessageToReceiverV() for those.
+   * Only one reservation may be open at a time. Unless HV_LIGHTPIPE_SPSC is set, the
+   * input message queue lock is held from this call until commitMessage().
+   *
+   * @return  The message to fill in, or NULL (and no commitMessage()) if it could not fit
+   *          onto the message queue to be processed this block.
+   */
+  virtual HvMessage *reserveMessageForReceiver(hv_uint32_t receiverHash, double delayMs, int numElements) = 0;
+
+  /**
+   * Publishes the message returned by the last successful reserveMessageForReceiver()
+   * to the audio thread.
+   */
+  virtual void commitMessage() = 0;
+
   /**
    * Cancels a previously scheduled message.
    *
@@ -208,7 +228,36 @@ class HeavyContextInterface {
    */
   virtual int getParameterInfo(int index, HvParameterInfo *info) = 0;
 
-  /** Returns a pointer to the raw buffer backing this table. DO NOT free it. */
+  /**
+   * Sets a parameter, addressed by its getParameterInfo() index, without queuing a message.
+   * Only the latest value per parameter is applied, once at the start of the next block, as
+   * a float to the parameter's receiver. This function is lock-free and thread-safe.
+   *
+   * @return  False if the index is not a parameter.
+   */
+  virtual bool setParameter(int index, float value) = 0;
+
+  /**
+   * Sets count consecutive parameters starting at index. All of them are applied in the
+   * same block.
+   *
+   * @return  False if the range is not inside the parameter list.
+   */
+  virtual bool setParameters(int index, int count, const float *values) = 0;
+
+  /**
+   * Ramps the parameter linearly to each new value over ms milliseconds (0 = jump, the
+   * default). While ramping, the receiver gets the value reached at the end of every block.
+   *
+   * @return  False if the index is not a parameter.
+   */
+  virtual bool setParameterSmoothing(int index, float ms) = 0;
+
+  /**
+   * Returns a pointer to the raw buffer backing this table. DO NOT free it.
+   * A table initialised from const (flash) data is copied to the heap first.
+   * nullptr if that copy cannot be allocated (e.g. a sealed arena).
+   */
   virtual float *getBufferForTable(hv_uint32_t tableHash) = 0;
 
   /** Returns the length of this table in samples. */
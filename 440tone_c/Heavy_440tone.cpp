@@ -30,6 +30,7 @@
  * 
  */
 
+#include "Heavy_440tone.h"
 #include "Heavy_440tone.hpp"
 
 #include <new>
@@ -69,6 +70,18 @@ extern "C" {
     // free memory
     hv_free(instance);
   }
+
+  HV_EXPORT int HV_HOT(hv_440tone_process_block)(HeavyContextInterface *instance, float *outputBuffers) {
+    return Context(instance)->processBlock<HV_440TONE_BLOCK_SIZE>(outputBuffers);
+  }
+
+  HV_EXPORT int HV_HOT(hv_440tone_process_block_interleaved)(HeavyContextInterface *instance, float *outputBuffers) {
+    return Context(instance)->processBlockInterleaved<HV_440TONE_BLOCK_SIZE>(outputBuffers);
+  }
+
+  HV_EXPORT void hv_440tone_set_output_mask(HeavyContextInterface *instance, unsigned int mask) {
+    Context(instance)->setOutputMask(mask);
+  }
 } // extern "C"
 
 
@@ -82,9 +95,9 @@ extern "C" {
  */
 
 Heavy_440tone::Heavy_440tone(double sampleRate, int poolKb, int inQueueKb, int outQueueKb)
-    : HeavyContext(sampleRate, poolKb, inQueueKb, outQueueKb) {
+    : HeavyContext(sampleRate, poolKb, inQueueKb, outQueueKb), outputMask(HV_440TONE_OUTPUT_MASK) {
   numBytes += sPhasor_k_init(&sPhasor_EE2ctfwf, 440.0f, sampleRate);
-  
+  numBytes += initParameters();
 }
 
 Heavy_440tone::~Heavy_440tone() {
@@ -95,7 +108,7 @@ HvTable *Heavy_440tone::getTableForHash(hv_uint32_t tableHash) {
   return nullptr;
 }
 
-void Heavy_440tone::scheduleMessageForReceiver(hv_uint32_t receiverHash, HvMessage *m) {
+void HV_HOT(Heavy_440tone::scheduleMessageForReceiver)(hv_uint32_t receiverHash, HvMessage *m) {
   switch (receiverHash) {
     default: return;
   }
@@ -141,7 +154,58 @@ int Heavy_440tone::getParameterInfo(int index, HvParameterInfo *info) {
  * Context Process Implementation
  */
 
-int Heavy_440tone::process(float **inputBuffers, float **outputBuffers, int n) {
+// interleaves the two planar channels of bOut (n4 frames each) into outputBuffers
+static HV_FORCE_INLINE void interleave(const float *const bOut, float *const outputBuffers, const int n4) {
+  #if HV_SIMD_AVX
+  for (int i = 0, j = 0; j < n4; j += 8, i += 16) {
+    __m256 x = _mm256_load_ps(bOut+j);    // LLLLLLLL
+    __m256 y = _mm256_load_ps(bOut+n4+j); // RRRRRRRR
+    __m256 a = _mm256_unpacklo_ps(x, y);  // LRLRLRLR
+    __m256 b = _mm256_unpackhi_ps(x, y);  // LRLRLRLR
+    _mm256_store_ps(outputBuffers+i, a);
+    _mm256_store_ps(outputBuffers+8+i, b);
+  }
+  #elif HV_SIMD_SSE
+  for (int i = 0, j = 0; j < n4; j += 4, i += 8) {
+    __m128 x = _mm_load_ps(bOut+j);    // LLLL
+    __m128 y = _mm_load_ps(bOut+n4+j); // RRRR
+    __m128 a = _mm_unpacklo_ps(x, y);  // LRLR
+    __m128 b = _mm_unpackhi_ps(x, y);  // LRLR
+    _mm_store_ps(outputBuffers+i, a);
+    _mm_store_ps(outputBuffers+4+i, b);
+  }
+  #elif HV_SIMD_NEON
+  // https://community.arm.com/groups/processors/blog/2012/03/13/coding-for-neon--part-5-rearranging-vectors
+  for (int i = 0, j = 0; j < n4; j += 4, i += 8) {
+    float32x4_t x = vld1q_f32(bOut+j);
+    float32x4_t y = vld1q_f32(bOut+n4+j);
+    float32x4x2_t z = {x, y};
+    vst2q_f32(outputBuffers+i, z); // interleave and store
+  }
+  #else // HV_SIMD_NONE
+  for (int i = 0; i < 2; ++i) {
+    for (int j = 0; j < n4; ++j) {
+      outputBuffers[i+2*j] = bOut[i*n4+j];
+    }
+  }
+  #endif
+}
+
+// zeroes the planar scratch of the channels processFrames() will not write, so that an
+// interleaved output carries silence in their slots instead of uninitialised stack
+static HV_FORCE_INLINE void clearDisabledOutputs(float *const bOut, const int n4, const hv_uint32_t mask) {
+  for (int i = 0; i < 2; ++i) {
+    if (!(mask & (1u << i))) hv_memclear(bOut+i*n4, n4*sizeof(float));
+  }
+}
+
+HV_FORCE_INLINE int Heavy_440tone::processFrames(float *const out0, float *const out1, const int n4) {
+#if HV_ARENA && HV_ARENA_SEAL
+  hv_arena_seal(); // everything is allocated by now, any hv_malloc() from here on asserts
+#endif
+
+  processParameters(n4);
+
   while (hLp_hasData(&inQueue)) {
     hv_uint32_t numBytes = 0;
     ReceiverMessagePair *p = reinterpret_cast<ReceiverMessagePair *>(hLp_getReadBuffer(&inQueue, &numBytes));
@@ -150,11 +214,15 @@ int Heavy_440tone::process(float **inputBuffers, float **outputBuffers, int n) {
     hLp_consume(&inQueue);
   }
 
-  sendBangToReceiver(0xDD21C0EB); // send to __hv_bang~ on next cycle
-  const int n4 = n & ~HV_N_SIMD_MASK; // ensure that the block size is a multiple of HV_N_SIMD
-
+#if HV_440TONE_NUM_BANG_RECEIVERS > 0 && !HV_440TONE_DIRECT_BANG
+  sendBangToReceiver(HV_HASH("__hv_bang~")); // send to __hv_bang~ on next cycle
+#endif
   // temporary signal vars
+#if HV_OSC_WAVETABLE
+  hv_bufferf_t Bf1; // the table lookup needs none of the polynomial temporaries
+#else
   hv_bufferf_t Bf0, Bf1, Bf2, Bf3, Bf4;
+#endif
 
   // input and output vars
   hv_bufferf_t O0, O1;
@@ -162,6 +230,11 @@ int Heavy_440tone::process(float **inputBuffers, float **outputBuffers, int n) {
   // declare and init the zero buffer
   hv_bufferf_t ZERO; __hv_zero_f(VOf(ZERO));
 
+  // disabled outputs are neither accumulated nor stored. A channel missing from the
+  // compile-time mask is a constant false here, so its code is not generated at all.
+  const bool out0Enabled = (HV_440TONE_OUTPUT_MASK & 0x1) && (outputMask & 0x1);
+  const bool out1Enabled = (HV_440TONE_OUTPUT_MASK & 0x2) && (outputMask & 0x2);
+
   hv_uint32_t nextBlock = blockStartTimestamp;
   for (int n = 0; n < n4; n += HV_N_SIMD) {
 
@@ -176,10 +249,13 @@ int Heavy_440tone::process(float **inputBuffers, float **outputBuffers, int n) {
     
 
     // zero output buffers
-    __hv_zero_f(VOf(O0));
-    __hv_zero_f(VOf(O1));
+    if (out0Enabled) __hv_zero_f(VOf(O0));
+    if (out1Enabled) __hv_zero_f(VOf(O1));
 
     // process all signal functions
+#if HV_OSC_WAVETABLE
+    __hv_phasor_k_cos_f(&sPhasor_EE2ctfwf, VOf(Bf1));
+#else
     __hv_phasor_k_f(&sPhasor_EE2ctfwf, VOf(Bf0));
     __hv_var_k_f(VOf(Bf1), 0.5f, 0.5f, 0.5f, 0.5f, 0.5f, 0.5f, 0.5f, 0.5f);
     __hv_sub_f(VIf(Bf0), VIf(Bf1), VOf(Bf1));
@@ -195,21 +271,35 @@ int Heavy_440tone::process(float **inputBuffers, float **outputBuffers, int n) {
     __hv_var_k_f(VOf(Bf4), -0.166666666666667f, -0.166666666666667f, -0.166666666666667f, -0.166666666666667f, -0.166666666666667f, -0.166666666666667f, -0.166666666666667f, -0.166666666666667f);
     __hv_fma_f(VIf(Bf2), VIf(Bf4), VIf(Bf1), VOf(Bf1));
     __hv_fma_f(VIf(Bf0), VIf(Bf3), VIf(Bf1), VOf(Bf1));
-    __hv_add_f(VIf(Bf1), VIf(O0), VOf(O0));
-    __hv_add_f(VIf(Bf1), VIf(O1), VOf(O1));
+#endif
+    if (out0Enabled) __hv_add_f(VIf(Bf1), VIf(O0), VOf(O0));
+    if (out1Enabled) __hv_add_f(VIf(Bf1), VIf(O1), VOf(O1));
 
     // save output vars to output buffer
-    __hv_store_f(outputBuffers[0]+n, VIf(O0));
-    __hv_store_f(outputBuffers[1]+n, VIf(O1));
+    if (out0Enabled) __hv_store_f(out0+n, VIf(O0));
+    if (out1Enabled) __hv_store_f(out1+n, VIf(O1));
   }
 
+#if HV_440TONE_NUM_BANG_RECEIVERS > 0 && HV_440TONE_DIRECT_BANG
+  // __hv_bang~ for the next cycle, scheduled directly with the timestamp and ordering the
+  // inQueue round-trip would give it (ahead of anything sent during this block)
+  HvMessage *const bang = HV_MESSAGE_ON_STACK(1);
+  msg_initWithBang(bang, blockStartTimestamp);
+  scheduleMessageForReceiver(HV_HASH("__hv_bang~"), bang);
+#endif
+
   blockStartTimestamp = nextBlock;
 
   return n4; // return the number of frames processed
 
 }
 
-int Heavy_440tone::processInline(float *inputBuffers, float *outputBuffers, int n4) {
+int HV_HOT(Heavy_440tone::process)(float **inputBuffers, float **outputBuffers, int n) {
+  // ensure that the block size is a multiple of HV_N_SIMD
+  return processFrames(outputBuffers[0], outputBuffers[1], n & ~HV_N_SIMD_MASK);
+}
+
+int HV_HOT(Heavy_440tone::processInline)(float *inputBuffers, float *outputBuffers, int n4) {
   hv_assert(!(n4 & HV_N_SIMD_MASK)); // ensure that n4 is a multiple of HV_N_SIMD
 
   // define the heavy input buffer for 0 channel(s)
@@ -224,7 +314,7 @@ int Heavy_440tone::processInline(float *inputBuffers, float *outputBuffers, int
   return n;
 }
 
-int Heavy_440tone::processInlineInterleaved(float *inputBuffers, float *outputBuffers, int n4) {
+int HV_HOT(Heavy_440tone::processInlineInterleaved)(float *inputBuffers, float *outputBuffers, int n4) {
   hv_assert(n4 & ~HV_N_SIMD_MASK); // ensure that n4 is a multiple of HV_N_SIMD
 
   // define the heavy input buffer for 0 channel(s), uninterleave
@@ -232,43 +322,36 @@ int Heavy_440tone::processInlineInterleaved(float *inputBuffers, float *outputBu
 
   // define the heavy output buffer for 2 channel(s)
   float *const bOut = reinterpret_cast<float *>(hv_alloca(2*n4*sizeof(float)));
+  clearDisabledOutputs(bOut, n4, getOutputMask());
 
   int n = processInline(bIn, bOut, n4);
 
   // interleave the heavy output into the output buffer
-  #if HV_SIMD_AVX
-  for (int i = 0, j = 0; j < n4; j += 8, i += 16) {
-    __m256 x = _mm256_load_ps(bOut+j);    // LLLLLLLL
-    __m256 y = _mm256_load_ps(bOut+n4+j); // RRRRRRRR
-    __m256 a = _mm256_unpacklo_ps(x, y);  // LRLRLRLR
-    __m256 b = _mm256_unpackhi_ps(x, y);  // LRLRLRLR
-    _mm256_store_ps(outputBuffers+i, a);
-    _mm256_store_ps(outputBuffers+8+i, b);
-  }
-  #elif HV_SIMD_SSE
-  for (int i = 0, j = 0; j < n4; j += 4, i += 8) {
-    __m128 x = _mm_load_ps(bOut+j);    // LLLL
-    __m128 y = _mm_load_ps(bOut+n4+j); // RRRR
-    __m128 a = _mm_unpacklo_ps(x, y);  // LRLR
-    __m128 b = _mm_unpackhi_ps(x, y);  // LRLR
-    _mm_store_ps(outputBuffers+i, a);
-    _mm_store_ps(outputBuffers+4+i, b);
-  }
-  #elif HV_SIMD_NEON
-  // https://community.arm.com/groups/processors/blog/2012/03/13/coding-for-neon--part-5-rearranging-vectors
-  for (int i = 0, j = 0; j < n4; j += 4, i += 8) {
-    float32x4_t x = vld1q_f32(bOut+j);
-    float32x4_t y = vld1q_f32(bOut+n4+j);
-    float32x4x2_t z = {x, y};
-    vst2q_f32(outputBuffers+i, z); // interleave and store
-  }
-  #else // HV_SIMD_NONE
-  for (int i = 0; i < 2; ++i) {
-    for (int j = 0; j < n4; ++j) {
-      outputBuffers[i+2*j] = bOut[i*n4+j];
-    }
-  }
-  #endif
+  interleave(bOut, outputBuffers, n4);
 
   return n;
 }
+
+template <int N>
+int Heavy_440tone::processBlock(float *outputBuffers) {
+  static_assert((N > 0) && !(N & HV_N_SIMD_MASK), "processBlock<N>: N must be a positive multiple of HV_N_SIMD");
+  return processFrames(outputBuffers, outputBuffers+N, N);
+}
+
+template <int N>
+int Heavy_440tone::processBlockInterleaved(float *outputBuffers) {
+  static_assert((N > 0) && !(N & HV_N_SIMD_MASK), "processBlockInterleaved<N>: N must be a positive multiple of HV_N_SIMD");
+
+  // planar scratch of a known size on the stack, SIMD-aligned by its type, instead of hv_alloca()
+  hv_bufferf_t scratch[2*N/HV_N_SIMD];
+  float *const bOut = reinterpret_cast<float *>(scratch);
+  clearDisabledOutputs(bOut, N, getOutputMask());
+
+  const int n = processFrames(bOut, bOut+N, N);
+  interleave(bOut, outputBuffers, N);
+  return n;
+}
+
+// the block sizes that are compiled, other sizes go through process()
+template int Heavy_440tone::processBlock<HV_440TONE_BLOCK_SIZE>(float *);
+template int Heavy_440tone::processBlockInterleaved<HV_440TONE_BLOCK_SIZE>(float *);
@@ -35,6 +35,16 @@
 
 #include "HvHeavy.h"
 
+// block size of hv_440tone_process_block(), the frame count of every call
+#ifndef HV_440TONE_BLOCK_SIZE
+#define HV_440TONE_BLOCK_SIZE 64
+#endif
+
+// outputs that are computed at all, bit i = output channel i (ANDed with the runtime mask)
+#ifndef HV_440TONE_OUTPUT_MASK
+#define HV_440TONE_OUTPUT_MASK 0x3
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -70,6 +80,30 @@ HeavyContextInterface *hv_440tone_new_with_options(double sampleRate, int poolKb
  */
 void hv_440tone_free(HeavyContextInterface *instance);
 
+/**
+ * Processes exactly HV_440TONE_BLOCK_SIZE frames, like hv_processInline() but compiled for
+ * that block size: the frame loop has a constant trip count and no scratch is allocated.
+ * @param outputBuffers  2 * HV_440TONE_BLOCK_SIZE floats, one channel after the other,
+ *   aligned for the SIMD stores.
+ * @return  The number of frames processed (HV_440TONE_BLOCK_SIZE).
+ */
+int hv_440tone_process_block(HeavyContextInterface *instance, float *outputBuffers);
+
+/**
+ * Same as hv_440tone_process_block() with interleaved output, like
+ * hv_processInlineInterleaved() but with a fixed-size stack scratch instead of hv_alloca().
+ */
+int hv_440tone_process_block_interleaved(HeavyContextInterface *instance, float *outputBuffers);
+
+/**
+ * Selects the output channels that are computed, bit i = output channel i. The buffers of
+ * disabled channels are not written by the planar process calls (their contents stay as
+ * they were), the interleaved calls write 0 into their slots.
+ * Channels missing from HV_440TONE_OUTPUT_MASK are never computed, whatever the mask.
+ * @param mask  Default 0x3, both channels.
+ */
+void hv_440tone_set_output_mask(HeavyContextInterface *instance, unsigned int mask);
+
 
 #ifdef __cplusplus
 } // extern "C"
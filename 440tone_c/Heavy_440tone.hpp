@@ -36,9 +36,20 @@
 // object includes
 #include "HeavyContext.hpp"
 #include "HvSignalPhasor.h"
+#include "HvSignalWavetable.hpp"
 #include "HvSignalVar.h"
 #include "HvMath.h"
 
+// number of __hv_bang~ receivers (cases in scheduleMessageForReceiver()), 0 = the per-block bang is not sent
+#ifndef HV_440TONE_NUM_BANG_RECEIVERS
+#define HV_440TONE_NUM_BANG_RECEIVERS 0
+#endif
+
+// 1 = deliver __hv_bang~ with a direct call instead of a copy through the spinlocked inQueue
+#ifndef HV_440TONE_DIRECT_BANG
+#define HV_440TONE_DIRECT_BANG 1
+#endif
+
 class Heavy_440tone : public HeavyContext {
 
  public:
@@ -55,7 +66,19 @@ class Heavy_440tone : public HeavyContext {
 
   int getParameterInfo(int index, HvParameterInfo *info) override;
 
+  // fixed block size: N frames per channel with a compile-time trip count and no hv_alloca().
+  // Only N = HV_440TONE_BLOCK_SIZE is instantiated (Heavy_440tone.cpp). Inlined into the
+  // hv_440tone_process_block*() entry points, which is where HV_HOT_IN_RAM can place them.
+  template <int N> HV_FORCE_INLINE int processBlock(float *outputBuffers);
+  template <int N> HV_FORCE_INLINE int processBlockInterleaved(float *outputBuffers);
+
+  // output channels that are computed and stored, bit i = channel i (see hv_440tone_set_output_mask())
+  void setOutputMask(hv_uint32_t mask) { outputMask = mask; }
+  hv_uint32_t getOutputMask() const { return outputMask & HV_440TONE_OUTPUT_MASK; }
+
  private:
+  HV_FORCE_INLINE int processFrames(float *out0, float *out1, int n4);
+
   HvTable *getTableForHash(hv_uint32_t tableHash) override;
   void scheduleMessageForReceiver(hv_uint32_t receiverHash, HvMessage *m) override;
 
@@ -74,6 +97,8 @@ class Heavy_440tone : public HeavyContext {
 
   // objects
   SignalPhasor sPhasor_EE2ctfwf;
+
+  hv_uint32_t outputMask;
 };
 
 #endif // _HEAVY_CONTEXT_440TONE_HPP_
@@ -0,0 +1,335 @@
+/**
+ * @file Heavy_440toneBank.cpp
+ * @brief 440tone voice bank context: one phasor/cosine chain per voice, voices in SIMD lanes
+ * @author Ale Moglia
+ * @date 2026
+ *
+ * process() runs the signal chain of Heavy_440tone::process() on SignalPhasorBank
+ * groups, so each operation handles HV_N_SIMD voices at one sample instead of HV_N_SIMD
+ * samples of one voice. For every HV_N_SIMD-sample frame it accumulates the gain-weighted
+ * voices of each sample in its own vector. __hv_phasorbank_sum_f() then turns those
+ * vectors into the output vector, so the mix costs one reduction per frame, not per voice.
+ */
+
+#include "Heavy_440toneBank.h"
+#include "Heavy_440toneBank.hpp"
+
+#include <new>
+
+#define Context(_c) static_cast<Heavy_440toneBank *>(_c)
+
+
+/*
+ * C Functions
+ */
+
+extern "C" {
+  HV_EXPORT HeavyContextInterface *hv_440tone_bank_new(double sampleRate, int numVoices) {
+    // allocate aligned memory
+    void *ptr = hv_malloc(sizeof(Heavy_440toneBank));
+    // ensure non-null
+    if (!ptr) return nullptr;
+    // call constructor
+    new(ptr) Heavy_440toneBank(sampleRate, numVoices);
+    return Context(ptr);
+  }
+
+  HV_EXPORT HeavyContextInterface *hv_440tone_bank_new_with_options(double sampleRate, int numVoices,
+      int poolKb, int inQueueKb, int outQueueKb) {
+    // allocate aligned memory
+    void *ptr = hv_malloc(sizeof(Heavy_440toneBank));
+    // ensure non-null
+    if (!ptr) return nullptr;
+    // call constructor
+    new(ptr) Heavy_440toneBank(sampleRate, numVoices, poolKb, inQueueKb, outQueueKb);
+    return Context(ptr);
+  }
+
+  HV_EXPORT void hv_440tone_bank_free(HeavyContextInterface *instance) {
+    // call destructor
+    Context(instance)->~Heavy_440toneBank();
+    // free memory
+    hv_free(instance);
+  }
+} // extern "C"
+
+
+/*
+ * Class Functions
+ */
+
+Heavy_440toneBank::Heavy_440toneBank(double sampleRate, int numVoices, int poolKb, int inQueueKb, int outQueueKb)
+    : HeavyContext(sampleRate, poolKb, inQueueKb, outQueueKb) {
+  hv_assert(numVoices > 0);
+  this->numVoices = numVoices;
+  numGroups = (numVoices + HV_N_SIMD_MASK) / HV_N_SIMD;
+
+  sPhasorBank = (SignalPhasorBank *) hv_malloc(numGroups * sizeof(SignalPhasorBank));
+  gain = (hv_bufferf_t *) hv_malloc(numGroups * sizeof(hv_bufferf_t));
+  hv_assert(sPhasorBank != nullptr && gain != nullptr);
+  numBytes += numGroups * (sizeof(SignalPhasorBank) + sizeof(hv_bufferf_t));
+
+  // every voice starts as the single-voice patch: 440 Hz, full level; padding lanes are silent
+  for (int g = 0; g < numGroups; ++g) {
+    sPhasorBank_init(&sPhasorBank[g]);
+    __hv_zero_f(VOf(gain[g]));
+  }
+  for (int v = 0; v < numVoices; ++v) {
+    sPhasorBank_setFrequency(&sPhasorBank[v / HV_N_SIMD], v % HV_N_SIMD, 440.0f, sampleRate);
+    ((float *) &gain[v / HV_N_SIMD])[v % HV_N_SIMD] = 1.0f;
+  }
+  numBytes += initParameters();
+}
+
+Heavy_440toneBank::~Heavy_440toneBank() {
+  hv_free(gain);
+  hv_free(sPhasorBank);
+}
+
+HvTable *Heavy_440toneBank::getTableForHash(hv_uint32_t tableHash) {
+  return nullptr;
+}
+
+void Heavy_440toneBank::scheduleMessageForReceiver(hv_uint32_t receiverHash, HvMessage *m) {
+  switch (receiverHash) {
+    case HV_HASH("voice_freq"): {
+      mq_addMessageByTimestamp(&mq, m, 0, &cReceive_voiceFreq_sendMessage);
+      break;
+    }
+    case HV_HASH("voice_gain"): {
+      mq_addMessageByTimestamp(&mq, m, 0, &cReceive_voiceGain_sendMessage);
+      break;
+    }
+    default: return;
+  }
+}
+
+int Heavy_440toneBank::getParameterInfo(int index, HvParameterInfo *info) {
+  if (info != nullptr) {
+    switch (index) {
+      case 0: {
+        info->name = "bank_gain"; // output level after the voice mix, ramped per sample
+        info->hash = HV_HASH("bank_gain");
+        info->type = HvParameterType::HV_PARAM_TYPE_PARAMETER_IN;
+        info->minVal = 0.0f;
+        info->maxVal = 1.0f;
+        info->defaultVal = 1.0f;
+        break;
+      }
+      default: {
+        info->name = "invalid parameter index";
+        info->hash = 0;
+        info->type = HvParameterType::HV_PARAM_TYPE_PARAMETER_IN;
+        info->minVal = 0.0f;
+        info->maxVal = 0.0f;
+        info->defaultVal = 0.0f;
+        break;
+      }
+    }
+  }
+  return 1;
+}
+
+
+
+/*
+ * Send Function Implementations
+ */
+
+// <voice> <Hz> sets one voice, a single float sets every voice
+void Heavy_440toneBank::cReceive_voiceFreq_sendMessage(HeavyContextInterface *_c, int letIn, const HvMessage *m) {
+  Heavy_440toneBank *const c = Context(_c);
+  if (msg_isFloat(m, 0) && msg_isFloat(m, 1)) {
+    const int v = (int) msg_getFloat(m, 0);
+    if (v >= 0 && v < c->numVoices) {
+      sPhasorBank_setFrequency(&c->sPhasorBank[v / HV_N_SIMD], v % HV_N_SIMD, msg_getFloat(m, 1), c->sampleRate);
+    }
+  } else if (msg_isFloat(m, 0)) {
+    for (int v = 0; v < c->numVoices; ++v) {
+      sPhasorBank_setFrequency(&c->sPhasorBank[v / HV_N_SIMD], v % HV_N_SIMD, msg_getFloat(m, 0), c->sampleRate);
+    }
+  }
+}
+
+// <voice> <gain> sets one voice, a single float sets every voice
+void Heavy_440toneBank::cReceive_voiceGain_sendMessage(HeavyContextInterface *_c, int letIn, const HvMessage *m) {
+  Heavy_440toneBank *const c = Context(_c);
+  if (msg_isFloat(m, 0) && msg_isFloat(m, 1)) {
+    const int v = (int) msg_getFloat(m, 0);
+    if (v >= 0 && v < c->numVoices) {
+      ((float *) &c->gain[v / HV_N_SIMD])[v % HV_N_SIMD] = msg_getFloat(m, 1);
+    }
+  } else if (msg_isFloat(m, 0)) {
+    for (int v = 0; v < c->numVoices; ++v) {
+      ((float *) &c->gain[v / HV_N_SIMD])[v % HV_N_SIMD] = msg_getFloat(m, 0);
+    }
+  }
+}
+
+
+/*
+ * Context Process Implementation
+ */
+
+int Heavy_440toneBank::process(float **inputBuffers, float **outputBuffers, int n) {
+#if HV_ARENA && HV_ARENA_SEAL
+  hv_arena_seal(); // everything is allocated by now, any hv_malloc() from here on asserts
+#endif
+
+  processParameters(n & ~HV_N_SIMD_MASK);
+
+  while (hLp_hasData(&inQueue)) {
+    hv_uint32_t numBytes = 0;
+    ReceiverMessagePair *p = reinterpret_cast<ReceiverMessagePair *>(hLp_getReadBuffer(&inQueue, &numBytes));
+    hv_assert(numBytes >= sizeof(ReceiverMessagePair));
+    scheduleMessageForReceiver(p->receiverHash, &p->msg);
+    hLp_consume(&inQueue);
+  }
+
+  const int n4 = n & ~HV_N_SIMD_MASK; // ensure that the block size is a multiple of HV_N_SIMD
+
+  // temporary signal vars, one voice per lane
+#if HV_OSC_WAVETABLE
+  hv_bufferf_t Bf1; // the table lookup needs none of the polynomial temporaries
+#else
+  hv_bufferf_t Bf0, Bf1, Bf2, Bf3, Bf4;
+#endif
+
+  // per-sample voice mix of the current frame, and the output vector it reduces to
+  hv_bufferf_t mix[HV_N_SIMD];
+  hv_bufferf_t O0;
+
+  // bank_gain, linear from the previous block's value to this block's; skipped at unity
+  const float gainStart = hPb_getBlockStart(&params, 0);
+  const float gainStep = (n4 > 0) ? (hPb_getValue(&params, 0) - gainStart) / (float) n4 : 0.0f;
+  const bool applyGain = (gainStart != 1.0f) || (gainStep != 0.0f);
+
+  hv_uint32_t nextBlock = blockStartTimestamp;
+  for (int n = 0; n < n4; n += HV_N_SIMD) {
+
+    // process all of the messages for this block
+    nextBlock += HV_N_SIMD;
+    while (mq_hasMessageBefore(&mq, nextBlock)) {
+      MessageNode *const node = mq_peek(&mq);
+      node->sendMessage(this, node->let, node->m);
+      mq_pop(&mq);
+    }
+
+    for (int k = 0; k < HV_N_SIMD; ++k) {
+      __hv_zero_f(VOf(mix[k]));
+    }
+
+    // process all signal functions, group by group. The group state is copied to locals
+    // because SIMD vector types may alias anything, so stores to mix[] would otherwise
+    // force a reload of the phase after every sample.
+    for (int g = 0; g < numGroups; ++g) {
+      SignalPhasorBank bank = sPhasorBank[g];
+      SignalPhasorBank *const o = &bank;
+      const hv_bufferf_t g0 = gain[g];
+      for (int k = 0; k < HV_N_SIMD; ++k) {
+#if HV_OSC_WAVETABLE
+        __hv_phasorbank_cos_f(o, VOf(Bf1));
+#else
+        __hv_phasorbank_f(o, VOf(Bf0));
+        __hv_var_k_f(VOf(Bf1), 0.5f, 0.5f, 0.5f, 0.5f, 0.5f, 0.5f, 0.5f, 0.5f);
+        __hv_sub_f(VIf(Bf0), VIf(Bf1), VOf(Bf1));
+        __hv_abs_f(VIf(Bf1), VOf(Bf1));
+        __hv_var_k_f(VOf(Bf0), 0.25f, 0.25f, 0.25f, 0.25f, 0.25f, 0.25f, 0.25f, 0.25f);
+        __hv_sub_f(VIf(Bf1), VIf(Bf0), VOf(Bf0));
+        __hv_var_k_f(VOf(Bf1), 6.283185307179586f, 6.283185307179586f, 6.283185307179586f, 6.283185307179586f, 6.283185307179586f, 6.283185307179586f, 6.283185307179586f, 6.283185307179586f);
+        __hv_mul_f(VIf(Bf0), VIf(Bf1), VOf(Bf1));
+        __hv_mul_f(VIf(Bf1), VIf(Bf1), VOf(Bf0));
+        __hv_mul_f(VIf(Bf1), VIf(Bf0), VOf(Bf2));
+        __hv_mul_f(VIf(Bf2), VIf(Bf0), VOf(Bf0));
+        __hv_var_k_f(VOf(Bf3), 0.007833333333333f, 0.007833333333333f, 0.007833333333333f, 0.007833333333333f, 0.007833333333333f, 0.007833333333333f, 0.007833333333333f, 0.007833333333333f);
+        __hv_var_k_f(VOf(Bf4), -0.166666666666667f, -0.166666666666667f, -0.166666666666667f, -0.166666666666667f, -0.166666666666667f, -0.166666666666667f, -0.166666666666667f, -0.166666666666667f);
+        __hv_fma_f(VIf(Bf2), VIf(Bf4), VIf(Bf1), VOf(Bf1));
+        __hv_fma_f(VIf(Bf0), VIf(Bf3), VIf(Bf1), VOf(Bf1));
+#endif
+        __hv_fma_f(VIf(Bf1), VIf(g0), VIf(mix[k]), VOf(mix[k]));
+      }
+      sPhasorBank[g] = bank;
+    }
+
+    // lane k of O0 = all voices at sample n+k, sent to both outputs like the single-voice patch
+    __hv_phasorbank_sum_f(mix, VOf(O0));
+    if (applyGain) {
+      hv_bufferf_t G;
+      for (int k = 0; k < HV_N_SIMD; ++k) {
+        ((float *) &G)[k] = gainStart + gainStep * (float) (n + k + 1);
+      }
+      __hv_mul_f(VIf(O0), VIf(G), VOf(O0));
+    }
+
+    // save output vars to output buffer
+    __hv_store_f(outputBuffers[0]+n, VIf(O0));
+    __hv_store_f(outputBuffers[1]+n, VIf(O0));
+  }
+
+  blockStartTimestamp = nextBlock;
+
+  return n4; // return the number of frames processed
+}
+
+int Heavy_440toneBank::processInline(float *inputBuffers, float *outputBuffers, int n4) {
+  hv_assert(!(n4 & HV_N_SIMD_MASK)); // ensure that n4 is a multiple of HV_N_SIMD
+
+  // define the heavy input buffer for 0 channel(s)
+  float **const bIn = NULL;
+
+  // define the heavy output buffer for 2 channel(s)
+  float **const bOut = reinterpret_cast<float **>(hv_alloca(2*sizeof(float *)));
+  bOut[0] = outputBuffers+(0*n4);
+  bOut[1] = outputBuffers+(1*n4);
+
+  int n = process(bIn, bOut, n4);
+  return n;
+}
+
+int Heavy_440toneBank::processInlineInterleaved(float *inputBuffers, float *outputBuffers, int n4) {
+  hv_assert(!(n4 & HV_N_SIMD_MASK)); // ensure that n4 is a multiple of HV_N_SIMD
+
+  // define the heavy input buffer for 0 channel(s), uninterleave
+  float *const bIn = NULL;
+
+  // define the heavy output buffer for 2 channel(s)
+  float *const bOut = reinterpret_cast<float *>(hv_alloca(2*n4*sizeof(float)));
+
+  int n = processInline(bIn, bOut, n4);
+
+  // interleave the heavy output into the output buffer
+  #if HV_SIMD_AVX
+  for (int i = 0, j = 0; j < n4; j += 8, i += 16) {
+    __m256 x = _mm256_load_ps(bOut+j);    // LLLLLLLL
+    __m256 y = _mm256_load_ps(bOut+n4+j); // RRRRRRRR
+    __m256 a = _mm256_unpacklo_ps(x, y);  // LRLRLRLR
+    __m256 b = _mm256_unpackhi_ps(x, y);  // LRLRLRLR
+    _mm256_store_ps(outputBuffers+i, a);
+    _mm256_store_ps(outputBuffers+8+i, b);
+  }
+  #elif HV_SIMD_SSE
+  for (int i = 0, j = 0; j < n4; j += 4, i += 8) {
+    __m128 x = _mm_load_ps(bOut+j);    // LLLL
+    __m128 y = _mm_load_ps(bOut+n4+j); // RRRR
+    __m128 a = _mm_unpacklo_ps(x, y);  // LRLR
+    __m128 b = _mm_unpackhi_ps(x, y);  // LRLR
+    _mm_store_ps(outputBuffers+i, a);
+    _mm_store_ps(outputBuffers+4+i, b);
+  }
+  #elif HV_SIMD_NEON
+  for (int i = 0, j = 0; j < n4; j += 4, i += 8) {
+    float32x4_t x = vld1q_f32(bOut+j);
+    float32x4_t y = vld1q_f32(bOut+n4+j);
+    float32x4x2_t z = {x, y};
+    vst2q_f32(outputBuffers+i, z); // interleave and store
+  }
+  #else // HV_SIMD_NONE
+  for (int i = 0; i < 2; ++i) {
+    for (int j = 0; j < n4; ++j) {
+      outputBuffers[i+2*j] = bOut[i*n4+j];
+    }
+  }
+  #endif
+
+  return n;
+}
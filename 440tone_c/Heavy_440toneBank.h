@@ -0,0 +1,53 @@
+/**
+ * @file Heavy_440toneBank.h
+ * @brief C API of the 440tone voice bank: N oscillators of the patch in one context
+ * @author Ale Moglia
+ * @date 2026
+ *
+ * A voice bank behaves like numVoices hv_440tone contexts whose outputs are added, but
+ * it has one message queue, one input pipe and one process() loop in which the SIMD
+ * lanes are voices. Everything else (hv_processInline(), hv_sendMessageToReceiverV(), ...)
+ * is the usual HvHeavy.h API.
+ *
+ * Receivers:
+ * - voice_freq <voice> <Hz>: oscillator frequency of one voice (default 440 Hz)
+ * - voice_gain <voice> <gain>: mix level of one voice (default 1, 0 = silent)
+ * e.g. hv_sendMessageToReceiverV(bank, hv_stringToHash("voice_freq"), 0.0, "ff", 2.0f, 660.0f);
+ *
+ * Parameters (hv_setParameter()):
+ * - 0 bank_gain: output level after the mix (default 1), ramped per sample with
+ *   hv_setParameterSmoothing()
+ */
+
+#ifndef _HEAVY_440TONE_BANK_H_
+#define _HEAVY_440TONE_BANK_H_
+
+#include "HvHeavy.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Creates a new voice bank.
+ * @param sampleRate  Sample rate should be positive and in Hertz, e.g. 48000.0.
+ * @param numVoices  Number of voices (>= 1), rounded up internally to a multiple of the SIMD width.
+ */
+HeavyContextInterface *hv_440tone_bank_new(double sampleRate, int numVoices);
+
+/**
+ * Creates a new voice bank, with the same queue options as hv_440tone_new_with_options().
+ */
+HeavyContextInterface *hv_440tone_bank_new_with_options(double sampleRate, int numVoices,
+    int poolKb, int inQueueKb, int outQueueKb);
+
+/**
+ * Free the voice bank.
+ */
+void hv_440tone_bank_free(HeavyContextInterface *instance);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // _HEAVY_440TONE_BANK_H_
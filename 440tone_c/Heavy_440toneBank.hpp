@@ -0,0 +1,51 @@
+/**
+ * @file Heavy_440toneBank.hpp
+ * @brief 440tone voice bank context: one phasor/cosine chain per voice, voices in SIMD lanes
+ * @author Ale Moglia
+ * @date 2026
+ */
+
+#ifndef _HEAVY_CONTEXT_440TONE_BANK_HPP_
+#define _HEAVY_CONTEXT_440TONE_BANK_HPP_
+
+// object includes
+#include "HeavyContext.hpp"
+#include "HvSignalPhasorBank.h"
+#include "HvSignalWavetable.hpp"
+#include "HvSignalVar.h"
+#include "HvMath.h"
+
+class Heavy_440toneBank : public HeavyContext {
+
+ public:
+  Heavy_440toneBank(double sampleRate, int numVoices, int poolKb=10, int inQueueKb=2, int outQueueKb=0);
+  ~Heavy_440toneBank();
+
+  const char *getName() override { return "440tone_bank"; }
+  int getNumInputChannels() override { return 0; }
+  int getNumOutputChannels() override { return 2; }
+
+  int process(float **inputBuffers, float **outputBuffer, int n) override;
+  int processInline(float *inputBuffers, float *outputBuffer, int n) override;
+  int processInlineInterleaved(float *inputBuffers, float *outputBuffer, int n) override;
+
+  int getParameterInfo(int index, HvParameterInfo *info) override;
+
+  int getNumVoices() const { return numVoices; }
+
+ private:
+  HvTable *getTableForHash(hv_uint32_t tableHash) override;
+  void scheduleMessageForReceiver(hv_uint32_t receiverHash, HvMessage *m) override;
+
+  // static sendMessage functions
+  static void cReceive_voiceFreq_sendMessage(HeavyContextInterface *, int, const HvMessage *);
+  static void cReceive_voiceGain_sendMessage(HeavyContextInterface *, int, const HvMessage *);
+
+  // objects, HV_N_SIMD voices per group (padding lanes stay silent)
+  int numVoices;
+  int numGroups;
+  SignalPhasorBank *sPhasorBank; // [numGroups]
+  hv_bufferf_t *gain;            // [numGroups]
+};
+
+#endif // _HEAVY_CONTEXT_440TONE_BANK_HPP_
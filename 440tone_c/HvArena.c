@@ -0,0 +1,95 @@
+/**
+ * @file HvArena.c
+ * @brief Static bump arena backing hv_malloc() on HV_BARE_METAL builds
+ * @author Ale Moglia
+ * @date 2026
+ */
+
+#include "HvUtils.h"
+
+#if HV_ARENA
+
+// each block is preceded by one aligned header holding its usable size
+#define HV_ARENA_HEADER_BYTES HV_ARENA_ALIGN
+#define HV_ARENA_BYTES (HV_ARENA_KB * 1024)
+
+#ifdef HV_ARENA_SECTION
+static hv_uint8_t hv_arena[HV_ARENA_BYTES] __attribute__((aligned(HV_ARENA_ALIGN), section(HV_ARENA_SECTION)));
+#else
+static hv_uint8_t hv_arena[HV_ARENA_BYTES] __attribute__((aligned(HV_ARENA_ALIGN)));
+#endif
+
+static hv_size_t hv_arena_index = 0; // bytes reserved so far
+static hv_size_t hv_arena_last = 0; // offset of the most recent block's header
+static bool hv_arena_sealed = false;
+static hv_uint32_t hv_arena_refused = 0;
+
+static inline hv_size_t hv_arena_blockSize(const void *p) {
+  return *((const hv_uint32_t *) ((const hv_uint8_t *) p - HV_ARENA_HEADER_BYTES));
+}
+
+void *hv_arena_alloc(hv_size_t numBytes) {
+  const hv_size_t aligned = (numBytes + (HV_ARENA_ALIGN-1)) & ~((hv_size_t) HV_ARENA_ALIGN-1);
+  if (hv_arena_sealed || (hv_arena_index + HV_ARENA_HEADER_BYTES + aligned) > HV_ARENA_BYTES) {
+    ++hv_arena_refused;
+    hv_assert(!hv_arena_sealed && "hv_malloc() called after the arena was sealed (allocation inside process()).");
+    hv_assert(false && "The Heavy arena is full. Increase HV_ARENA_KB.");
+    return NULL;
+  }
+  hv_uint8_t *const header = hv_arena + hv_arena_index;
+  *((hv_uint32_t *) header) = (hv_uint32_t) aligned;
+  hv_arena_last = hv_arena_index;
+  hv_arena_index += HV_ARENA_HEADER_BYTES + aligned;
+  return header + HV_ARENA_HEADER_BYTES;
+}
+
+void *hv_arena_realloc(void *p, hv_size_t numBytes) {
+  if (p == NULL) return hv_arena_alloc(numBytes);
+  const hv_size_t oldSize = hv_arena_blockSize(p);
+  const hv_size_t offset = (hv_size_t) ((hv_uint8_t *) p - hv_arena) - HV_ARENA_HEADER_BYTES;
+  if (offset == hv_arena_last && !hv_arena_sealed) {
+    // the last block can simply move the end of the arena
+    const hv_size_t aligned = (numBytes + (HV_ARENA_ALIGN-1)) & ~((hv_size_t) HV_ARENA_ALIGN-1);
+    if ((offset + HV_ARENA_HEADER_BYTES + aligned) <= HV_ARENA_BYTES) {
+      *((hv_uint32_t *) (hv_arena + offset)) = (hv_uint32_t) aligned;
+      hv_arena_index = offset + HV_ARENA_HEADER_BYTES + aligned;
+      return p;
+    }
+  }
+  void *const q = hv_arena_alloc(numBytes);
+  if (q != NULL) hv_memcpy(q, p, hv_min_ui((hv_uint32_t) oldSize, (hv_uint32_t) numBytes));
+  return q;
+}
+
+void hv_arena_free(void *p) {
+  if (p == NULL || hv_arena_sealed) return;
+  const hv_size_t offset = (hv_size_t) ((hv_uint8_t *) p - hv_arena) - HV_ARENA_HEADER_BYTES;
+  if (offset == hv_arena_last) {
+    // only the most recent block can be handed back, the previous header is not tracked
+    hv_arena_index = offset;
+  }
+}
+
+void hv_arena_seal(void) {
+  hv_arena_sealed = true;
+}
+
+void hv_arena_reset(void) {
+  hv_arena_index = 0;
+  hv_arena_last = 0;
+  hv_arena_sealed = false;
+}
+
+hv_size_t hv_arena_used(void) {
+  return hv_arena_index;
+}
+
+hv_size_t hv_arena_size(void) {
+  return HV_ARENA_BYTES;
+}
+
+hv_uint32_t hv_arena_failures(void) {
+  return hv_arena_refused;
+}
+
+#endif // HV_ARENA
@@ -0,0 +1,74 @@
+/**
+ * @file HvArena.h
+ * @brief Static bump arena backing hv_malloc() on HV_BARE_METAL builds
+ * @author Ale Moglia
+ * @date 2026
+ *
+ * With HV_BARE_METAL and HV_ARENA_KB > 0, HvUtils.h maps hv_malloc/hv_realloc/hv_free
+ * onto this arena, so the context, the message pool buffers, the pool and queue nodes and
+ * the HvLightPipe buffers created by hv_440tone_new_with_options() are all carved out of
+ * one compile-time sized, linker-placed array instead of the newlib heap.
+ *
+ * hv_arena_seal() (called by process() when HV_ARENA_SEAL is set) forbids any further
+ * allocation: from then on hv_malloc() asserts and returns NULL.
+ */
+
+#ifndef _HEAVY_ARENA_H_
+#define _HEAVY_ARENA_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Arena size in KB, 0 = hv_malloc() stays on the heap
+#ifndef HV_ARENA_KB
+#define HV_ARENA_KB 0
+#endif
+
+// 1 = the first process() call seals the arena against any further allocation
+#ifndef HV_ARENA_SEAL
+#define HV_ARENA_SEAL 1
+#endif
+
+// Output section of the arena array, e.g. ".scratch_x.hv_arena" for the RP2350 SCRATCH_X bank
+// (4 KB, shared with the core 1 stack). Undefined = .bss
+// #define HV_ARENA_SECTION ".scratch_x.hv_arena"
+
+// Every block is aligned for 16-byte SIMD loads
+#define HV_ARENA_ALIGN 16
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Allocates numBytes from the arena. Returns NULL when full or sealed. */
+void *hv_arena_alloc(size_t numBytes);
+
+/**
+ * Resizes a block. The last block grows or shrinks in place, any other block is copied
+ * to a new one (its old space is not reclaimed).
+ */
+void *hv_arena_realloc(void *p, size_t numBytes);
+
+/** Releases a block. Only the most recent block is reclaimed, otherwise a no-op. */
+void hv_arena_free(void *p);
+
+/** Forbids any further allocation. */
+void hv_arena_seal(void);
+
+/** Releases everything and unseals, e.g. before creating a new context. */
+void hv_arena_reset(void);
+
+/** Bytes in use, including block headers and alignment. */
+size_t hv_arena_used(void);
+
+/** Total arena size in bytes. */
+size_t hv_arena_size(void);
+
+/** Number of allocations refused (arena full or sealed). */
+uint32_t hv_arena_failures(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _HEAVY_ARENA_H_
@@ -171,7 +171,7 @@ HV_EXPORT bool hv_sendBangToReceiver(HeavyContextInterface *c, hv_uint32_t recei
   return c->sendBangToReceiver(receiverHash);
 }
 
-HV_EXPORT bool hv_sendFloatToReceiver(HeavyContextInterface *c, hv_uint32_t receiverHash, float x) {
+HV_EXPORT bool HV_HOT(hv_sendFloatToReceiver)(HeavyContextInterface *c, hv_uint32_t receiverHash, float x) {
   hv_assert(c != nullptr);
   return c->sendFloatToReceiver(receiverHash, x);
 }
@@ -190,20 +190,50 @@ HV_EXPORT bool hv_sendMessageToReceiverV(
   va_list ap;
   va_start(ap, format);
   const int numElem = (int) hv_strlen(format);
-  HvMessage *m = HV_MESSAGE_ON_STACK(numElem);
-  msg_init(m, numElem, c->getCurrentSample() + (hv_uint32_t) (hv_max_d(0.0, delayMs)*c->getSampleRate()/1000.0));
-  for (int i = 0; i < numElem; i++) {
-    switch (format[i]) {
-      case 'b': msg_setBang(m, i); break;
-      case 'f': msg_setFloat(m, i, (float) va_arg(ap, double)); break;
-      case 'h': msg_setHash(m, i, (int) va_arg(ap, int)); break;
-      case 's': msg_setSymbol(m, i, (char *) va_arg(ap, char *)); break;
-      default: break;
+  bool success;
+  if (hv_strchr(format, 's') == nullptr) {
+    // no symbols, the message size is known up front: build it directly in the input queue
+    HvMessage *m = c->reserveMessageForReceiver(receiverHash, delayMs, numElem);
+    success = (m != nullptr);
+    if (success) {
+      for (int i = 0; i < numElem; i++) {
+        switch (format[i]) {
+          case 'b': msg_setBang(m, i); break;
+          case 'f': msg_setFloat(m, i, (float) va_arg(ap, double)); break;
+          case 'h': msg_setHash(m, i, (int) va_arg(ap, int)); break;
+          default: break;
+        }
+      }
+      c->commitMessage();
     }
+  } else {
+    HvMessage *m = HV_MESSAGE_ON_STACK(numElem);
+    msg_init(m, numElem, c->getCurrentSample() + (hv_uint32_t) (hv_max_d(0.0, delayMs)*c->getSampleRate()/1000.0));
+    for (int i = 0; i < numElem; i++) {
+      switch (format[i]) {
+        case 'b': msg_setBang(m, i); break;
+        case 'f': msg_setFloat(m, i, (float) va_arg(ap, double)); break;
+        case 'h': msg_setHash(m, i, (int) va_arg(ap, int)); break;
+        case 's': msg_setSymbol(m, i, (char *) va_arg(ap, char *)); break;
+        default: break;
+      }
+    }
+    success = c->sendMessageToReceiver(receiverHash, delayMs, m);
   }
   va_end(ap);
 
-  return c->sendMessageToReceiver(receiverHash, delayMs, m);
+  return success;
+}
+
+HV_EXPORT HvMessage *hv_reserveMessageForReceiver(
+    HeavyContextInterface *c, hv_uint32_t receiverHash, double delayMs, int numElements) {
+  hv_assert(c != nullptr);
+  return c->reserveMessageForReceiver(receiverHash, delayMs, numElements);
+}
+
+HV_EXPORT void hv_commitMessage(HeavyContextInterface *c) {
+  hv_assert(c != nullptr);
+  c->commitMessage();
 }
 
 HV_EXPORT bool hv_sendMessageToReceiverFF(
@@ -211,13 +241,12 @@ HV_EXPORT bool hv_sendMessageToReceiverFF(
   hv_assert(c != nullptr);
   hv_assert(delayMs >= 0.0);
 
-  const int numElem = (int) 2;
-  HvMessage *m = HV_MESSAGE_ON_STACK(numElem);
-  msg_init(m, numElem, c->getCurrentSample() + (hv_uint32_t) (hv_max_d(0.0, delayMs)*c->getSampleRate()/1000.0));
+  HvMessage *m = c->reserveMessageForReceiver(receiverHash, delayMs, 2);
+  if (m == nullptr) return false;
   msg_setFloat(m, 0, (float) data1);
   msg_setFloat(m, 1, (float) data2);
-
-  return c->sendMessageToReceiver(receiverHash, delayMs, m);
+  c->commitMessage();
+  return true;
 }
 
 HV_EXPORT bool hv_sendMessageToReceiverFFF(
@@ -225,14 +254,13 @@ HV_EXPORT bool hv_sendMessageToReceiverFFF(
   hv_assert(c != nullptr);
   hv_assert(delayMs >= 0.0);
 
-  const int numElem = (int) 3;
-  HvMessage *m = HV_MESSAGE_ON_STACK(numElem);
-  msg_init(m, numElem, c->getCurrentSample() + (hv_uint32_t) (hv_max_d(0.0, delayMs)*c->getSampleRate()/1000.0));
+  HvMessage *m = c->reserveMessageForReceiver(receiverHash, delayMs, 3);
+  if (m == nullptr) return false;
   msg_setFloat(m, 0, (float) data1);
   msg_setFloat(m, 1, (float) data2);
   msg_setFloat(m, 2, (float) data3);
-
-  return c->sendMessageToReceiver(receiverHash, delayMs, m);
+  c->commitMessage();
+  return true;
 }
 
 HV_EXPORT bool hv_sendMessageToReceiver(
@@ -286,6 +314,21 @@ HV_EXPORT int hv_getParameterInfo(HeavyContextInterface *c, int index, HvParamet
   return c->getParameterInfo(index, info);
 }
 
+HV_EXPORT bool HV_HOT(hv_setParameter)(HeavyContextInterface *c, int index, float value) {
+  hv_assert(c != nullptr);
+  return c->setParameter(index, value);
+}
+
+HV_EXPORT bool hv_setParameters(HeavyContextInterface *c, int index, int count, const float *values) {
+  hv_assert(c != nullptr);
+  return c->setParameters(index, count, values);
+}
+
+HV_EXPORT bool hv_setParameterSmoothing(HeavyContextInterface *c, int index, float ms) {
+  hv_assert(c != nullptr);
+  return c->setParameterSmoothing(index, ms);
+}
+
 HV_EXPORT void hv_lock_acquire(HeavyContextInterface *c) {
   hv_assert(c != nullptr);
   c->lockAcquire();
@@ -323,17 +366,17 @@ HV_EXPORT bool hv_getNextSentMessage(HeavyContextInterface *c, hv_uint32_t *dest
 #pragma mark - Heavy Common
 #endif
 
-HV_EXPORT int hv_process(HeavyContextInterface *c, float **inputBuffers, float **outputBuffers, int n) {
+HV_EXPORT int HV_HOT(hv_process)(HeavyContextInterface *c, float **inputBuffers, float **outputBuffers, int n) {
   hv_assert(c != nullptr);
   return c->process(inputBuffers, outputBuffers, n);
 }
 
-HV_EXPORT int hv_processInline(HeavyContextInterface *c, float *inputBuffers, float *outputBuffers, int n) {
+HV_EXPORT int HV_HOT(hv_processInline)(HeavyContextInterface *c, float *inputBuffers, float *outputBuffers, int n) {
   hv_assert(c != nullptr);
   return c->processInline(inputBuffers, outputBuffers, n);
 }
 
-HV_EXPORT int hv_processInlineInterleaved(HeavyContextInterface *c, float *inputBuffers, float *outputBuffers, int n) {
+HV_EXPORT int HV_HOT(hv_processInlineInterleaved)(HeavyContextInterface *c, float *inputBuffers, float *outputBuffers, int n) {
   hv_assert(c != nullptr);
   return c->processInlineInterleaved(inputBuffers, outputBuffers, n);
 }
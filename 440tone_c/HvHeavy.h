@@ -146,7 +146,10 @@ HvPrintHook_t *hv_getPrintHook(HeavyContextInterface *c);
  */
 void hv_setSendHook(HeavyContextInterface *c, HvSendHook_t *f);
 
-/** Returns a 32-bit hash of any string. Returns 0 if string is NULL. */
+/**
+ * Returns a 32-bit hash of any string. Returns 0 if string is NULL.
+ * In C++, HV_HASH("name") (HvUtils.h) gives the same hash as a compile-time constant.
+ */
 hv_uint32_t hv_stringToHash(const char *s);
 
 /**
@@ -189,6 +192,23 @@ bool hv_sendSymbolToReceiver(HeavyContextInterface *c, hv_uint32_t receiverHash,
  */
 bool hv_sendMessageToReceiverV(HeavyContextInterface *c, hv_uint32_t receiverHash, double delayMs, const char *format, ...);
 
+/**
+ * Reserves a message of numElements elements directly in the input message queue, so
+ * that it can be built in place without a copy. Set each element with msg_setFloat(),
+ * msg_setBang() or msg_setHash(), then publish it with hv_commitMessage(). Symbols are
+ * not supported. Only one reservation may be open at a time. Unless HV_LIGHTPIPE_SPSC
+ * is set, the input message queue lock is held until hv_commitMessage().
+ *
+ * @return  The message to fill in. NULL (and no hv_commitMessage()) if the message could
+ *          not fit onto the message queue to be processed this block.
+ */
+HvMessage *hv_reserveMessageForReceiver(HeavyContextInterface *c, hv_uint32_t receiverHash, double delayMs, int numElements);
+
+/**
+ * Publishes the message returned by the last successful hv_reserveMessageForReceiver().
+ */
+void hv_commitMessage(HeavyContextInterface *c);
+
 /**
  * Sends a fixed formatted message of two floats to a receiver that can be scheduled for the future.
  * The receiver is addressed with its hash, which can also be determined using hv_stringToHash().
@@ -252,6 +272,29 @@ hv_uint32_t hv_getCurrentSample(HeavyContextInterface *c);
  */
 int hv_getParameterInfo(HeavyContextInterface *c, int index, HvParameterInfo *info);
 
+/**
+ * Sets a parameter, addressed by its hv_getParameterInfo() index, without queuing a message.
+ * Only the latest value per parameter is applied, once at the start of the next block.
+ * This function is lock-free and thread-safe.
+ *
+ * @return  False if the index is not a parameter.
+ */
+bool hv_setParameter(HeavyContextInterface *c, int index, float value);
+
+/**
+ * Sets count consecutive parameters starting at index, all applied in the same block.
+ *
+ * @return  False if the range is not inside the parameter list.
+ */
+bool hv_setParameters(HeavyContextInterface *c, int index, int count, const float *values);
+
+/**
+ * Ramps the parameter linearly to each new value over ms milliseconds (0 = jump, the default).
+ *
+ * @return  False if the index is not a parameter.
+ */
+bool hv_setParameterSmoothing(HeavyContextInterface *c, int index, float ms);
+
 /** */
 float hv_samplesToMilliseconds(HeavyContextInterface *c, hv_uint32_t numSamples);
 
@@ -416,11 +459,17 @@ void hv_msg_free(HvMessage *m);
  * @param tableHash  The table identifier.
  * @param newSampleLength  The new length of the table, in samples. Must be positive.
  *
- * @return  False if the table could not be found. True otherwise.
+ * @return  False if the table could not be found or its new buffer could not be
+ *          allocated (the table is then unchanged). True otherwise.
  */
 bool hv_table_setLength(HeavyContextInterface *c, hv_uint32_t tableHash, hv_uint32_t newSampleLength);
 
-/** Returns a pointer to the raw buffer backing this table. DO NOT free it. */
+/**
+ * Returns a pointer to the raw buffer backing this table. DO NOT free it.
+ * A table initialised from const (flash) data is copied to the heap first, as the
+ * buffer may be written through this pointer. NULL if that copy cannot be allocated,
+ * as with a sealed arena after the first process(): call it once before then.
+ */
 float *hv_table_getBuffer(HeavyContextInterface *c, hv_uint32_t tableHash);
 
 /** Returns the length of this table in samples. */
@@ -43,6 +43,24 @@
 #define HLP_SET_UINT32_AT_BUFFER(a, b) (*((hv_uint32_t *) (a)) = (b))
 #define HLP_GET_UINT32_AT_BUFFER(a) (*((hv_uint32_t *) (a)))
 
+#if HV_LIGHTPIPE_SPSC
+#if !defined(__GNUC__) && !defined(__clang__)
+#error "HV_LIGHTPIPE_SPSC needs the GCC/Clang __atomic builtins"
+#endif
+// A record header is stored with release semantics after its payload, and loaded with
+// acquire semantics before the payload is read. Same for the read head in the other
+// direction, so the producer never reuses bytes the consumer is still reading.
+#define HLP_PUBLISH_UINT32_AT_BUFFER(a, b) __atomic_store_n((hv_uint32_t *) (a), (b), __ATOMIC_RELEASE)
+#define HLP_ACQUIRE_UINT32_AT_BUFFER(a) __atomic_load_n((hv_uint32_t *) (a), __ATOMIC_ACQUIRE)
+#define HLP_PUBLISH_READ_HEAD(q, p) __atomic_store_n(&(q)->readHead, (p), __ATOMIC_RELEASE)
+#define HLP_ACQUIRE_READ_HEAD(q) __atomic_load_n(&(q)->readHead, __ATOMIC_ACQUIRE)
+#else
+#define HLP_PUBLISH_UINT32_AT_BUFFER(a, b) do { hv_sfence(); HLP_SET_UINT32_AT_BUFFER(a, b); } while (0)
+#define HLP_ACQUIRE_UINT32_AT_BUFFER(a) HLP_GET_UINT32_AT_BUFFER(a)
+#define HLP_PUBLISH_READ_HEAD(q, p) ((q)->readHead = (p))
+#define HLP_ACQUIRE_READ_HEAD(q) ((q)->readHead)
+#endif
+
 hv_uint32_t hLp_init(HvLightPipe *q, hv_uint32_t numBytes) {
   if (numBytes > 0) {
     q->buffer = (char *) hv_malloc(numBytes);
@@ -62,17 +80,17 @@ void hLp_free(HvLightPipe *q) {
   hv_free(q->buffer);
 }
 
-hv_uint32_t hLp_hasData(HvLightPipe *q) {
-  hv_uint32_t x = HLP_GET_UINT32_AT_BUFFER(q->readHead);
+hv_uint32_t HV_HOT(hLp_hasData)(HvLightPipe *q) {
+  hv_uint32_t x = HLP_ACQUIRE_UINT32_AT_BUFFER(q->readHead);
   if (x == HLP_LOOP) {
-    q->readHead = q->buffer;
-    x = HLP_GET_UINT32_AT_BUFFER(q->readHead);
+    HLP_PUBLISH_READ_HEAD(q, q->buffer);
+    x = HLP_ACQUIRE_UINT32_AT_BUFFER(q->readHead);
   }
   return x;
 }
 
-char *hLp_getWriteBuffer(HvLightPipe *q, hv_uint32_t bytesToWrite) {
-  char *const readHead = q->readHead;
+char *HV_HOT(hLp_getWriteBuffer)(HvLightPipe *q, hv_uint32_t bytesToWrite) {
+  char *const readHead = HLP_ACQUIRE_READ_HEAD(q);
   char *const oldWriteHead = q->writeHead;
   const hv_uint32_t totalByteRequirement = bytesToWrite + 2*sizeof(hv_uint32_t);
 
@@ -93,8 +111,7 @@ char *hLp_getWriteBuffer(HvLightPipe *q, hv_uint32_t bytesToWrite) {
         q->writeHead = q->buffer;
         q->remainingBytes = q->len;
         HLP_SET_UINT32_AT_BUFFER(q->buffer, HLP_STOP);
-        hv_sfence();
-        HLP_SET_UINT32_AT_BUFFER(oldWriteHead, HLP_LOOP);
+        HLP_PUBLISH_UINT32_AT_BUFFER(oldWriteHead, HLP_LOOP);
         return q->buffer + sizeof(hv_uint32_t);
       }
     } else {
@@ -103,29 +120,26 @@ char *hLp_getWriteBuffer(HvLightPipe *q, hv_uint32_t bytesToWrite) {
   }
 }
 
-void hLp_produce(HvLightPipe *q, hv_uint32_t numBytes) {
+void HV_HOT(hLp_produce)(HvLightPipe *q, hv_uint32_t numBytes) {
   hv_assert(q->remainingBytes >= (numBytes + 2*sizeof(hv_uint32_t)));
   q->remainingBytes -= (sizeof(hv_uint32_t) + numBytes);
   char *const oldWriteHead = q->writeHead;
   q->writeHead += (sizeof(hv_uint32_t) + numBytes);
   HLP_SET_UINT32_AT_BUFFER(q->writeHead, HLP_STOP);
 
-  // save everything before this point to memory
-  hv_sfence();
-
-  // then save this
-  HLP_SET_UINT32_AT_BUFFER(oldWriteHead, numBytes);
+  // save everything before this point to memory, then save this
+  HLP_PUBLISH_UINT32_AT_BUFFER(oldWriteHead, numBytes);
 }
 
-char *hLp_getReadBuffer(HvLightPipe *q, hv_uint32_t *numBytes) {
+char *HV_HOT(hLp_getReadBuffer)(HvLightPipe *q, hv_uint32_t *numBytes) {
   *numBytes = HLP_GET_UINT32_AT_BUFFER(q->readHead);
   char *const readBuffer = q->readHead + sizeof(hv_uint32_t);
   return readBuffer;
 }
 
-void hLp_consume(HvLightPipe *q) {
+void HV_HOT(hLp_consume)(HvLightPipe *q) {
   hv_assert(HLP_GET_UINT32_AT_BUFFER(q->readHead) != HLP_STOP);
-  q->readHead += sizeof(hv_uint32_t) + HLP_GET_UINT32_AT_BUFFER(q->readHead);
+  HLP_PUBLISH_READ_HEAD(q, q->readHead + sizeof(hv_uint32_t) + HLP_GET_UINT32_AT_BUFFER(q->readHead));
 }
 
 void hLp_reset(HvLightPipe *q) {
@@ -23,6 +23,13 @@
 extern "C" {
 #endif
 
+// 1 = lock-free single-producer/single-consumer pipe for two cores: record headers and
+// the read head are published with acquire/release atomics (LDA/STL on ARMv8-M), and
+// HeavyContext no longer takes its queue locks around the pipes. Needs GCC/Clang.
+#ifndef HV_LIGHTPIPE_SPSC
+#define HV_LIGHTPIPE_SPSC 0
+#endif
+
 /*
  * This pipe assumes that there is only one producer thread and one consumer
  * thread. This data structure does not support any other configuration.
@@ -24,6 +24,20 @@
 // https://gcc.gnu.org/onlinedocs/gcc-4.8.1/gcc/ARM-NEON-Intrinsics.html
 // http://codesuppository.blogspot.co.uk/2015/02/sse2neonh-porting-guide-and-header-file.html
 
+#if HV_SIMD_M33
+// The M33 has no vector unit: apply the scalar function to each of the 4 lanes
+#define __HV_M33_LANES1(_f, _a) \
+    ((hv_bufferf_t) {(float) _f((_a)[0]), (float) _f((_a)[1]), (float) _f((_a)[2]), (float) _f((_a)[3])})
+#define __HV_M33_LANES2(_f, _a, _b) \
+    ((hv_bufferf_t) {(float) _f((_a)[0], (_b)[0]), (float) _f((_a)[1], (_b)[1]), \
+                     (float) _f((_a)[2], (_b)[2]), (float) _f((_a)[3], (_b)[3])})
+#define __HV_M33_LANES2_I(_f, _a, _b) \
+    ((hv_bufferi_t) {_f((_a)[0], (_b)[0]), _f((_a)[1], (_b)[1]), _f((_a)[2], (_b)[2]), _f((_a)[3], (_b)[3])})
+#define __HV_M33_LANES3(_f, _a, _b, _c) \
+    ((hv_bufferf_t) {(float) _f((_a)[0], (_b)[0], (_c)[0]), (float) _f((_a)[1], (_b)[1], (_c)[1]), \
+                     (float) _f((_a)[2], (_b)[2], (_c)[2]), (float) _f((_a)[3], (_b)[3], (_c)[3])})
+#endif
+
 static inline void __hv_zero_f(hv_bOutf_t bOut) {
 #if HV_SIMD_AVX
   *bOut = _mm256_setzero_ps();
@@ -31,6 +45,8 @@ static inline void __hv_zero_f(hv_bOutf_t bOut) {
   *bOut = _mm_setzero_ps();
 #elif HV_SIMD_NEON
   *bOut = vdupq_n_f32(0.0f);
+#elif HV_SIMD_M33
+  *bOut = (hv_bufferf_t) {0.0f, 0.0f, 0.0f, 0.0f};
 #else // HV_SIMD_NONE
   *bOut = 0.0f;
 #endif
@@ -43,6 +59,8 @@ static inline void __hv_zero_i(hv_bOuti_t bOut) {
   *bOut = _mm_setzero_si128();
 #elif HV_SIMD_NEON
   *bOut = vdupq_n_s32(0);
+#elif HV_SIMD_M33
+  *bOut = (hv_bufferi_t) {0, 0, 0, 0};
 #else // HV_SIMD_NONE
   *bOut = 0;
 #endif
@@ -55,6 +73,8 @@ static inline void __hv_load_f(float *bIn, hv_bOutf_t bOut) {
   *bOut = _mm_load_ps(bIn);
 #elif HV_SIMD_NEON
   *bOut = vld1q_f32(bIn);
+#elif HV_SIMD_M33
+  hv_memcpy(bOut, bIn, sizeof(hv_bufferf_t));
 #else // HV_SIMD_NONE
   *bOut = *bIn;
 #endif
@@ -67,6 +87,8 @@ static inline void __hv_store_f(float *bOut, hv_bInf_t bIn) {
   _mm_store_ps(bOut, bIn);
 #elif HV_SIMD_NEON
   vst1q_f32(bOut, bIn);
+#elif HV_SIMD_M33
+  hv_memcpy(bOut, &bIn, sizeof(hv_bufferf_t));
 #else // HV_SIMD_NONE
   *bOut = bIn;
 #endif
@@ -96,6 +118,8 @@ static inline void __hv_log2_f(hv_bInf_t bIn, hv_bOutf_t bOut) {
   float32x4_t g = vaddq_f32(d, f);
   float32x4_t h = vaddq_f32(g, vdupq_n_f32(-0.9569643f));
   *bOut = h;
+#elif HV_SIMD_M33
+  *bOut = 1.442695040888963f * __HV_M33_LANES1(hv_log_f, bIn);
 #else // HV_SIMD_NONE
   *bOut = 1.442695040888963f * hv_log_f(bIn);
 #endif
@@ -112,6 +136,8 @@ static inline void __hv_cos_f(hv_bInf_t bIn, hv_bOutf_t bOut) {
   *bOut = _mm_set_ps(hv_cos_f(b[3]), hv_cos_f(b[2]), hv_cos_f(b[1]), hv_cos_f(b[0]));
 #elif HV_SIMD_NEON
   *bOut = (float32x4_t) {hv_cos_f(bIn[0]), hv_cos_f(bIn[1]), hv_cos_f(bIn[2]), hv_cos_f(bIn[3])};
+#elif HV_SIMD_M33
+  *bOut = __HV_M33_LANES1(hv_cos_f, bIn);
 #else // HV_SIMD_NONE
   *bOut = hv_cos_f(bIn);
 #endif
@@ -124,6 +150,8 @@ static inline void __hv_acos_f(hv_bInf_t bIn, hv_bOutf_t bOut) {
   hv_assert(0); // __hv_acos_f() not implemented
 #elif HV_SIMD_NEON
   hv_assert(0); // __hv_acos_f() not implemented
+#elif HV_SIMD_M33
+  *bOut = __HV_M33_LANES1(hv_acos_f, bIn);
 #else // HV_SIMD_NONE
   *bOut = hv_acos_f(bIn);
 #endif
@@ -136,6 +164,8 @@ static inline void __hv_cosh_f(hv_bInf_t bIn, hv_bOutf_t bOut) {
   hv_assert(0); // __hv_cosh_f() not implemented
 #elif HV_SIMD_NEON
   hv_assert(0); // __hv_cosh_f() not implemented
+#elif HV_SIMD_M33
+  *bOut = __HV_M33_LANES1(hv_cosh_f, bIn);
 #else // HV_SIMD_NONE
   *bOut = hv_cosh_f(bIn);
 #endif
@@ -148,6 +178,8 @@ static inline void __hv_acosh_f(hv_bInf_t bIn, hv_bOutf_t bOut) {
   hv_assert(0); // __hv_acosh_f() not implemented
 #elif HV_SIMD_NEON
   hv_assert(0); // __hv_acosh_f() not implemented
+#elif HV_SIMD_M33
+  *bOut = __HV_M33_LANES1(hv_acosh_f, bIn);
 #else // HV_SIMD_NONE
   *bOut = hv_acosh_f(bIn);
 #endif
@@ -160,6 +192,8 @@ static inline void __hv_sin_f(hv_bInf_t bIn, hv_bOutf_t bOut) {
   hv_assert(0); // __hv_sin_f() not implemented
 #elif HV_SIMD_NEON
   hv_assert(0); // __hv_sin_f() not implemented
+#elif HV_SIMD_M33
+  *bOut = __HV_M33_LANES1(hv_sin_f, bIn);
 #else // HV_SIMD_NONE
   *bOut = hv_sin_f(bIn);
 #endif
@@ -172,6 +206,8 @@ static inline void __hv_asin_f(hv_bInf_t bIn, hv_bOutf_t bOut) {
   hv_assert(0); // __hv_asin_f() not implemented
 #elif HV_SIMD_NEON
   hv_assert(0); // __hv_asin_f() not implemented
+#elif HV_SIMD_M33
+  *bOut = __HV_M33_LANES1(hv_asin_f, bIn);
 #else // HV_SIMD_NONE
   *bOut = hv_asin_f(bIn);
 #endif
@@ -184,6 +220,8 @@ static inline void __hv_sinh_f(hv_bInf_t bIn, hv_bOutf_t bOut) {
   hv_assert(0); // __hv_sinh_f() not implemented
 #elif HV_SIMD_NEON
   hv_assert(0); // __hv_sinh_f() not implemented
+#elif HV_SIMD_M33
+  *bOut = __HV_M33_LANES1(hv_sinh_f, bIn);
 #else // HV_SIMD_NONE
   *bOut = hv_sinh_f(bIn);
 #endif
@@ -196,6 +234,8 @@ static inline void __hv_asinh_f(hv_bInf_t bIn, hv_bOutf_t bOut) {
   hv_assert(0); // __hv_asinh_f() not implemented
 #elif HV_SIMD_NEON
   hv_assert(0); // __hv_asinh_f() not implemented
+#elif HV_SIMD_M33
+  *bOut = __HV_M33_LANES1(hv_asinh_f, bIn);
 #else // HV_SIMD_NONE
   *bOut = hv_asinh_f(bIn);
 #endif
@@ -208,6 +248,8 @@ static inline void __hv_tan_f(hv_bInf_t bIn, hv_bOutf_t bOut) {
   hv_assert(0); // __hv_tan_f() not implemented
 #elif HV_SIMD_NEON
   hv_assert(0); // __hv_tan_f() not implemented
+#elif HV_SIMD_M33
+  *bOut = __HV_M33_LANES1(hv_tan_f, bIn);
 #else // HV_SIMD_NONE
   *bOut = hv_tan_f(bIn);
 #endif
@@ -220,6 +262,8 @@ static inline void __hv_atan_f(hv_bInf_t bIn, hv_bOutf_t bOut) {
   hv_assert(0); // __hv_atan_f() not implemented
 #elif HV_SIMD_NEON
   hv_assert(0); // __hv_atan_f() not implemented
+#elif HV_SIMD_M33
+  *bOut = __HV_M33_LANES1(hv_atan_f, bIn);
 #else // HV_SIMD_NONE
   *bOut = hv_atan_f(bIn);
 #endif
@@ -232,6 +276,8 @@ static inline void __hv_atan2_f(hv_bInf_t bIn0, hv_bInf_t bIn1, hv_bOutf_t bOut)
   hv_assert(0); // __hv_atan2_f() not implemented
 #elif HV_SIMD_NEON
   hv_assert(0); // __hv_atan2_f() not implemented
+#elif HV_SIMD_M33
+  *bOut = __HV_M33_LANES2(hv_atan2_f, bIn0, bIn1);
 #else // HV_SIMD_NONE
   *bOut = hv_atan2_f(bIn0, bIn1);
 #endif
@@ -244,6 +290,8 @@ static inline void __hv_tanh_f(hv_bInf_t bIn, hv_bOutf_t bOut) {
   hv_assert(0); // __hv_tanh_f() not implemented
 #elif HV_SIMD_NEON
   hv_assert(0); // __hv_tanh_f() not implemented
+#elif HV_SIMD_M33
+  *bOut = __HV_M33_LANES1(hv_tanh_f, bIn);
 #else // HV_SIMD_NONE
   *bOut = hv_tanh_f(bIn);
 #endif
@@ -256,6 +304,8 @@ static inline void __hv_atanh_f(hv_bInf_t bIn, hv_bOutf_t bOut) {
   hv_assert(0); // __hv_atanh_f() not implemented
 #elif HV_SIMD_NEON
   hv_assert(0); // __hv_atanh_f() not implemented
+#elif HV_SIMD_M33
+  *bOut = __HV_M33_LANES1(hv_atanh_f, bIn);
 #else // HV_SIMD_NONE
   *bOut = hv_atanh_f(bIn);
 #endif
@@ -269,6 +319,8 @@ static inline void __hv_sqrt_f(hv_bInf_t bIn, hv_bOutf_t bOut) {
 #elif HV_SIMD_NEON
   const float32x4_t y = vrsqrteq_f32(bIn);
   *bOut = vmulq_f32(bIn, vmulq_f32(vrsqrtsq_f32(vmulq_f32(bIn, y), y), y)); // numerical results may be inexact
+#elif HV_SIMD_M33
+  *bOut = __HV_M33_LANES1(hv_sqrt_f, bIn);
 #else // HV_SIMD_NONE
   *bOut = hv_sqrt_f(bIn);
 #endif
@@ -282,6 +334,8 @@ static inline void __hv_rsqrt_f(hv_bInf_t bIn, hv_bOutf_t bOut) {
 #elif HV_SIMD_NEON
   const float32x4_t y = vrsqrteq_f32(bIn);
   *bOut = vmulq_f32(vrsqrtsq_f32(vmulq_f32(bIn, y), y), y); // numerical results may be inexact
+#elif HV_SIMD_M33
+  *bOut = 1.0f / __HV_M33_LANES1(hv_sqrt_f, bIn);
 #else // HV_SIMD_NONE
   *bOut = 1.0f/hv_sqrt_f(bIn);
 #endif
@@ -294,6 +348,8 @@ static inline void __hv_abs_f(hv_bInf_t bIn, hv_bOutf_t bOut) {
   *bOut = _mm_andnot_ps(_mm_set1_ps(-0.0f), bIn); // == 1 << 31
 #elif HV_SIMD_NEON
   *bOut = vabsq_f32(bIn);
+#elif HV_SIMD_M33
+  *bOut = __HV_M33_LANES1(hv_abs_f, bIn);
 #else // HV_SIMD_NONE
   *bOut = hv_abs_f(bIn);
 #endif
@@ -306,6 +362,8 @@ static inline void __hv_neg_f(hv_bInf_t bIn, hv_bOutf_t bOut) {
   *bOut = _mm_xor_ps(bIn, _mm_set1_ps(-0.0f));
 #elif HV_SIMD_NEON
   *bOut = vnegq_f32(bIn);
+#elif HV_SIMD_M33
+  *bOut = -bIn;
 #else // HV_SIMD_NONE
   *bOut = bIn * -1.0f;
 #endif
@@ -328,6 +386,8 @@ static inline void __hv_exp_f(hv_bInf_t bIn, hv_bOutf_t bOut) {
     hv_exp_f(bIn[1]),
     hv_exp_f(bIn[2]),
     hv_exp_f(bIn[3])};
+#elif HV_SIMD_M33
+  *bOut = __HV_M33_LANES1(hv_exp_f, bIn);
 #else // HV_SIMD_NONE
   *bOut = hv_exp_f(bIn);
 #endif
@@ -340,6 +400,8 @@ static inline void __hv_expm1_f(hv_bInf_t bIn, hv_bOutf_t bOut) {
   hv_assert(0); // __hv_expm1_f() not implemented
 #elif HV_SIMD_NEON
   hv_assert(0); // __hv_expm1_f() not implemented
+#elif HV_SIMD_M33
+  *bOut = __HV_M33_LANES1(hv_expm1_f, bIn);
 #else // HV_SIMD_NONE
   *bOut = hv_expm1_f(bIn);
 #endif
@@ -358,6 +420,8 @@ static inline void __hv_ceil_f(hv_bInf_t bIn, hv_bOutf_t bOut) {
   // the necessary intrinsic cannot be found. It is only available in ARMv8.
   *bOut = (float32x4_t) {hv_ceil_f(bIn[0]), hv_ceil_f(bIn[1]), hv_ceil_f(bIn[2]), hv_ceil_f(bIn[3])};
 #endif // vrndpq_f32
+#elif HV_SIMD_M33
+  *bOut = __HV_M33_LANES1(hv_ceil_f, bIn);
 #else // HV_SIMD_NONE
   *bOut = hv_ceil_f(bIn);
 #endif
@@ -376,6 +440,8 @@ static inline void __hv_floor_f(hv_bInf_t bIn, hv_bOutf_t bOut) {
   // the necessary intrinsic cannot be found. It is only available from ARMv8.
   *bOut = (float32x4_t) {hv_floor_f(bIn[0]), hv_floor_f(bIn[1]), hv_floor_f(bIn[2]), hv_floor_f(bIn[3])};
 #endif // vrndmq_f32
+#elif HV_SIMD_M33
+  *bOut = __HV_M33_LANES1(hv_floor_f, bIn);
 #else // HV_SIMD_NONE
   *bOut = hv_floor_f(bIn);
 #endif
@@ -389,6 +455,8 @@ static inline void __hv_add_f(hv_bInf_t bIn0, hv_bInf_t bIn1, hv_bOutf_t bOut) {
   *bOut = _mm_add_ps(bIn0, bIn1);
 #elif HV_SIMD_NEON
   *bOut = vaddq_f32(bIn0, bIn1);
+#elif HV_SIMD_M33
+  *bOut = bIn0 + bIn1;
 #else // HV_SIMD_NONE
   *bOut = bIn0 + bIn1;
 #endif
@@ -404,6 +472,8 @@ static inline void __hv_add_i(hv_bIni_t bIn0, hv_bIni_t bIn1, hv_bOuti_t bOut) {
   *bOut = _mm_add_epi32(bIn0, bIn1);
 #elif HV_SIMD_NEON
   *bOut = vaddq_s32(bIn0, bIn1);
+#elif HV_SIMD_M33
+  *bOut = bIn0 + bIn1;
 #else // HV_SIMD_NONE
   *bOut = bIn0 + bIn1;
 #endif
@@ -417,6 +487,8 @@ static inline void __hv_sub_f(hv_bInf_t bIn0, hv_bInf_t bIn1, hv_bOutf_t bOut) {
   *bOut = _mm_sub_ps(bIn0, bIn1);
 #elif HV_SIMD_NEON
   *bOut = vsubq_f32(bIn0, bIn1);
+#elif HV_SIMD_M33
+  *bOut = bIn0 - bIn1;
 #else // HV_SIMD_NONE
   *bOut = bIn0 - bIn1;
 #endif
@@ -430,6 +502,8 @@ static inline void __hv_mul_f(hv_bInf_t bIn0, hv_bInf_t bIn1, hv_bOutf_t bOut) {
   *bOut = _mm_mul_ps(bIn0, bIn1);
 #elif HV_SIMD_NEON
   *bOut = vmulq_f32(bIn0, bIn1);
+#elif HV_SIMD_M33
+  *bOut = bIn0 * bIn1;
 #else // HV_SIMD_NONE
   *bOut = bIn0 * bIn1;
 #endif
@@ -445,6 +519,8 @@ static inline void __hv_mul_i(hv_bIni_t bIn0, hv_bIni_t bIn1, hv_bOuti_t bOut) {
   *bOut = _mm_mullo_epi32(bIn0, bIn1);
 #elif HV_SIMD_NEON
   *bOut = vmulq_s32(bIn0, bIn1);
+#elif HV_SIMD_M33
+  *bOut = bIn0 * bIn1;
 #else // HV_SIMD_NONE
   *bOut = bIn0 * bIn1;
 #endif
@@ -458,6 +534,8 @@ static inline void __hv_cast_if(hv_bIni_t bIn, hv_bOutf_t bOut) {
   *bOut = _mm_cvtepi32_ps(bIn);
 #elif HV_SIMD_NEON
   *bOut = vcvtq_f32_s32(bIn);
+#elif HV_SIMD_M33
+  *bOut = __builtin_convertvector(bIn, hv_bufferf_t);
 #else // HV_SIMD_NONE
   *bOut = (float) bIn;
 #endif
@@ -471,6 +549,8 @@ static inline void __hv_cast_fi(hv_bInf_t bIn, hv_bOuti_t bOut) {
   *bOut = _mm_cvtps_epi32(bIn);
 #elif HV_SIMD_NEON
   *bOut = vcvtq_s32_f32(bIn);
+#elif HV_SIMD_M33
+  *bOut = __builtin_convertvector(bIn, hv_bufferi_t);
 #else // HV_SIMD_NONE
   *bOut = (int) bIn;
 #endif
@@ -484,6 +564,8 @@ static inline void __hv_cast_if_expr(hv_bInf_t bIn, hv_bOutf_t bOut) {
   hv_assert(0); // __hv_cast_if_expr() not implemented
 #elif HV_SIMD_NEON
   hv_assert(0); // __hv_cast_if_expr() not implemented
+#elif HV_SIMD_M33
+  *bOut = bIn;
 #else // HV_SIMD_NONE
   *bOut = (float) bIn;
 #endif
@@ -497,6 +579,12 @@ static inline void __hv_cast_fi_expr(hv_bInf_t bIn, hv_bOutf_t bOut) {
   hv_assert(0); // __hv_cast_fi_expr() not implemented
 #elif HV_SIMD_NEON
   hv_assert(0); // __hv_cast_fi_expr() not implemented
+#elif HV_SIMD_M33
+  for (int i = 0; i < HV_N_SIMD; ++i) {
+    if (bIn[i] < 0.0f) (*bOut)[i] = hv_rint_f(bIn[i]);
+    else if (bIn[i] > 0.0f) (*bOut)[i] = hv_floor_f(bIn[i]);
+    else (*bOut)[i] = 0.0f;
+  }
 #else // HV_SIMD_NONE
   if (bIn < 0.0f) *bOut = hv_rint_f(bIn);
   else if (bIn > 0.0f) *bOut = hv_floor_f(bIn);
@@ -517,6 +605,10 @@ static inline void __hv_div_f(hv_bInf_t bIn0, hv_bInf_t bIn1, hv_bOutf_t bOut) {
   uint32x4_t a = vceqq_f32(bIn1, vdupq_n_f32(0.0f));
   float32x4_t b = vmulq_f32(bIn0, vrecpeq_f32(bIn1)); // NOTE(mhroth): numerical results may be inexact
   *bOut = vreinterpretq_f32_u32(vbicq_u32(vreinterpretq_u32_f32(b), a));
+#elif HV_SIMD_M33
+  for (int i = 0; i < HV_N_SIMD; ++i) {
+    (*bOut)[i] = (bIn1[i] != 0.0f) ? (bIn0[i] / bIn1[i]) : 0.0f;
+  }
 #else // HV_SIMD_NONE
   *bOut = (bIn1 != 0.0f) ? (bIn0 / bIn1) : 0.0f;
 #endif
@@ -529,6 +621,8 @@ static inline void __hv_min_f(hv_bInf_t bIn0, hv_bInf_t bIn1, hv_bOutf_t bOut) {
   *bOut = _mm_min_ps(bIn0, bIn1);
 #elif HV_SIMD_NEON
   *bOut = vminq_f32(bIn0, bIn1);
+#elif HV_SIMD_M33
+  *bOut = __HV_M33_LANES2(hv_min_f, bIn0, bIn1);
 #else // HV_SIMD_NONE
   *bOut = hv_min_f(bIn0, bIn1);
 #endif
@@ -543,6 +637,8 @@ static inline void __hv_min_i(hv_bIni_t bIn0, hv_bIni_t bIn1, hv_bOuti_t bOut) {
   *bOut = _mm_min_epi32(bIn0, bIn1);
 #elif HV_SIMD_NEON
   *bOut = vminq_s32(bIn0, bIn1);
+#elif HV_SIMD_M33
+  *bOut = __HV_M33_LANES2_I(hv_min_i, bIn0, bIn1);
 #else // HV_SIMD_NONE
   *bOut = hv_min_i(bIn0, bIn1);
 #endif
@@ -555,6 +651,8 @@ static inline void __hv_max_f(hv_bInf_t bIn0, hv_bInf_t bIn1, hv_bOutf_t bOut) {
   *bOut = _mm_max_ps(bIn0, bIn1);
 #elif HV_SIMD_NEON
   *bOut = vmaxq_f32(bIn0, bIn1);
+#elif HV_SIMD_M33
+  *bOut = __HV_M33_LANES2(hv_max_f, bIn0, bIn1);
 #else // HV_SIMD_NONE
   *bOut = hv_max_f(bIn0, bIn1);
 #endif
@@ -569,6 +667,8 @@ static inline void __hv_max_i(hv_bIni_t bIn0, hv_bIni_t bIn1, hv_bOuti_t bOut) {
   *bOut = _mm_max_epi32(bIn0, bIn1);
 #elif HV_SIMD_NEON
   *bOut = vmaxq_s32(bIn0, bIn1);
+#elif HV_SIMD_M33
+  *bOut = __HV_M33_LANES2_I(hv_max_i, bIn0, bIn1);
 #else // HV_SIMD_NONE
   *bOut = hv_max_i(bIn0, bIn1);
 #endif
@@ -603,6 +703,8 @@ static inline void __hv_pow_f(hv_bInf_t bIn0, hv_bInf_t bIn1, hv_bOutf_t bOut) {
       hv_pow_f(bIn0[1], bIn1[1]),
       hv_pow_f(bIn0[2], bIn1[2]),
       hv_pow_f(bIn0[3], bIn1[3])};
+#elif HV_SIMD_M33
+  *bOut = __HV_M33_LANES2(hv_pow_f, bIn0, bIn1);
 #else // HV_SIMD_NONE
   *bOut = hv_pow_f(bIn0, bIn1);
 #endif
@@ -615,6 +717,8 @@ static inline void __hv_gt_f(hv_bInf_t bIn0, hv_bInf_t bIn1, hv_bOutf_t bOut) {
   *bOut = _mm_cmpgt_ps(bIn0, bIn1);
 #elif HV_SIMD_NEON
   *bOut = vreinterpretq_f32_u32(vcgtq_f32(bIn0, bIn1));
+#elif HV_SIMD_M33
+  *bOut = (hv_bufferf_t) (bIn0 > bIn1);
 #else // HV_SIMD_NONE
   *bOut = (bIn0 > bIn1) ? 1.0f : 0.0f;
 #endif
@@ -627,6 +731,8 @@ static inline void __hv_gte_f(hv_bInf_t bIn0, hv_bInf_t bIn1, hv_bOutf_t bOut) {
   *bOut = _mm_cmpge_ps(bIn0, bIn1);
 #elif HV_SIMD_NEON
   *bOut = vreinterpretq_f32_u32(vcgeq_f32(bIn0, bIn1));
+#elif HV_SIMD_M33
+  *bOut = (hv_bufferf_t) (bIn0 >= bIn1);
 #else // HV_SIMD_NONE
   *bOut = (bIn0 >= bIn1) ? 1.0f : 0.0f;
 #endif
@@ -639,6 +745,8 @@ static inline void __hv_lt_f(hv_bInf_t bIn0, hv_bInf_t bIn1, hv_bOutf_t bOut) {
   *bOut = _mm_cmplt_ps(bIn0, bIn1);
 #elif HV_SIMD_NEON
   *bOut = vreinterpretq_f32_u32(vcltq_f32(bIn0, bIn1));
+#elif HV_SIMD_M33
+  *bOut = (hv_bufferf_t) (bIn0 < bIn1);
 #else // HV_SIMD_NONE
   *bOut = (bIn0 < bIn1) ? 1.0f : 0.0f;
 #endif
@@ -651,6 +759,8 @@ static inline void __hv_lte_f(hv_bInf_t bIn0, hv_bInf_t bIn1, hv_bOutf_t bOut) {
   *bOut = _mm_cmple_ps(bIn0, bIn1);
 #elif HV_SIMD_NEON
   *bOut = vreinterpretq_f32_u32(vcleq_f32(bIn0, bIn1));
+#elif HV_SIMD_M33
+  *bOut = (hv_bufferf_t) (bIn0 <= bIn1);
 #else // HV_SIMD_NONE
   *bOut = (bIn0 <= bIn1) ? 1.0f : 0.0f;
 #endif
@@ -663,6 +773,8 @@ static inline void __hv_eq_f(hv_bInf_t bIn0, hv_bInf_t bIn1, hv_bOutf_t bOut) {
   *bOut = _mm_cmpeq_ps(bIn0, bIn1);
 #elif HV_SIMD_NEON
   *bOut = vreinterpretq_f32_u32(vceqq_f32(bIn0, bIn1));
+#elif HV_SIMD_M33
+  *bOut = (hv_bufferf_t) (bIn0 == bIn1);
 #else // HV_SIMD_NONE
   *bOut = (bIn0 == bIn1) ? 1.0f : 0.0f;
 #endif
@@ -675,6 +787,8 @@ static inline void __hv_neq_f(hv_bInf_t bIn0, hv_bInf_t bIn1, hv_bOutf_t bOut) {
   *bOut = _mm_cmpneq_ps(bIn0, bIn1);
 #elif HV_SIMD_NEON
   *bOut = vreinterpretq_f32_u32(vmvnq_u32(vceqq_f32(bIn0, bIn1)));
+#elif HV_SIMD_M33
+  *bOut = (hv_bufferf_t) (bIn0 != bIn1);
 #else // HV_SIMD_NONE
   *bOut = (bIn0 != bIn1) ? 1.0f : 0.0f;
 #endif
@@ -687,6 +801,8 @@ static inline void __hv_or_f(hv_bInf_t bIn0, hv_bInf_t bIn1, hv_bOutf_t bOut) {
   *bOut = _mm_or_ps(bIn1, bIn0);
 #elif HV_SIMD_NEON
   *bOut = vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(bIn1), vreinterpretq_u32_f32(bIn0)));
+#elif HV_SIMD_M33
+  *bOut = (hv_bufferf_t) ((hv_bufferi_t) bIn1 | (hv_bufferi_t) bIn0);
 #else // HV_SIMD_NONE
   if (bIn0 == 0.0f && bIn1 == 0.0f) *bOut = 0.0f;
   else if (bIn0 == 0.0f) *bOut = bIn1;
@@ -702,6 +818,8 @@ static inline void __hv_and_f(hv_bInf_t bIn0, hv_bInf_t bIn1, hv_bOutf_t bOut) {
   *bOut = _mm_and_ps(bIn1, bIn0);
 #elif HV_SIMD_NEON
   *bOut = vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(bIn1), vreinterpretq_u32_f32(bIn0)));
+#elif HV_SIMD_M33
+  *bOut = (hv_bufferf_t) ((hv_bufferi_t) bIn1 & (hv_bufferi_t) bIn0);
 #else // HV_SIMD_NONE
   if (bIn0 == 0.0f || bIn1 == 0.0f) *bOut = 0.0f;
   else if (bIn0 == 1.0f) *bOut = bIn1;
@@ -717,6 +835,8 @@ static inline void __hv_not_f(hv_bInf_t bIn, hv_bOutf_t bOut) {
   hv_assert(0); // __hv_not_f() not implemented
 #elif HV_SIMD_NEON
   hv_assert(0); // __hv_not_f() not implemented
+#elif HV_SIMD_M33
+  *bOut = __HV_M33_LANES1(hv_not_f, bIn);
 #else // HV_SIMD_NONE
   *bOut = hv_not_f(bIn);
 #endif
@@ -729,6 +849,8 @@ static inline void __hv_andnot_f(hv_bInf_t bIn0_mask, hv_bInf_t bIn1, hv_bOutf_t
   *bOut = _mm_andnot_ps(bIn0_mask, bIn1);
 #elif HV_SIMD_NEON
   *bOut = vreinterpretq_f32_s32(vbicq_s32(vreinterpretq_s32_f32(bIn1), vreinterpretq_s32_f32(bIn0_mask)));
+#elif HV_SIMD_M33
+  *bOut = (hv_bufferf_t) ((hv_bufferi_t) bIn1 & ~(hv_bufferi_t) bIn0_mask);
 #else // HV_SIMD_NONE
   *bOut = (bIn0_mask == 0.0f) ? bIn1 : 0.0f;
 #endif
@@ -755,6 +877,8 @@ static inline void __hv_fma_f(hv_bInf_t bIn0, hv_bInf_t bIn1, hv_bInf_t bIn2, hv
   // NOTE(mhroth): it turns out, fma SUUUUCKS on lesser ARM architectures
   *bOut = vaddq_f32(vmulq_f32(bIn0, bIn1), bIn2);
 #endif
+#elif HV_SIMD_M33
+  *bOut = __HV_M33_LANES3(hv_fma_f, bIn0, bIn1, bIn2);
 #else // HV_SIMD_NONE
   *bOut = hv_fma_f(bIn0, bIn1, bIn2);
 #endif
@@ -781,6 +905,8 @@ static inline void __hv_fms_f(hv_bInf_t bIn0, hv_bInf_t bIn1, hv_bInf_t bIn2, hv
   // NOTE(mhroth): it turns out, fma SUUUUCKS on lesser ARM architectures
   *bOut = vsubq_f32(vmulq_f32(bIn0, bIn1), bIn2);
 #endif
+#elif HV_SIMD_M33
+  *bOut = (bIn0 * bIn1) - bIn2;
 #else // HV_SIMD_NONE
   *bOut = (bIn0 * bIn1) - bIn2;
 #endif
@@ -793,6 +919,8 @@ static inline void __hv_cbrt_f(hv_bInf_t bIn, hv_bOutf_t bOut) {
   hv_assert(0); // __hv_cbrt_f() not implemented
 #elif HV_SIMD_NEON
   hv_assert(0); // __hv_cbrt_f() not implemented
+#elif HV_SIMD_M33
+  *bOut = __HV_M33_LANES1(hv_cbrt_f, bIn);
 #else // HV_SIMD_NONE
   *bOut = hv_cbrt_f(bIn);
 #endif
@@ -805,6 +933,8 @@ static inline void __hv_erf_f(hv_bInf_t bIn, hv_bOutf_t bOut) {
   hv_assert(0); // __hv_erf_f() not implemented
 #elif HV_SIMD_NEON
   hv_assert(0); // __hv_erf_f() not implemented
+#elif HV_SIMD_M33
+  *bOut = __HV_M33_LANES1(hv_erf_f, bIn);
 #else // HV_SIMD_NONE
   *bOut = hv_erf_f(bIn);
 #endif
@@ -817,6 +947,8 @@ static inline void __hv_erfc_f(hv_bInf_t bIn, hv_bOutf_t bOut) {
   hv_assert(0); // __hv_erfc_f() not implemented
 #elif HV_SIMD_NEON
   hv_assert(0); // __hv_erfc_f() not implemented
+#elif HV_SIMD_M33
+  *bOut = __HV_M33_LANES1(hv_erfc_f, bIn);
 #else // HV_SIMD_NONE
   *bOut = hv_erfc_f(bIn);
 #endif
@@ -829,6 +961,8 @@ static inline void __hv_ln_f(hv_bInf_t bIn, hv_bOutf_t bOut) {
   hv_assert(0); // __hv_ln_f() not implemented
 #elif HV_SIMD_NEON
   hv_assert(0); // __hv_ln_f() not implemented
+#elif HV_SIMD_M33
+  *bOut = __HV_M33_LANES1(hv_ln_f, bIn);
 #else // HV_SIMD_NONE
   *bOut = hv_ln_f(bIn);
 #endif
@@ -841,6 +975,8 @@ static inline void __hv_log_f(hv_bInf_t bIn, hv_bOutf_t bOut) {
   hv_assert(0); // __hv_log_f() not implemented
 #elif HV_SIMD_NEON
   hv_assert(0); // __hv_log_f() not implemented
+#elif HV_SIMD_M33
+  *bOut = __HV_M33_LANES1(hv_log_f, bIn);
 #else // HV_SIMD_NONE
   *bOut = hv_log_f(bIn);
 #endif
@@ -853,6 +989,8 @@ static inline void __hv_log1p_f(hv_bInf_t bIn, hv_bOutf_t bOut) {
   hv_assert(0); // __hv_log1p_f() not implemented
 #elif HV_SIMD_NEON
   hv_assert(0); // __hv_log1p_f() not implemented
+#elif HV_SIMD_M33
+  *bOut = __HV_M33_LANES1(hv_log1p_f, bIn);
 #else // HV_SIMD_NONE
   *bOut = hv_log1p_f(bIn);
 #endif
@@ -865,6 +1003,8 @@ static inline void __hv_log10_f(hv_bInf_t bIn, hv_bOutf_t bOut) {
   hv_assert(0); // __hv_log10_f() not implemented
 #elif HV_SIMD_NEON
   hv_assert(0); // __hv_log10_f() not implemented
+#elif HV_SIMD_M33
+  *bOut = __HV_M33_LANES1(hv_log10_f, bIn);
 #else // HV_SIMD_NONE
   *bOut = hv_log10_f(bIn);
 #endif
@@ -877,6 +1017,8 @@ static inline void __hv_modf_f(hv_bInf_t bIn, hv_bOutf_t bOut) {
   hv_assert(0); // __hv_modf_f() not implemented
 #elif HV_SIMD_NEON
   hv_assert(0); // __hv_modf_f() not implemented
+#elif HV_SIMD_M33
+  *bOut = __HV_M33_LANES1(hv_modf_f, bIn);
 #else // HV_SIMD_NONE
   *bOut = hv_modf_f(bIn);
 #endif
@@ -889,6 +1031,12 @@ static inline void __hv_modulo_f(hv_bInf_t bIn0, hv_bInf_t bIn1, hv_bOutf_t bOut
   hv_assert(0); // __hv_modulo_f() not implemented
 #elif HV_SIMD_NEON
   hv_assert(0); // __hv_modulo_f() not implemented
+#elif HV_SIMD_M33
+  for (int i = 0; i < HV_N_SIMD; ++i) {
+    float modded = hv_fmod_f(bIn0[i], bIn1[i]);
+    if (modded < 0.0f) (*bOut)[i] = hv_rint_f(modded);
+    else if (modded >= 0.0f) (*bOut)[i] = hv_floor_f(modded);
+  }
 #else // HV_SIMD_NONE
   float modded = hv_fmod_f(bIn0, bIn1);
   if (modded < 0.0f) *bOut = hv_rint_f(modded);
@@ -903,6 +1051,10 @@ static inline void __hv_shl_f(hv_bInf_t bIn0, hv_bInf_t bIn1, hv_bOutf_t bOut) {
   hv_assert(0); // __hv_shl_f() not implemented
 #elif HV_SIMD_NEON
   hv_assert(0); // __hv_shl_f() not implemented
+#elif HV_SIMD_M33
+  for (int i = 0; i < HV_N_SIMD; ++i) {
+    (*bOut)[i] = (float) hv_shl_i((int) bIn0[i], (int) bIn1[i]);
+  }
 #else // HV_SIMD_NONE
   *bOut = (float) hv_shl_i((int) bIn0, (int) bIn1);
 #endif
@@ -915,6 +1067,10 @@ static inline void __hv_shr_f(hv_bInf_t bIn0, hv_bInf_t bIn1, hv_bOutf_t bOut) {
   hv_assert(0); // __hv_shr_f() not implemented
 #elif HV_SIMD_NEON
   hv_assert(0); // __hv_shr_f() not implemented
+#elif HV_SIMD_M33
+  for (int i = 0; i < HV_N_SIMD; ++i) {
+    (*bOut)[i] = (float) hv_shr_i((int) bIn0[i], (int) bIn1[i]);
+  }
 #else // HV_SIMD_NONE
   *bOut = (float) hv_shr_i((int) bIn0, (int) bIn1);
 #endif
@@ -927,6 +1083,8 @@ static inline void __hv_bit_and_f(hv_bInf_t bIn0, hv_bInf_t bIn1, hv_bOutf_t bOu
   hv_assert(0); // __hv_bit_and_f() not implemented
 #elif HV_SIMD_NEON
   hv_assert(0); // __hv_bit_and_f() not implemented
+#elif HV_SIMD_M33
+  *bOut = __builtin_convertvector(__builtin_convertvector(bIn0, hv_bufferi_t) & __builtin_convertvector(bIn1, hv_bufferi_t), hv_bufferf_t);
 #else // HV_SIMD_NONE
   *bOut = (float) ((int) bIn0 & (int) bIn1);
 #endif
@@ -939,6 +1097,8 @@ static inline void __hv_bit_or_f(hv_bInf_t bIn0, hv_bInf_t bIn1, hv_bOutf_t bOut
   hv_assert(0); // __hv_bit_or_f() not implemented
 #elif HV_SIMD_NEON
   hv_assert(0); // __hv_bit_or_f() not implemented
+#elif HV_SIMD_M33
+  *bOut = __builtin_convertvector(__builtin_convertvector(bIn0, hv_bufferi_t) | __builtin_convertvector(bIn1, hv_bufferi_t), hv_bufferf_t);
 #else // HV_SIMD_NONE
   *bOut = (float) ((int) bIn0 | (int) bIn1);
 #endif
@@ -951,6 +1111,8 @@ static inline void __hv_bit_not_f(hv_bInf_t bIn, hv_bOutf_t bOut) {
   hv_assert(0); // __hv_bit_not_f() not implemented
 #elif HV_SIMD_NEON
   hv_assert(0); // __hv_bit_not_f() not implemented
+#elif HV_SIMD_M33
+  *bOut = __builtin_convertvector(~__builtin_convertvector(bIn, hv_bufferi_t), hv_bufferf_t);
 #else // HV_SIMD_NONE
   *bOut = (float) hv_bit_not_i((int) bIn);
 #endif
@@ -963,6 +1125,8 @@ static inline void __hv_exc_or_f(hv_bInf_t bIn0, hv_bInf_t bIn1, hv_bOutf_t bOut
   hv_assert(0); // __hv_exc_or_f() not implemented
 #elif HV_SIMD_NEON
   hv_assert(0); // __hv_exc_or_f() not implemented
+#elif HV_SIMD_M33
+  *bOut = __builtin_convertvector(__builtin_convertvector(bIn0, hv_bufferi_t) ^ __builtin_convertvector(bIn1, hv_bufferi_t), hv_bufferf_t);
 #else // HV_SIMD_NONE
   *bOut = (float) ((int) bIn0 ^ (int) bIn1);
 #endif
@@ -975,6 +1139,10 @@ static inline void __hv_log_and_f(hv_bInf_t bIn0, hv_bInf_t bIn1, hv_bOutf_t bOu
   hv_assert(0); // __hv_log_and_f() not implemented
 #elif HV_SIMD_NEON
   hv_assert(0); // __hv_log_and_f() not implemented
+#elif HV_SIMD_M33
+  for (int i = 0; i < HV_N_SIMD; ++i) {
+    (*bOut)[i] = bIn0[i] && bIn1[i];
+  }
 #else // HV_SIMD_NONE
   *bOut = bIn0 && bIn1;
 #endif
@@ -987,6 +1155,10 @@ static inline void __hv_log_or_f(hv_bInf_t bIn0, hv_bInf_t bIn1, hv_bOutf_t bOut
   hv_assert(0); // __hv_log_or_f() not implemented
 #elif HV_SIMD_NEON
   hv_assert(0); // __hv_log_or_f() not implemented
+#elif HV_SIMD_M33
+  for (int i = 0; i < HV_N_SIMD; ++i) {
+    (*bOut)[i] = bIn0[i] || bIn1[i];
+  }
 #else // HV_SIMD_NONE
   *bOut = bIn0 || bIn1;
 #endif
@@ -999,6 +1171,8 @@ static inline void __hv_rint_f(hv_bInf_t bIn, hv_bOutf_t bOut) {
   hv_assert(0); // __hv_rint_f() not implemented
 #elif HV_SIMD_NEON
   hv_assert(0); // __hv_rint_f() not implemented
+#elif HV_SIMD_M33
+  *bOut = __HV_M33_LANES1(hv_rint_f, bIn);
 #else // HV_SIMD_NONE
   *bOut = hv_rint_f(bIn);
 #endif
@@ -1011,6 +1185,8 @@ static inline void __hv_round_f(hv_bInf_t bIn, hv_bOutf_t bOut) {
   hv_assert(0); // __hv_round_f() not implemented
 #elif HV_SIMD_NEON
   hv_assert(0); // __hv_round_f() not implemented
+#elif HV_SIMD_M33
+  *bOut = __HV_M33_LANES1(hv_round_f, bIn);
 #else // HV_SIMD_NONE
   *bOut = hv_round_f(bIn);
 #endif
@@ -1023,6 +1199,8 @@ static inline void __hv_if_f(hv_bInf_t bIn0, hv_bInf_t bIn1, hv_bInf_t bIn2, hv_
   hv_assert(0); // __hv_if_f() not implemented
 #elif HV_SIMD_NEON
   hv_assert(0); // __hv_if_f() not implemented
+#elif HV_SIMD_M33
+  *bOut = __HV_M33_LANES3(hv_if_f, bIn0, bIn1, bIn2);
 #else // HV_SIMD_NONE
   *bOut = hv_if_f(bIn0, bIn1, bIn2);
 #endif
@@ -1035,6 +1213,8 @@ static inline void __hv_isinf_f(hv_bInf_t bIn0, hv_bOutf_t bOut) {
   hv_assert(0); // __hv_isinf_f() not implemented
 #elif HV_SIMD_NEON
   hv_assert(0); // __hv_isinf_f() not implemented
+#elif HV_SIMD_M33
+  *bOut = __HV_M33_LANES1(hv_isinf_f, bIn0);
 #else // HV_SIMD_NONE
   *bOut = hv_isinf_f(bIn0);
 #endif
@@ -1047,6 +1227,8 @@ static inline void __hv_finite_f(hv_bInf_t bIn0, hv_bOutf_t bOut) {
   hv_assert(0); // __hv_finite_f() not implemented
 #elif HV_SIMD_NEON
   hv_assert(0); // __hv_finite_f() not implemented
+#elif HV_SIMD_M33
+  *bOut = __HV_M33_LANES1(hv_finite_f, bIn0);
 #else // HV_SIMD_NONE
   *bOut = hv_finite_f(bIn0);
 #endif
@@ -1059,6 +1241,8 @@ static inline void __hv_isnan_f(hv_bInf_t bIn0, hv_bOutf_t bOut) {
   hv_assert(0); // __hv_isnan_f() not implemented
 #elif HV_SIMD_NEON
   hv_assert(0); // __hv_isnan_f() not implemented
+#elif HV_SIMD_M33
+  *bOut = __HV_M33_LANES1(hv_isnan_f, bIn0);
 #else // HV_SIMD_NONE
   *bOut = hv_isnan_f(bIn0);
 #endif
@@ -1071,6 +1255,8 @@ static inline void __hv_copysign_f(hv_bInf_t bIn0, hv_bInf_t bIn1, hv_bOutf_t bO
   hv_assert(0); // __hv_copysign_f() not implemented
 #elif HV_SIMD_NEON
   hv_assert(0); // __hv_copysign_f() not implemented
+#elif HV_SIMD_M33
+  *bOut = __HV_M33_LANES2(hv_copysign_f, bIn0, bIn1);
 #else // HV_SIMD_NONE
   *bOut = hv_copysign_f(bIn0, bIn1);
 #endif
@@ -1083,6 +1269,12 @@ static inline void __hv_imod_f(hv_bInf_t bIn0, hv_bOutf_t bOut) {
   hv_assert(0); // __hv_imod_f() not implemented
 #elif HV_SIMD_NEON
   hv_assert(0); // __hv_imod_f() not implemented
+#elif HV_SIMD_M33
+  for (int i = 0; i < HV_N_SIMD; ++i) {
+    float iptr;
+    modff(bIn0[i], &iptr);
+    (*bOut)[i] = iptr;
+  }
 #else // HV_SIMD_NONE
   float iptr;
   modff(bIn0, &iptr);
@@ -1097,6 +1289,8 @@ static inline void __hv_remainder_f(hv_bInf_t bIn0, hv_bInf_t bIn1, hv_bOutf_t b
   hv_assert(0); // __hv_remainder_f() not implemented
 #elif HV_SIMD_NEON
   hv_assert(0); // __hv_remainder_f() not implemented
+#elif HV_SIMD_M33
+  *bOut = __HV_M33_LANES2(hv_remainder_f, bIn0, bIn1);
 #else // HV_SIMD_NONE
   *bOut = hv_remainder_f(bIn0, bIn1);
 #endif
@@ -1109,6 +1303,8 @@ static inline void __hv_fmod_f(hv_bInf_t bIn0, hv_bInf_t bIn1, hv_bOutf_t bOut)
   hv_assert(0); // __hv_fmod_f() not implemented
 #elif HV_SIMD_NEON
   hv_assert(0); // __hv_fmod_f() not implemented
+#elif HV_SIMD_M33
+  *bOut = __HV_M33_LANES2(hv_fmod_f, bIn0, bIn1);
 #else // HV_SIMD_NONE
   *bOut = hv_fmod_f(bIn0, bIn1);
 #endif
@@ -1121,6 +1317,19 @@ static inline void __hv_fact_f(hv_bInf_t bIn0, hv_bOutf_t bOut) {
   hv_assert(0); // __hv_fact_f() not implemented
 #elif HV_SIMD_NEON
   hv_assert(0); // __hv_fact_f() not implemented
+#elif HV_SIMD_M33
+  for (int i = 0; i < HV_N_SIMD; ++i) {
+    int n = (int) bIn0[i];
+    if (n <= 1) (*bOut)[i] = 1; // follow Pure data convention
+    else if (n > 34) (*bOut)[i] = INFINITY; // follow Pure data convention
+    else {
+      float f = 1.0f;
+      for (int j = n; j > 1; --j) {
+        f *= j;
+      }
+      (*bOut)[i] = f;
+    }
+  }
 #else // HV_SIMD_NONE
   int n = (int) bIn0;
   if(n <= 1) {
@@ -1148,6 +1357,8 @@ static inline void __hv_ldexp_f(hv_bInf_t bIn0, hv_bInf_t bIn1, hv_bOutf_t bOut)
   hv_assert(0); // __hv_ldexp_f() not implemented
 #elif HV_SIMD_NEON
   hv_assert(0); // __hv_ldexp_f() not implemented
+#elif HV_SIMD_M33
+  *bOut = __HV_M33_LANES2(hv_ldexp_f, bIn0, bIn1);
 #else // HV_SIMD_NONE
   *bOut = hv_ldexp_f(bIn0, bIn1);
 #endif
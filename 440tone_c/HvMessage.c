@@ -16,14 +16,14 @@
 
 #include "HvMessage.h"
 
-HvMessage *msg_init(HvMessage *m, hv_size_t numElements, hv_uint32_t timestamp) {
+HvMessage *HV_HOT(msg_init)(HvMessage *m, hv_size_t numElements, hv_uint32_t timestamp) {
   m->timestamp = timestamp;
   m->numElements = (hv_uint16_t) numElements;
   m->numBytes = (hv_uint16_t) msg_getCoreSize(numElements);
   return m;
 }
 
-HvMessage *msg_initWithFloat(HvMessage *m, hv_uint32_t timestamp, float f) {
+HvMessage *HV_HOT(msg_initWithFloat)(HvMessage *m, hv_uint32_t timestamp, float f) {
   m->timestamp = timestamp;
   m->numElements = 1;
   m->numBytes = sizeof(HvMessage);
@@ -31,7 +31,7 @@ HvMessage *msg_initWithFloat(HvMessage *m, hv_uint32_t timestamp, float f) {
   return m;
 }
 
-HvMessage *msg_initWithBang(HvMessage *m, hv_uint32_t timestamp) {
+HvMessage *HV_HOT(msg_initWithBang)(HvMessage *m, hv_uint32_t timestamp) {
   m->timestamp = timestamp;
   m->numElements = 1;
   m->numBytes = sizeof(HvMessage);
@@ -44,16 +44,17 @@ static char *ml_pop(HvMessagePoolList *ml) {
 }
 
 /** Push a MessageListNode with the given pointer onto the head of the queue. */
-static void ml_push(HvMessagePoolList *ml, void *p) {
+static void ml_push(HvMessagePool *mp, HvMessagePoolList *ml, void *p) {
   MessageListNode *n = NULL;
   if (ml->pool != NULL) {
     // take an empty MessageListNode from the pool
     n = ml->pool;
     ml->pool = n->next;
   } else {
-    // a MessageListNode is not available, allocate one
-    n = (MessageListNode *) hv_malloc(sizeof(MessageListNode));
+    // a MessageListNode is not available, take one of the nodes reserved in mp_init()
+    n = mp->spareNodes;
     hv_assert(n != NULL);
+    mp->spareNodes = n->next;
   }
   n->p = (char *) p;
   n->next = ml->head;
@@ -62,14 +63,9 @@ static void ml_push(HvMessagePoolList *ml, void *p) {
 
 static void ml_free(HvMessagePoolList *ml) {
   if (ml != NULL) {
-    while (ml_hasAvailable(ml)) {
-      ml_pop(ml);
-    }
-    while (ml->pool != NULL) {
-      MessageListNode *n = ml->pool;
-      ml->pool = n->next;
-      hv_free(n);
-    }
+    // the nodes themselves belong to the HvMessagePool node array
+    ml->head = NULL;
+    ml->pool = NULL;
   }
 }
 
@@ -87,29 +83,42 @@ hv_size_t mp_init(HvMessagePool *mp, hv_size_t numKB) {
   hv_assert(mp->buffer != NULL);
   mp->bufferIndex = 0;
 
+  // Reserve every MessageListNode the pool can ever need, so that no allocation happens
+  // once messages are flowing: each node points at one chunk, and chunks are at least 32 bytes.
+  const hv_size_t numNodes = mp->bufferSize / 32;
+  mp->nodes = (MessageListNode *) hv_malloc(numNodes * sizeof(MessageListNode));
+  hv_assert(mp->nodes != NULL);
+  for (hv_size_t i = 0; i < numNodes; i++) {
+    mp->nodes[i].p = NULL;
+    mp->nodes[i].next = (i+1 < numNodes) ? &mp->nodes[i+1] : NULL;
+  }
+  mp->spareNodes = mp->nodes;
+
   // initialise all message lists
   for (int i = 0; i < MP_NUM_MESSAGE_LISTS; i++) {
     mp->lists[i].head = NULL;
     mp->lists[i].pool = NULL;
   }
 
-  return mp->bufferSize;
+  return mp->bufferSize + numNodes * sizeof(MessageListNode);
 }
 
 void mp_free(HvMessagePool *mp) {
-  hv_free(mp->buffer);
   for (int i = 0; i < MP_NUM_MESSAGE_LISTS; i++) {
     ml_free(&mp->lists[i]);
   }
+  mp->spareNodes = NULL;
+  hv_free(mp->nodes);
+  hv_free(mp->buffer);
 }
 
-void mp_freeMessage(HvMessagePool *mp, HvMessage *m) {
+void HV_HOT(mp_freeMessage)(HvMessagePool *mp, HvMessage *m) {
   const hv_size_t b = msg_getSize(m); // the number of bytes that a message occupies in memory
   const hv_size_t i = mp_messagelistIndexForSize(b); // the HvMessagePoolList index in the pool
   HvMessagePoolList *ml = &mp->lists[i];
   const hv_size_t chunkSize = 32 << i;
   hv_memclear(m, chunkSize); // clear the chunk, just in case
-  ml_push(ml, m);
+  ml_push(mp, ml, m);
 }
 
 HvMessage *mp_addMessage(HvMessagePool *mp, const HvMessage *m) {
@@ -134,7 +143,7 @@ HvMessage *mp_addMessage(HvMessagePool *mp, const HvMessage *m) {
         "Try using the new_with_options() initialiser with a larger pool size (default is 10KB).");
 
     for (hv_size_t j = mp->bufferIndex; j < newIndex; j += chunkSize) {
-      ml_push(ml, mp->buffer + j); // push new nodes onto the list with chunk pointers
+      ml_push(mp, ml, mp->buffer + j); // push new nodes onto the list with chunk pointers
     }
     mp->bufferIndex = newIndex;
     char *buf = ml_pop(ml);
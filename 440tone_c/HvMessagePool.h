@@ -38,6 +38,8 @@ typedef struct HvMessagePool {
   char *buffer; // the buffer of all messages
   hv_size_t bufferSize; // in bytes
   hv_size_t bufferIndex; // the number of total reserved bytes
+  struct MessageListNode *nodes; // all list nodes, reserved at initialisation
+  struct MessageListNode *spareNodes; // list of nodes not yet handed to a HvMessagePoolList
 
   HvMessagePoolList lists[MP_NUM_MESSAGE_LISTS];
 } HvMessagePool;
@@ -49,6 +51,9 @@ typedef struct HvMessagePool {
  * An MPL is a linked-list data structure which is initialised such that its own pool of listnodes is filled with nodes
  * that point at each subblock (e.g. each 32-byte block of a 512-block chunk).
  *
+ * All MessageListNodes are reserved at initialisation (one per 32-byte chunk of the buffer), so adding
+ * and freeing messages never allocates.
+ *
  * HvMessagePool is loosely inspired by TCMalloc. http://goog-perftools.sourceforge.net/doc/tcmalloc.html
  */
 
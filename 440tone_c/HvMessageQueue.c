@@ -16,31 +16,196 @@
 
 #include "HvMessageQueue.h"
 
+#if HV_MQ_HEAP
+
+// every message starts on a 32-byte boundary of the pool buffer, which identifies its node
+#define MQ_NODE_FOR_MESSAGE(_q, _m) (&(_q)->nodes[((char *) (_m) - (_q)->mp.buffer) >> 5])
+
+static inline bool mq_heap_before(const MessageNode *a, const MessageNode *b) {
+  const hv_uint32_t ta = msg_getTimestamp(a->m);
+  const hv_uint32_t tb = msg_getTimestamp(b->m);
+  return (ta < tb) || ((ta == tb) && ((hv_int32_t) (a->order - b->order) < 0));
+}
+
+static inline void mq_heap_place(HvMessageQueue *q, MessageNode *n, hv_uint32_t i) {
+  q->heap[i] = n;
+  n->index = i;
+}
+
+static void HV_HOT(mq_heap_siftUp)(HvMessageQueue *q, hv_uint32_t i) {
+  MessageNode *const n = q->heap[i];
+  while (i > 0) {
+    const hv_uint32_t parent = (i - 1) >> 1;
+    if (!mq_heap_before(n, q->heap[parent])) break;
+    mq_heap_place(q, q->heap[parent], i);
+    i = parent;
+  }
+  mq_heap_place(q, n, i);
+}
+
+static void HV_HOT(mq_heap_siftDown)(HvMessageQueue *q, hv_uint32_t i) {
+  MessageNode *const n = q->heap[i];
+  while (true) {
+    hv_uint32_t child = 2*i + 1;
+    if (child >= q->size) break;
+    if ((child + 1 < q->size) && mq_heap_before(q->heap[child+1], q->heap[child])) ++child;
+    if (!mq_heap_before(q->heap[child], n)) break;
+    mq_heap_place(q, q->heap[child], i);
+    i = child;
+  }
+  mq_heap_place(q, n, i);
+}
+
+static void HV_HOT(mq_heap_releaseNode)(HvMessageQueue *q, MessageNode *n) {
+  mp_freeMessage(&q->mp, n->m);
+  n->m = NULL;
+  n->let = 0;
+  n->sendMessage = NULL;
+}
+
+/** Remove the node at heap position i (and free its message). */
+static void HV_HOT(mq_heap_removeAt)(HvMessageQueue *q, hv_uint32_t i) {
+  mq_heap_releaseNode(q, q->heap[i]);
+  --q->size;
+  if (i < q->size) {
+    // move the last node into the hole, then restore the heap in whichever direction it is out of order
+    mq_heap_place(q, q->heap[q->size], i);
+    if ((i > 0) && mq_heap_before(q->heap[i], q->heap[(i - 1) >> 1])) {
+      mq_heap_siftUp(q, i);
+    } else {
+      mq_heap_siftDown(q, i);
+    }
+  }
+  q->head = (q->size > 0) ? q->heap[0] : NULL;
+}
+
 hv_size_t mq_initWithPoolSize(HvMessageQueue *q, hv_size_t poolSizeKB) {
   hv_assert(poolSizeKB > 0);
   q->head = NULL;
-  q->tail = NULL;
-  q->pool = NULL;
-  return mp_init(&q->mp, poolSizeKB);
+  q->size = 0;
+  q->order = 0;
+  const hv_size_t poolBytes = mp_init(&q->mp, poolSizeKB);
+
+  // one node and one heap entry per 32-byte chunk of the message pool
+  const hv_size_t numNodes = (poolSizeKB * 1024) / 32;
+  q->nodes = (MessageNode *) hv_malloc(numNodes * sizeof(MessageNode));
+  hv_assert(q->nodes != NULL);
+  q->heap = (MessageNode **) hv_malloc(numNodes * sizeof(MessageNode *));
+  hv_assert(q->heap != NULL);
+  for (hv_size_t i = 0; i < numNodes; i++) {
+    q->nodes[i].m = NULL;
+    q->nodes[i].sendMessage = NULL;
+    q->nodes[i].let = 0;
+  }
+  return poolBytes + numNodes * (sizeof(MessageNode) + sizeof(MessageNode *));
 }
 
 void mq_free(HvMessageQueue *q) {
   mq_clear(q);
-  while (q->pool != NULL) {
-    MessageNode *n = q->pool;
-    q->pool = q->pool->next;
-    hv_free(n);
+  hv_free(q->heap);
+  hv_free(q->nodes);
+  mp_free(&q->mp);
+}
+
+int mq_size(HvMessageQueue *q) {
+  return (int) q->size;
+}
+
+HvMessage *mq_addMessage(HvMessageQueue *q, const HvMessage *m, int let,
+    void (*sendMessage)(HeavyContextInterface *, int, const HvMessage *)) {
+  HvMessage *const msg = mp_addMessage(&q->mp, m);
+  MessageNode *const n = MQ_NODE_FOR_MESSAGE(q, msg);
+  n->m = msg;
+  n->let = let;
+  n->sendMessage = sendMessage;
+  n->order = q->order++;
+
+  mq_heap_place(q, n, q->size++);
+  mq_heap_siftUp(q, n->index);
+  q->head = q->heap[0];
+  return msg;
+}
+
+HvMessage *mq_addMessageByTimestamp(HvMessageQueue *q, const HvMessage *m, int let,
+    void (*sendMessage)(HeavyContextInterface *, int, const HvMessage *)) {
+  return mq_addMessage(q, m, let, sendMessage);
+}
+
+void HV_HOT(mq_pop)(HvMessageQueue *q) {
+  if (mq_hasMessage(q)) {
+    mq_heap_removeAt(q, 0);
+  }
+}
+
+bool mq_removeMessage(HvMessageQueue *q, HvMessage *m, void (*sendMessage)(HeavyContextInterface *, int, const HvMessage *)) {
+  // only messages stored in this queue's pool can be in the queue
+  if (m == NULL || (char *) m < q->mp.buffer || (char *) m >= q->mp.buffer + q->mp.bufferIndex) return false;
+  MessageNode *const n = MQ_NODE_FOR_MESSAGE(q, m);
+  // only remove the message if sendMessage is the same as the stored one,
+  // if the sendMessage argument is NULL, it is not checked and will remove any matching message pointer
+  if ((n->m == m) && (sendMessage == NULL || n->sendMessage == sendMessage)) {
+    mq_heap_removeAt(q, n->index);
+    return true;
+  }
+  return false;
+}
+
+void mq_clear(HvMessageQueue *q) {
+  for (hv_uint32_t i = 0; i < q->size; i++) {
+    mq_heap_releaseNode(q, q->heap[i]);
+  }
+  q->size = 0;
+  q->head = NULL;
+}
+
+void mq_clearAfter(HvMessageQueue *q, const hv_uint32_t timestamp) {
+  // drop the matching nodes in one pass, then rebuild the heap bottom-up in O(n)
+  hv_uint32_t j = 0;
+  for (hv_uint32_t i = 0; i < q->size; i++) {
+    MessageNode *const n = q->heap[i];
+    if (timestamp <= msg_getTimestamp(n->m)) {
+      mq_heap_releaseNode(q, n);
+    } else {
+      mq_heap_place(q, n, j++);
+    }
+  }
+  q->size = j;
+  for (hv_uint32_t i = q->size / 2; i > 0; i--) {
+    mq_heap_siftDown(q, i - 1);
+  }
+  q->head = (q->size > 0) ? q->heap[0] : NULL;
+}
+
+#else // sorted doubly linked list
+
+hv_size_t mq_initWithPoolSize(HvMessageQueue *q, hv_size_t poolSizeKB) {
+  hv_assert(poolSizeKB > 0);
+  q->head = NULL;
+  q->tail = NULL;
+  const hv_size_t poolBytes = mp_init(&q->mp, poolSizeKB);
+
+  // Reserve one node per message the pool can hold (messages take at least 32 bytes),
+  // so scheduling a message never allocates.
+  const hv_size_t numNodes = (poolSizeKB * 1024) / 32;
+  q->nodes = (MessageNode *) hv_malloc(numNodes * sizeof(MessageNode));
+  hv_assert(q->nodes != NULL);
+  for (hv_size_t i = 0; i < numNodes; i++) {
+    q->nodes[i].next = (i+1 < numNodes) ? &q->nodes[i+1] : NULL;
   }
+  q->pool = q->nodes;
+  return poolBytes + numNodes * sizeof(MessageNode);
+}
+
+void mq_free(HvMessageQueue *q) {
+  mq_clear(q);
+  q->pool = NULL;
+  hv_free(q->nodes);
   mp_free(&q->mp);
 }
 
 static MessageNode *mq_getOrCreateNodeFromPool(HvMessageQueue *q) {
-  if (q->pool == NULL) {
-    // if necessary, create a new empty node
-    q->pool = (MessageNode *) hv_malloc(sizeof(MessageNode));
-    hv_assert(q->pool != NULL);
-    q->pool->next = NULL;
-  }
+  // one node per 32-byte pool chunk, so the reserve cannot run out before the message pool does
+  hv_assert(q->pool != NULL);
   MessageNode *node = q->pool;
   q->pool = q->pool->next;
   return node;
@@ -121,7 +286,7 @@ HvMessage *mq_addMessageByTimestamp(HvMessageQueue *q, const HvMessage *m, int l
   }
 }
 
-void mq_pop(HvMessageQueue *q) {
+void HV_HOT(mq_pop)(HvMessageQueue *q) {
   if (mq_hasMessage(q)) {
     MessageNode *n = q->head;
 
@@ -212,4 +377,7 @@ void mq_clearAfter(HvMessageQueue *q, const hv_uint32_t timestamp) {
   }
 
   if (q->tail == NULL) q->head = NULL;
+  else q->tail->next = NULL; // the removed nodes now belong to the pool
 }
+
+#endif // HV_MQ_HEAP
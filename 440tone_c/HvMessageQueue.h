@@ -30,21 +30,48 @@ class HeavyContextInterface;
 typedef struct HeavyContextInterface HeavyContextInterface;
 #endif
 
+// 1 = the queue is a binary min-heap (O(log n) insert and remove), 0 = sorted linked list
+#ifndef HV_MQ_HEAP
+#define HV_MQ_HEAP 0
+#endif
+
 typedef struct MessageNode {
+#if HV_MQ_HEAP
+  hv_uint32_t order; // insertion sequence, keeps messages with equal timestamps in FIFO order
+  hv_uint32_t index; // position in the heap
+#else
   struct MessageNode *prev; // doubly linked list
   struct MessageNode *next;
+#endif
   HvMessage *m;
   void (*sendMessage)(HeavyContextInterface *, int, const HvMessage *);
   int let;
 } MessageNode;
 
+#if HV_MQ_HEAP
+/**
+ * A binary min-heap of scheduled messages, ordered by timestamp and then by insertion.
+ * Each message owns the node at the index of its 32-byte chunk in the message pool, so
+ * a message is found in O(1) and inserted or removed in O(log n).
+ */
+typedef struct HvMessageQueue {
+  MessageNode *head; // the earliest message (heap root), NULL if empty
+  MessageNode **heap; // the heap array
+  hv_uint32_t size; // number of messages in the heap
+  hv_uint32_t order; // insertion sequence of the next message
+  MessageNode *nodes; // all nodes, reserved at initialisation
+  HvMessagePool mp;
+} HvMessageQueue;
+#else
 /** A doubly linked list containing scheduled messages. */
 typedef struct HvMessageQueue {
   MessageNode *head; // the head of the queue
   MessageNode *tail; // the tail of the queue
   MessageNode *pool; // the head of the reserve pool
+  MessageNode *nodes; // all nodes, reserved at initialisation
   HvMessagePool mp;
 } HvMessageQueue;
+#endif
 
 hv_size_t mq_initWithPoolSize(HvMessageQueue *q, hv_size_t poolSizeKB);
 
@@ -73,7 +100,10 @@ static inline MessageNode *mq_peek(HvMessageQueue *q) {
   return q->head;
 }
 
-/** Appends the message to the end of the queue. */
+/**
+ * Appends the message to the end of the queue. With HV_MQ_HEAP the queue is always in
+ * timestamp order, so this is the same as mq_addMessageByTimestamp().
+ */
 HvMessage *mq_addMessage(HvMessageQueue *q, const HvMessage *m, int let,
     void (*sendMessage)(HeavyContextInterface *, int, const HvMessage *));
 
@@ -0,0 +1,139 @@
+/**
+ * @file HvParameterBlock.c
+ * @brief Double-buffered parameter values, applied once per block with optional linear ramps
+ * @author Ale Moglia
+ * @date 2026
+ */
+
+#include "HvParameterBlock.h"
+
+#if HV_WIN
+#include <intrin.h>
+#define hPb_load(_p) (*((volatile hv_uint32_t *) (_p)))
+#define hPb_store(_p, _x) (*((volatile hv_uint32_t *) (_p)) = (_x))
+#define hPb_fetchAdd(_p, _x) ((hv_uint32_t) _InterlockedExchangeAdd((volatile long *) (_p), (long) (_x)))
+#define hPb_fetchSub(_p, _x) ((hv_uint32_t) _InterlockedExchangeAdd((volatile long *) (_p), -(long) (_x)))
+#define hPb_fetchOr(_p, _x) ((hv_uint32_t) _InterlockedOr((volatile long *) (_p), (long) (_x)))
+#define hPb_compareExchange(_p, _expected, _desired) \
+    (_InterlockedCompareExchange((volatile long *) (_p), (long) (_desired), (long) (_expected)) == (long) (_expected))
+static inline hv_uint32_t hPb_ctz(hv_uint32_t x) { unsigned long i; _BitScanForward(&i, x); return (hv_uint32_t) i; }
+#else
+#define hPb_load(_p) __atomic_load_n(_p, __ATOMIC_RELAXED)
+#define hPb_store(_p, _x) __atomic_store_n(_p, _x, __ATOMIC_RELAXED)
+// entering a write acquires the slots the audio thread cleared, leaving it releases the new values
+#define hPb_fetchAdd(_p, _x) __atomic_fetch_add(_p, _x, __ATOMIC_ACQUIRE)
+#define hPb_fetchSub(_p, _x) __atomic_fetch_sub(_p, _x, __ATOMIC_RELEASE)
+#define hPb_fetchOr(_p, _x) __atomic_fetch_or(_p, _x, __ATOMIC_RELAXED)
+#define hPb_compareExchange(_p, _expected, _desired) \
+    __extension__ ({ hv_uint32_t _e = (_expected); \
+        __atomic_compare_exchange_n(_p, &_e, _desired, false, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED); })
+#define hPb_ctz(_x) ((hv_uint32_t) __builtin_ctz(_x))
+#endif
+
+#define HPB_WRITER 2 // one sender inside hPb_set(), in units of state
+
+hv_size_t hPb_init(HvParameterBlock *o, hv_uint32_t numParams) {
+  o->numParams = numParams;
+  o->numWords = (numParams + 31) >> 5;
+  o->state = 0;
+  if (numParams == 0) {
+    o->pending[0] = o->pending[1] = NULL;
+    o->dirty[0] = o->dirty[1] = NULL;
+    o->rampSamples = o->hashes = o->remaining = o->changed = NULL;
+    o->value = o->blockStart = o->target = o->step = NULL;
+    return 0;
+  }
+
+  // one allocation, carved into the slot arrays (all 4-byte elements)
+  const hv_size_t numBytes = (6*numParams + 4*numParams + 2*o->numWords) * sizeof(hv_uint32_t);
+  hv_uint32_t *p = (hv_uint32_t *) hv_malloc(numBytes);
+  hv_assert(p != NULL);
+  hv_memclear(p, numBytes);
+  o->pending[0] = (float *) p; p += numParams;
+  o->pending[1] = (float *) p; p += numParams;
+  o->value = (float *) p; p += numParams;
+  o->blockStart = (float *) p; p += numParams;
+  o->target = (float *) p; p += numParams;
+  o->step = (float *) p; p += numParams;
+  o->rampSamples = p; p += numParams;
+  o->hashes = p; p += numParams;
+  o->remaining = p; p += numParams;
+  o->changed = p; p += numParams;
+  o->dirty[0] = p; p += o->numWords;
+  o->dirty[1] = p;
+  return numBytes;
+}
+
+void hPb_free(HvParameterBlock *o) {
+  hv_free(o->pending[0]);
+}
+
+void hPb_setDefault(HvParameterBlock *o, hv_uint32_t index, hv_uint32_t hash, float x) {
+  hv_assert(index < o->numParams);
+  o->hashes[index] = hash;
+  o->value[index] = o->blockStart[index] = o->target[index] = x;
+}
+
+bool HV_HOT(hPb_set)(HvParameterBlock *o, hv_uint32_t index, hv_uint32_t count, const float *x) {
+  if (index >= o->numParams || count > o->numParams - index) return false;
+
+  const hv_uint32_t b = hPb_fetchAdd(&o->state, HPB_WRITER) & 1;
+  float *const pending = o->pending[b];
+  hv_uint32_t *const dirty = o->dirty[b];
+  for (hv_uint32_t i = index; i < index + count; ++i) {
+    pending[i] = *x++;
+    hPb_fetchOr(&dirty[i >> 5], 1u << (i & 31));
+  }
+  hPb_fetchSub(&o->state, HPB_WRITER);
+  return true;
+}
+
+void hPb_setSmoothing(HvParameterBlock *o, hv_uint32_t index, hv_uint32_t numSamples) {
+  if (index < o->numParams) hPb_store(&o->rampSamples[index], numSamples);
+}
+
+hv_uint32_t HV_HOT(hPb_update)(HvParameterBlock *o, hv_uint32_t n) {
+  if (o->numParams == 0) return 0;
+  hv_uint32_t numChanged = 0;
+
+  // take the buffer the senders have been writing, unless one of them is inside hPb_set()
+  const hv_uint32_t s = hPb_load(&o->state);
+  if (s < HPB_WRITER && hPb_compareExchange(&o->state, s, s ^ 1)) {
+    const float *const pending = o->pending[s & 1];
+    hv_uint32_t *const dirty = o->dirty[s & 1];
+    for (hv_uint32_t w = 0; w < o->numWords; ++w) {
+      hv_uint32_t m = dirty[w];
+      dirty[w] = 0;
+      while (m != 0) {
+        const hv_uint32_t i = (w << 5) + hPb_ctz(m);
+        m &= m - 1;
+        const hv_uint32_t ramp = hPb_load(&o->rampSamples[i]);
+        o->target[i] = pending[i];
+        if (ramp == 0) {
+          o->value[i] = pending[i];
+          o->remaining[i] = 0;
+          o->changed[numChanged++] = i;
+        } else {
+          o->step[i] = (pending[i] - o->value[i]) / (float) ramp;
+          o->remaining[i] = ramp;
+        }
+      }
+    }
+  }
+
+  // jumps are flat across the block, ramps move by n samples (the last block lands on the target)
+  for (hv_uint32_t i = 0; i < o->numParams; ++i) {
+    o->blockStart[i] = o->value[i];
+    if (o->remaining[i] > 0) {
+      if (o->remaining[i] <= n) {
+        o->value[i] = o->target[i];
+        o->remaining[i] = 0;
+      } else {
+        o->value[i] += o->step[i] * (float) n;
+        o->remaining[i] -= n;
+      }
+      o->changed[numChanged++] = i;
+    }
+  }
+  return numChanged;
+}
@@ -0,0 +1,95 @@
+/**
+ * @file HvParameterBlock.h
+ * @brief Double-buffered parameter values, applied once per block with optional linear ramps
+ * @author Ale Moglia
+ * @date 2026
+ *
+ * Each parameter listed by getParameterInfo() has one float slot in each of two buffers.
+ * Senders write the latest value into the current write buffer and set its dirty bit, and
+ * nothing is queued. So a parameter that changes many times within a block is delivered
+ * once, with its last value. At the start of process(), hPb_update() flips the buffers with
+ * one compare-and-swap and collects the dirty slots of the buffer the senders just left.
+ * The work per block therefore grows with the number of parameters, not with the number of
+ * messages.
+ *
+ * The flip only happens while no sender is inside hPb_set(), and a whole hPb_set() call
+ * lands in the same block. If a sender is busy, the flip moves to the next block.
+ *
+ * A parameter with a smoothing time ramps linearly to each new value, and the ramp slope is
+ * constant per sample. hPb_getBlockStart() and hPb_getValue() give the ramp at the edges of
+ * the current block, for DSP code that applies it per sample.
+ */
+
+#ifndef _HEAVY_PARAMETER_BLOCK_H_
+#define _HEAVY_PARAMETER_BLOCK_H_
+
+#include "HvUtils.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct HvParameterBlock {
+  hv_uint32_t numParams;
+  hv_uint32_t numWords;     // dirty mask words per buffer
+  hv_uint32_t state;        // bit 0: buffer the senders write, bits 1+: senders inside hPb_set() (x2)
+  float *pending[2];        // [numParams] latest sent value in each buffer
+  hv_uint32_t *dirty[2];    // [numWords] slots written since the buffer was last collected
+  hv_uint32_t *rampSamples; // [numParams] smoothing length in samples, 0 = jump
+
+  // audio thread only
+  hv_uint32_t *hashes;      // [numParams] receiver hash of each parameter
+  float *value;             // [numParams] value at the end of the current block
+  float *blockStart;        // [numParams] value at the start of the current block
+  float *target;            // [numParams] last collected value
+  float *step;              // [numParams] per-sample ramp increment
+  hv_uint32_t *remaining;   // [numParams] samples left on the ramp
+  hv_uint32_t *changed;     // [numParams] indices whose value moved in the current block
+} HvParameterBlock;
+
+/**
+ * Allocates the buffers for numParams parameters, all at 0.
+ * @return  The number of bytes allocated.
+ */
+hv_size_t hPb_init(HvParameterBlock *o, hv_uint32_t numParams);
+
+void hPb_free(HvParameterBlock *o);
+
+/** Sets a parameter's starting value without a ramp or a delivery. Audio thread, before processing. */
+void hPb_setDefault(HvParameterBlock *o, hv_uint32_t index, hv_uint32_t hash, float x);
+
+/**
+ * Writes count consecutive parameters, starting at index, into the current write buffer.
+ * Lock-free and safe from any thread; values sent to the same slot from several threads
+ * at once race, the last writer does not necessarily win.
+ *
+ * @return  False if the range is outside the parameter list.
+ */
+bool hPb_set(HvParameterBlock *o, hv_uint32_t index, hv_uint32_t count, const float *x);
+
+/** Sets the ramp length used for the parameter's next value, 0 = jump. Safe from any thread. */
+void hPb_setSmoothing(HvParameterBlock *o, hv_uint32_t index, hv_uint32_t numSamples);
+
+/**
+ * Collects the values sent since the last call and advances every ramp by n samples.
+ * Audio thread, once per block.
+ *
+ * @return  The number of entries written to o->changed.
+ */
+hv_uint32_t hPb_update(HvParameterBlock *o, hv_uint32_t n);
+
+/** Parameter value at the end of the current block. */
+static inline float hPb_getValue(const HvParameterBlock *o, hv_uint32_t index) {
+  return o->value[index];
+}
+
+/** Parameter value at the start of the current block (equal to hPb_getValue() unless ramping). */
+static inline float hPb_getBlockStart(const HvParameterBlock *o, hv_uint32_t index) {
+  return o->blockStart[index];
+}
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // _HEAVY_PARAMETER_BLOCK_H_
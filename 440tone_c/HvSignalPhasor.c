@@ -27,6 +27,9 @@ static void sPhasor_updatePhase(SignalPhasor *o, float p) {
 #elif HV_SIMD_NEON
   static void sPhasor_updatePhase(SignalPhasor *o, hv_uint32_t p) {
     o->phase =  vdupq_n_u32(p);
+#elif HV_SIMD_M33
+  static void sPhasor_updatePhase(SignalPhasor *o, hv_uint32_t p) {
+    o->phase = (hv_m33u_t) {p, p, p, p};
 #else // HV_SIMD_NONE
   static void sPhasor_updatePhase(SignalPhasor *o, hv_uint32_t p) {
     o->phase = p;
@@ -51,6 +54,9 @@ static void sPhasor_k_updatePhase(SignalPhasor *o, hv_uint32_t p) {
 #elif HV_SIMD_NEON
 static void sPhasor_k_updatePhase(SignalPhasor *o, hv_uint32_t p) {
   o->phase = (uint32x4_t) {p, o->step.s+p, 2*o->step.s+p, 3*o->step.s+p};
+#elif HV_SIMD_M33
+static void sPhasor_k_updatePhase(SignalPhasor *o, hv_uint32_t p) {
+  o->phase = (hv_m33u_t) {p, o->step.s+p, 2*o->step.s+p, 3*o->step.s+p};
 #else // HV_SIMD_NONE
 static void sPhasor_k_updatePhase(SignalPhasor *o, hv_uint32_t p) {
   o->phase = p;
@@ -71,6 +77,10 @@ static void sPhasor_k_updateFrequency(SignalPhasor *o, float f, double r) {
   o->step.s = (hv_int32_t) (f*(HV_PHASOR_2_32/r));
   o->inc = vdupq_n_s32(4*o->step.s);
   sPhasor_k_updatePhase(o, vgetq_lane_u32(o->phase, 0));
+#elif HV_SIMD_M33
+  o->step.s = (hv_int32_t) (f*(HV_PHASOR_2_32/r));
+  o->inc = (hv_m33i_t) {4*o->step.s, 4*o->step.s, 4*o->step.s, 4*o->step.s};
+  sPhasor_k_updatePhase(o, o->phase[0]);
 #else // HV_SIMD_NONE
   o->step.s = (hv_int32_t) (f*(HV_PHASOR_2_32/r));
   o->inc = o->step.s;
@@ -91,6 +101,10 @@ hv_size_t sPhasor_init(SignalPhasor *o, double samplerate) {
   o->phase = vdupq_n_u32(0);
   o->inc = vdupq_n_s32(0);
   o->step.f2sc = (float) (HV_PHASOR_2_32/samplerate);
+#elif HV_SIMD_M33
+  o->phase = (hv_m33u_t) {0, 0, 0, 0};
+  o->inc = (hv_m33i_t) {0, 0, 0, 0};
+  o->step.f2sc = (float) (HV_PHASOR_2_32/samplerate);
 #else // HV_SIMD_NONE
   o->phase = 0;
   o->inc = 0;
@@ -107,7 +121,7 @@ void sPhasor_onMessage(HeavyContextInterface *_c, SignalPhasor *o, int letIn, co
       while (p > 1.0f) p -= 1.0f;
 #if HV_SIMD_AVX
       sPhasor_updatePhase(o, p);
-#else // HV_SIMD_SSE || HV_SIMD_NEON || HV_SIMD_NONE
+#else // HV_SIMD_SSE || HV_SIMD_NEON || HV_SIMD_M33 || HV_SIMD_NONE
       sPhasor_updatePhase(o, (hv_uint32_t) (p * HV_PHASOR_2_32));
 #endif
     }
@@ -130,7 +144,7 @@ void sPhasor_k_onMessage(HeavyContextInterface *_c, SignalPhasor *o, int letIn,
         while (p > 1.0f) p -= 1.0f;
 #if HV_SIMD_AVX
         sPhasor_k_updatePhase(o, p);
-#else // HV_SIMD_SSE || HV_SIMD_NEON || HV_SIMD_NONE
+#else // HV_SIMD_SSE || HV_SIMD_NEON || HV_SIMD_M33 || HV_SIMD_NONE
         sPhasor_k_updatePhase(o, (hv_uint32_t) (p * HV_PHASOR_2_32));
 #endif
         break;
@@ -33,6 +33,9 @@ typedef struct SignalPhasor {
 #elif HV_SIMD_NEON
   uint32x4_t phase;
   int32x4_t inc;
+#elif HV_SIMD_M33
+  hv_m33u_t phase;
+  hv_m33i_t inc;
 #else // HV_SIMD_NONE
   hv_uint32_t phase;
   hv_int32_t inc;
@@ -99,6 +102,17 @@ static inline void __hv_phasor_f(SignalPhasor *o, hv_bInf_t bIn, hv_bOutf_t bOut
   uint32x4_t pp = vaddq_u32(o->phase, vreinterpretq_u32_s32(p));
   *bOut = vsubq_f32(vreinterpretq_f32_u32(vorrq_u32(vshrq_n_u32(pp, 9), vdupq_n_u32(0x3F800000))), vdupq_n_f32(1.0f));
   o->phase = vdupq_n_u32(pp[3]);
+#elif HV_SIMD_M33
+  // exclusive prefix sum: lane i uses the phase before its own step (same as HV_SIMD_NONE)
+  const hv_m33i_t s = __builtin_convertvector(bIn * o->step.f2sc, hv_m33i_t);
+  const hv_uint32_t p0 = o->phase[0];
+  const hv_uint32_t p1 = p0 + (hv_uint32_t) s[0];
+  const hv_uint32_t p2 = p1 + (hv_uint32_t) s[1];
+  const hv_uint32_t p3 = p2 + (hv_uint32_t) s[2];
+  const hv_m33u_t pp = (hv_m33u_t) {p0, p1, p2, p3};
+  *bOut = (hv_bufferf_t) ((pp >> 9) | 0x3F800000) - 1.0f;
+  const hv_uint32_t p4 = p3 + (hv_uint32_t) s[3];
+  o->phase = (hv_m33u_t) {p4, p4, p4, p4};
 #else // HV_SIMD_NONE
   union { float f; hv_uint32_t u; } uphase;
   uphase.u = (o->phase >> 9) | 0x3F800000;
@@ -126,6 +140,9 @@ static inline void __hv_phasor_k_f(SignalPhasor *o, hv_bOutf_t bOut) {
       vdupq_n_u32(0x3F800000))),
       vdupq_n_f32(1.0f));
   o->phase = vaddq_u32(o->phase, vreinterpretq_u32_s32(o->inc));
+#elif HV_SIMD_M33
+  *bOut = (hv_bufferf_t) ((o->phase >> 9) | 0x3F800000) - 1.0f;
+  o->phase += (hv_m33u_t) o->inc;
 #else // HV_SIMD_NONE
   union { float f; hv_uint32_t u; } uphase;
   uphase.u = (o->phase >> 9) | 0x3F800000;
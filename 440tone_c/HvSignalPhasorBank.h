@@ -0,0 +1,118 @@
+/**
+ * @file HvSignalPhasorBank.h
+ * @brief Constant-frequency phasors with one voice per SIMD lane (structure of arrays)
+ * @author Ale Moglia
+ * @date 2026
+ *
+ * SignalPhasor puts consecutive samples of one oscillator in the SIMD lanes. A
+ * SignalPhasorBank instead holds HV_N_SIMD independent voices, one per lane, each with
+ * its own 32-bit phase and step, and advances all of them by one sample per call. A
+ * voice bank then runs one loop over groups of voices instead of one process() per voice.
+ *
+ * The phase arithmetic is the integer one of the SSE/NEON/M33/scalar SignalPhasor
+ * (2^32 = one period), on every backend including AVX, so voice v at sample t has exactly
+ * the phase that a single __hv_phasor_k_f() context would have at its sample t.
+ */
+
+#ifndef _HEAVY_SIGNAL_PHASOR_BANK_H_
+#define _HEAVY_SIGNAL_PHASOR_BANK_H_
+
+#include "HvHeavyInternal.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define HV_PHASOR_BANK_2_32 4294967296.0
+
+typedef struct SignalPhasorBank {
+  hv_bufferi_t phase; // current phase of each voice
+  hv_bufferi_t inc;   // per-sample step of each voice
+} SignalPhasorBank;
+
+/** Zero phase and frequency in every lane. */
+static inline void sPhasorBank_init(SignalPhasorBank *o) {
+  __hv_zero_i(VOi(o->phase));
+  __hv_zero_i(VOi(o->inc));
+}
+
+/** Sets the frequency of one lane, with the same step rounding as sPhasor_k_init(). */
+static inline void sPhasorBank_setFrequency(SignalPhasorBank *o, int lane, float f, double r) {
+  ((hv_int32_t *) &o->inc)[lane] = (hv_int32_t) (f*(HV_PHASOR_BANK_2_32/r));
+}
+
+/** Sets the phase of one lane, p in [0,1]. */
+static inline void sPhasorBank_setPhase(SignalPhasorBank *o, int lane, float p) {
+  ((hv_uint32_t *) &o->phase)[lane] = (hv_uint32_t) (p * HV_PHASOR_BANK_2_32);
+}
+
+/** Outputs the phase of every voice in [0,1), then advances each voice by one sample. */
+static inline void __hv_phasorbank_f(SignalPhasorBank *o, hv_bOutf_t bOut) {
+#if HV_SIMD_AVX
+  // AVX has no 256-bit integer shifts, work on the two 128-bit halves
+  const __m128i one = _mm_set1_epi32(0x3F800000);
+  const __m128i lo = _mm_or_si128(_mm_srli_epi32(_mm256_castsi256_si128(o->phase), 9), one);
+  const __m128i hi = _mm_or_si128(_mm_srli_epi32(_mm256_extractf128_si256(o->phase, 1), 9), one);
+  *bOut = _mm256_sub_ps(_mm256_castsi256_ps(_mm256_insertf128_si256(_mm256_castsi128_si256(lo), hi, 1)),
+      _mm256_set1_ps(1.0f));
+  __hv_add_i(o->phase, o->inc, &o->phase);
+#elif HV_SIMD_SSE
+  *bOut = _mm_sub_ps(_mm_castsi128_ps(
+      _mm_or_si128(_mm_srli_epi32(o->phase, 9),
+      _mm_set1_epi32(0x3F800000))),
+      _mm_set1_ps(1.0f));
+  o->phase = _mm_add_epi32(o->phase, o->inc);
+#elif HV_SIMD_NEON
+  *bOut = vsubq_f32(vreinterpretq_f32_u32(
+      vorrq_u32(vshrq_n_u32(vreinterpretq_u32_s32(o->phase), 9),
+      vdupq_n_u32(0x3F800000))),
+      vdupq_n_f32(1.0f));
+  o->phase = vaddq_s32(o->phase, o->inc);
+#elif HV_SIMD_M33
+  *bOut = (hv_bufferf_t) ((((hv_m33u_t) o->phase) >> 9) | 0x3F800000) - 1.0f;
+  o->phase += o->inc;
+#else // HV_SIMD_NONE
+  union { float f; hv_uint32_t u; } uphase;
+  uphase.u = (((hv_uint32_t) o->phase) >> 9) | 0x3F800000;
+  *bOut = uphase.f - 1.0f;
+  o->phase = (hv_int32_t) ((hv_uint32_t) o->phase + (hv_uint32_t) o->inc);
+#endif
+}
+
+/**
+ * Reduces HV_N_SIMD voice vectors to one time vector: lane k of the result is the sum of
+ * all lanes of bIn[k]. Turns HV_N_SIMD samples of a voice group back into output samples.
+ */
+static inline void __hv_phasorbank_sum_f(const hv_bufferf_t *bIn, hv_bOutf_t bOut) {
+#if HV_SIMD_AVX
+  const __m256 t0 = _mm256_hadd_ps(bIn[0], bIn[1]);
+  const __m256 t1 = _mm256_hadd_ps(bIn[2], bIn[3]);
+  const __m256 t2 = _mm256_hadd_ps(bIn[4], bIn[5]);
+  const __m256 t3 = _mm256_hadd_ps(bIn[6], bIn[7]);
+  const __m256 u0 = _mm256_hadd_ps(t0, t1); // sums 0-3 of the low halves | sums 0-3 of the high halves
+  const __m256 u1 = _mm256_hadd_ps(t2, t3); // same for 4-7
+  *bOut = _mm256_add_ps(_mm256_permute2f128_ps(u0, u1, 0x20), _mm256_permute2f128_ps(u0, u1, 0x31));
+#elif HV_SIMD_SSE
+  *bOut = _mm_hadd_ps(_mm_hadd_ps(bIn[0], bIn[1]), _mm_hadd_ps(bIn[2], bIn[3]));
+#elif HV_SIMD_NEON
+  const float32x2_t s0 = vadd_f32(vget_low_f32(bIn[0]), vget_high_f32(bIn[0]));
+  const float32x2_t s1 = vadd_f32(vget_low_f32(bIn[1]), vget_high_f32(bIn[1]));
+  const float32x2_t s2 = vadd_f32(vget_low_f32(bIn[2]), vget_high_f32(bIn[2]));
+  const float32x2_t s3 = vadd_f32(vget_low_f32(bIn[3]), vget_high_f32(bIn[3]));
+  *bOut = vcombine_f32(vpadd_f32(s0, s1), vpadd_f32(s2, s3));
+#elif HV_SIMD_M33
+  *bOut = (hv_bufferf_t) {
+    (bIn[0][0] + bIn[0][1]) + (bIn[0][2] + bIn[0][3]),
+    (bIn[1][0] + bIn[1][1]) + (bIn[1][2] + bIn[1][3]),
+    (bIn[2][0] + bIn[2][1]) + (bIn[2][2] + bIn[2][3]),
+    (bIn[3][0] + bIn[3][1]) + (bIn[3][2] + bIn[3][3])};
+#else // HV_SIMD_NONE
+  *bOut = bIn[0];
+#endif
+}
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // _HEAVY_SIGNAL_PHASOR_BANK_H_
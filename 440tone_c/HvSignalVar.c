@@ -28,6 +28,9 @@ static void sVarf_update(SignalVarf *o, float k, float step, bool reverse) {
 #elif HV_SIMD_NEON
   if (reverse) o->v = (float32x4_t) {3.0f*step+k, 2.0f*step+k, step+k, k};
   else o->v = (float32x4_t) {k, step+k, 2.0f*step+k, 3.0f*step+k};
+#elif HV_SIMD_M33
+  if (reverse) o->v = (hv_bufferf_t) {3.0f*step+k, 2.0f*step+k, step+k, k};
+  else o->v = (hv_bufferf_t) {k, step+k, 2.0f*step+k, 3.0f*step+k};
 #else // HV_SIMD_NONE
   o->v = k;
 #endif
@@ -58,6 +61,9 @@ static void sVari_update(SignalVari *o, int k, int step, bool reverse) {
 #elif HV_SIMD_NEON
   if (reverse) o->v = (int32x4_t) {3*step+k, 2*step+k, step+k, k};
   else o->v = (int32x4_t) {k, step+k, 2*step+k, 3*step+k};
+#elif HV_SIMD_M33
+  if (reverse) o->v = (hv_bufferi_t) {3*step+k, 2*step+k, step+k, k};
+  else o->v = (hv_bufferi_t) {k, step+k, 2*step+k, 3*step+k};
 #else // HV_SIMD_NEON
   o->v = k;
 #endif
@@ -80,6 +80,11 @@ void sVari_onMessage(HeavyContextInterface *_c, SignalVari *o, const HvMessage *
 #define __hv_var_k_i_r(_z,_a,_b,_c,_d,_e,_f,_g,_h) *_z=((int32x4_t) {_d,_c,_b,_a})
 #define __hv_var_k_f(_z,_a,_b,_c,_d,_e,_f,_g,_h) *_z=((float32x4_t) {_a,_b,_c,_d})
 #define __hv_var_k_f_r(_z,_a,_b,_c,_d,_e,_f,_g,_h) *_z=((float32x4_t) {_d,_c,_b,_a})
+#elif HV_SIMD_M33
+#define __hv_var_k_i(_z,_a,_b,_c,_d,_e,_f,_g,_h) *_z=((hv_bufferi_t) {_a,_b,_c,_d})
+#define __hv_var_k_i_r(_z,_a,_b,_c,_d,_e,_f,_g,_h) *_z=((hv_bufferi_t) {_d,_c,_b,_a})
+#define __hv_var_k_f(_z,_a,_b,_c,_d,_e,_f,_g,_h) *_z=((hv_bufferf_t) {_a,_b,_c,_d})
+#define __hv_var_k_f_r(_z,_a,_b,_c,_d,_e,_f,_g,_h) *_z=((hv_bufferf_t) {_d,_c,_b,_a})
 #else // HV_SIMD_NONE
 #define __hv_var_k_i(_z,_a,_b,_c,_d,_e,_f,_g,_h) *_z=_a
 #define __hv_var_k_i_r(_z,_a,_b,_c,_d,_e,_f,_g,_h) *_z=_a
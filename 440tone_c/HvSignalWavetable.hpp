@@ -0,0 +1,168 @@
+/**
+ * @file HvSignalWavetable.hpp
+ * @brief Interpolated cosine wavetable oscillator driven by the SignalPhasor integer phase
+ * @author Ale Moglia
+ * @date 2026
+ *
+ * Replaces the generated phasor -> abs -> 5-multiply polynomial sine chain with one
+ * table lookup and one linear interpolation per sample. The table is generated at
+ * compile time (constexpr; a C++11 build fills it at start-up instead), holds
+ * 2^HV_WAVETABLE_BITS + 1 floats and is indexed directly by the top bits of the 32-bit
+ * phase, the remaining bits giving the interpolation fraction.
+ */
+
+#ifndef _HEAVY_SIGNAL_WAVETABLE_H_
+#define _HEAVY_SIGNAL_WAVETABLE_H_
+
+#include "HvSignalPhasor.h"
+#include "HvSignalPhasorBank.h"
+
+// 1 = Heavy_440tone::process() uses the wavetable instead of the polynomial chain
+#ifndef HV_OSC_WAVETABLE
+#define HV_OSC_WAVETABLE 0
+#endif
+
+// Table size: 2^HV_WAVETABLE_BITS points per period (9 = 512 points, ~2 KB)
+#ifndef HV_WAVETABLE_BITS
+#define HV_WAVETABLE_BITS 9
+#endif
+
+// 0 = table is const and stays in flash (XIP cached), 1 = table is copied to SRAM at boot
+#ifndef HV_WAVETABLE_IN_SRAM
+#define HV_WAVETABLE_IN_SRAM 0
+#endif
+
+#define HV_WAVETABLE_SIZE (1u << HV_WAVETABLE_BITS)
+
+static_assert(HV_WAVETABLE_BITS >= 2 && HV_WAVETABLE_BITS <= 16, "HV_WAVETABLE_BITS out of range");
+
+// The generator loops need C++14 constexpr; under C++11 the table is filled at start-up (in SRAM)
+#if __cplusplus >= 201402L
+#define HV_WAVETABLE_CONSTEXPR constexpr
+#else
+#define HV_WAVETABLE_CONSTEXPR
+#endif
+
+/**
+ * @brief Cosine for compile-time table generation (double precision Taylor series)
+ * @param x Angle in radians, [0, 2*pi]
+ */
+static HV_WAVETABLE_CONSTEXPR double hv_wavetable_constexprCos(double x) {
+  // cos(x) = -cos(x - pi), series on [-pi, pi] converges to double precision in 30 terms
+  const double y = x - 3.14159265358979323846;
+  double term = 1.0;
+  double sum = 1.0;
+  for (int k = 1; k < 30; ++k) {
+    term *= -y * y / ((2.0 * k - 1.0) * (2.0 * k));
+    sum += term;
+  }
+  return -sum;
+}
+
+/**
+ * @brief One period of cosine plus a guard point, so entry i+1 always exists for the lerp
+ */
+struct HvWavetable {
+  float v[HV_WAVETABLE_SIZE + 1];
+
+  HV_WAVETABLE_CONSTEXPR HvWavetable() : v() {
+    for (hv_uint32_t i = 0; i <= HV_WAVETABLE_SIZE; ++i) {
+      v[i] = (float) hv_wavetable_constexprCos(6.283185307179586 * i / HV_WAVETABLE_SIZE);
+    }
+  }
+};
+
+#if HV_WAVETABLE_IN_SRAM
+static HvWavetable hv_wavetable = HvWavetable(); // constant-initialised, lands in .data (SRAM)
+#else
+static const HvWavetable hv_wavetable = HvWavetable(); // lands in .rodata (flash)
+#endif
+
+/**
+ * @brief Interpolated cosine of a 32-bit phase (0 .. 2^32 = one period)
+ */
+static inline float hv_wavetable_cos(hv_uint32_t phase) {
+  const hv_uint32_t i = phase >> (32 - HV_WAVETABLE_BITS);
+  // same float trick as the phasor: the low bits become a [0,1) mantissa
+  union { float f; hv_uint32_t u; } frac;
+  frac.u = ((phase << HV_WAVETABLE_BITS) >> 9) | 0x3F800000;
+  const float a = hv_wavetable.v[i];
+  const float b = hv_wavetable.v[i + 1];
+  return a + (frac.f - 1.0f) * (b - a);
+}
+
+/**
+ * @brief Reference: the generated polynomial cosine for a 32-bit phase (for THD comparison)
+ */
+static inline float hv_wavetable_polyCos(hv_uint32_t phase) {
+  union { float f; hv_uint32_t u; } uphase;
+  uphase.u = (phase >> 9) | 0x3F800000;
+  const float x = (hv_abs_f((uphase.f - 1.0f) - 0.5f) - 0.25f) * 6.283185307179586f;
+  const float x2 = x * x;
+  const float x3 = x * x2;
+  const float x5 = x3 * x2;
+  return hv_fma_f(x5, 0.007833333333333f, hv_fma_f(x3, -0.166666666666667f, x));
+}
+
+/**
+ * @brief Wavetable version of __hv_phasor_k_f() followed by the cosine chain
+ *
+ * Outputs cos(2*pi*phase) for the current phase, then advances it exactly like
+ * __hv_phasor_k_f(), so phase messages and frequency changes behave the same.
+ */
+static inline void __hv_phasor_k_cos_f(SignalPhasor *o, hv_bOutf_t bOut) {
+#if HV_SIMD_AVX
+  // the AVX phase is a float in [1,2): its mantissa is the top 23 bits of the 32-bit phase
+  hv_uint32_t p[8];
+  float y[8] __attribute__((aligned(32)));
+  _mm256_storeu_si256((__m256i *) p, _mm256_castps_si256(o->phase));
+  for (int i = 0; i < 8; ++i) {
+    y[i] = hv_wavetable_cos(p[i] << 9);
+  }
+  *bOut = _mm256_load_ps(y);
+  o->phase = _mm256_or_ps(_mm256_andnot_ps(
+      _mm256_set1_ps(-INFINITY),
+      _mm256_add_ps(o->phase, o->inc)),
+      _mm256_set1_ps(1.0f));
+#elif HV_SIMD_SSE
+  hv_uint32_t p[4];
+  _mm_storeu_si128((__m128i *) p, o->phase);
+  *bOut = _mm_set_ps(hv_wavetable_cos(p[3]), hv_wavetable_cos(p[2]), hv_wavetable_cos(p[1]), hv_wavetable_cos(p[0]));
+  o->phase = _mm_add_epi32(o->phase, o->inc);
+#elif HV_SIMD_NEON
+  *bOut = (float32x4_t) {
+    hv_wavetable_cos(vgetq_lane_u32(o->phase, 0)),
+    hv_wavetable_cos(vgetq_lane_u32(o->phase, 1)),
+    hv_wavetable_cos(vgetq_lane_u32(o->phase, 2)),
+    hv_wavetable_cos(vgetq_lane_u32(o->phase, 3))};
+  o->phase = vaddq_u32(o->phase, vreinterpretq_u32_s32(o->inc));
+#elif HV_SIMD_M33
+  *bOut = (hv_bufferf_t) {
+    hv_wavetable_cos(o->phase[0]),
+    hv_wavetable_cos(o->phase[1]),
+    hv_wavetable_cos(o->phase[2]),
+    hv_wavetable_cos(o->phase[3])};
+  o->phase += (hv_m33u_t) o->inc;
+#else // HV_SIMD_NONE
+  *bOut = hv_wavetable_cos(o->phase);
+  o->phase += o->inc;
+#endif
+}
+
+/**
+ * @brief Wavetable version of __hv_phasorbank_f() followed by the cosine chain
+ *
+ * One table lookup per voice lane, then every voice advances by one sample.
+ */
+static inline void __hv_phasorbank_cos_f(SignalPhasorBank *o, hv_bOutf_t bOut) {
+  hv_uint32_t p[HV_N_SIMD];
+  float y[HV_N_SIMD] __attribute__((aligned(32)));
+  hv_memcpy(p, &o->phase, sizeof(p));
+  for (int i = 0; i < HV_N_SIMD; ++i) {
+    y[i] = hv_wavetable_cos(p[i]);
+  }
+  __hv_load_f(y, bOut);
+  __hv_add_i(VIi(o->phase), VIi(o->inc), VOi(o->phase));
+}
+
+#endif // _HEAVY_SIGNAL_WAVETABLE_H_
@@ -24,6 +24,7 @@ hv_size_t hTable_init(HvTable *o, int length) {
   // add an extra length for mirroring
   o->allocated = o->size + HV_N_SIMD;
   o->head = 0;
+  o->readOnly = 0;
   hv_size_t numBytes = o->allocated * sizeof(float);
   o->buffer = (float *) hv_malloc(numBytes);
   hv_assert(o->buffer != NULL);
@@ -36,6 +37,7 @@ hv_size_t hTable_initWithData(HvTable *o, int length, const float *data) {
   o->size = (length + HV_N_SIMD_MASK) & ~HV_N_SIMD_MASK;
   o->allocated = o->size + HV_N_SIMD;
   o->head = 0;
+  o->readOnly = 0;
   hv_size_t numBytes = o->size * sizeof(float);
   o->buffer = (float *) hv_malloc(numBytes);
   hv_assert(o->buffer != NULL);
@@ -44,17 +46,40 @@ hv_size_t hTable_initWithData(HvTable *o, int length, const float *data) {
   return numBytes;
 }
 
+hv_size_t hTable_initWithConstData(HvTable *o, int length, const float *data) {
+  o->length = length;
+  o->size = (length + HV_N_SIMD_MASK) & ~HV_N_SIMD_MASK;
+  o->allocated = o->size + HV_N_SIMD;
+  o->head = 0;
+  o->readOnly = 1;
+  o->buffer = (float *) data; // never written while readOnly is set
+  return 0;
+}
+
 hv_size_t hTable_initWithFinalData(HvTable *o, int length, float *data) {
   o->length = length;
   o->size = length;
   o->allocated = length;
   o->buffer = data;
   o->head = 0;
+  o->readOnly = 0;
   return 0;
 }
 
 void hTable_free(HvTable *o) {
-  hv_free(o->buffer);
+  if (!o->readOnly) hv_free(o->buffer);
+}
+
+float *hTable_getWritableBuffer(HvTable *o) {
+  if (o->readOnly) {
+    const hv_size_t numBytes = o->allocated * sizeof(float);
+    float *b = (float *) hv_malloc(numBytes);
+    if (b == NULL) return NULL; // no heap for the copy (e.g. a sealed arena): stays on the const data
+    hv_memcpy(b, o->buffer, numBytes);
+    o->buffer = b;
+    o->readOnly = 0;
+  }
+  return o->buffer;
 }
 
 int hTable_resize(HvTable *o, hv_uint32_t newLength) {
@@ -62,12 +87,13 @@ int hTable_resize(HvTable *o, hv_uint32_t newLength) {
   // NOTE(mhroth): mirrored bytes are not necessarily carried over
   const hv_uint32_t newSize = (newLength + HV_N_SIMD_MASK) & ~HV_N_SIMD_MASK;
   if (newSize == o->size) return 0; // early exit if no change in size
+  if (hTable_getWritableBuffer(o) == NULL) return 0; // flash data cannot be reallocated
   const hv_uint32_t oldSizeBytes = (hv_uint32_t) (o->size * sizeof(float));
   const hv_uint32_t newAllocated = newSize + HV_N_SIMD;
   const hv_uint32_t newAllocatedBytes = (hv_uint32_t) (newAllocated * sizeof(float));
 
   float *b = (float *) hv_realloc(o->buffer, newAllocatedBytes);
-  hv_assert(b != NULL); // error while reallocing!
+  if (b == NULL) return 0; // error while reallocing! the table keeps its old buffer and size
   // ensure that hv_realloc has given us a correctly aligned buffer
   if ((((hv_uintptr_t) (const void *) b) & ((0x1<<HV_N_SIMD)-1)) == 0) {
     if (newSize > o->size) {
@@ -105,6 +131,7 @@ void hTable_onMessage(HeavyContextInterface *_c, HvTable *o, int letIn, const Hv
   }
 
   else if (msg_compareSymbol(m,0,"mirror")) {
-    hv_memcpy(o->buffer+o->size, o->buffer, HV_N_SIMD*sizeof(float));
+    float *b = hTable_getWritableBuffer(o);
+    if (b != NULL) hv_memcpy(b+o->size, b, HV_N_SIMD*sizeof(float));
   }
 }
@@ -39,25 +39,51 @@ typedef struct HvTable {
   hv_uint32_t allocated;
 
   hv_uint32_t head; // the most recently written point
+
+  // non-zero while buffer points at const (e.g. XIP flash) data that is not ours.
+  // The first write access copies it to the heap (hTable_getWritableBuffer).
+  hv_uint32_t readOnly;
 } HvTable;
 
+// floats a const array passed to hTable_initWithConstData() must hold for a table
+// of _length values: the usable size plus the HV_N_SIMD mirrored values
+#define HV_TABLE_CONST_FLOATS(_length) ((((_length) + HV_N_SIMD_MASK) & ~HV_N_SIMD_MASK) + HV_N_SIMD)
+
 hv_size_t hTable_init(HvTable *o, int length);
 
 hv_size_t hTable_initWithData(HvTable *o, int length, const float *data);
 
+// Points the table at data without copying it, so a const array stays in flash and
+// takes no SRAM. data must hold HV_TABLE_CONST_FLOATS(length) floats, zero padded
+// after length, with the first HV_N_SIMD values repeated at the end (the mirror).
+// The table is copied to the heap on the first write access or resize.
+// A resize that cannot be allocated leaves the table as it was.
+hv_size_t hTable_initWithConstData(HvTable *o, int length, const float *data);
+
 hv_size_t hTable_initWithFinalData(HvTable *o, int length, float *data);
 
 void hTable_free(HvTable *o);
 
 int hTable_resize(HvTable *o, hv_uint32_t newLength);
 
+// The buffer for writing: a read-only table is first copied to the heap (copy-on-write).
+// NULL if that allocation fails, the table then stays read-only on its const data.
+// Under a sealed arena (HV_ARENA_SEAL) this holds from the first process() on, so any
+// copy must be made before it.
+float *hTable_getWritableBuffer(HvTable *o);
+
 void hTable_onMessage(HeavyContextInterface *_c, HvTable *o, int letIn, const HvMessage *m,
     void (*sendMessage)(HeavyContextInterface *, int, const HvMessage *));
 
+// the buffer for reading. Write through hTable_getWritableBuffer(), this one may be in flash.
 static inline float *hTable_getBuffer(HvTable *o) {
   return o->buffer;
 }
 
+static inline bool hTable_isReadOnly(HvTable *o) {
+  return o->readOnly != 0;
+}
+
 // the user-requested length of the table (number of floats)
 static inline hv_uint32_t hTable_getLength(HvTable *o) {
   return o->length;
@@ -54,10 +54,11 @@
 #define hv_uintptr_t uintptr_t
 
 // SIMD-specific includes
-#if !(HV_SIMD_NONE || HV_SIMD_NEON || HV_SIMD_SSE || HV_SIMD_AVX)
+#if !(HV_SIMD_NONE || HV_SIMD_NEON || HV_SIMD_SSE || HV_SIMD_AVX || HV_SIMD_M33)
   #define HV_SIMD_NEON __ARM_NEON__
   #define HV_SIMD_SSE (__SSE__ && __SSE2__ && __SSE3__ && __SSSE3__ && __SSE4_1__)
   #define HV_SIMD_AVX (__AVX__ && HV_SIMD_SSE)
+  #define HV_SIMD_M33 (__ARM_ARCH_8M_MAIN__ && __ARM_FP && !HV_SIMD_NEON)
 #endif
 #ifndef HV_SIMD_FMA
   #define HV_SIMD_FMA __FMA__
@@ -105,6 +106,22 @@
   #define VOf(_x) (&_x)
   #define VIi(_x) (_x)
   #define VOi(_x) (&_x)
+#elif HV_SIMD_M33 // Cortex-M33 (RP2350): 4-sample groups, unrolled onto the scalar FPv5 FPU
+  // GCC generic vectors, only 4-byte aligned so plain malloc() and any float* block work
+  typedef float hv_m33f_t __attribute__((vector_size(16), aligned(4)));
+  typedef int32_t hv_m33i_t __attribute__((vector_size(16), aligned(4)));
+  typedef uint32_t hv_m33u_t __attribute__((vector_size(16), aligned(4)));
+  #define HV_N_SIMD 4
+  #define hv_bufferf_t hv_m33f_t
+  #define hv_bufferi_t hv_m33i_t
+  #define hv_bInf_t hv_m33f_t
+  #define hv_bOutf_t hv_m33f_t*
+  #define hv_bIni_t hv_m33i_t
+  #define hv_bOuti_t hv_m33i_t*
+  #define VIf(_x) (_x)
+  #define VOf(_x) (&_x)
+  #define VIi(_x) (_x)
+  #define VOi(_x) (&_x)
 #else // DEFAULT
   #define HV_N_SIMD 1
   #undef HV_SIMD_NONE
@@ -127,6 +144,7 @@
 #include <string.h>
 #define hv_strlen(a) strlen(a)
 #define hv_strcmp(a, b) strcmp(a, b)
+#define hv_strchr(a, b) strchr(a, b)
 #define hv_snprintf(a, b, c, ...) snprintf(a, b, c, __VA_ARGS__)
 #if HV_WIN
 #define hv_strncpy(_dst, _src, _len) strncpy_s(_dst, _len, _src, _TRUNCATE)
@@ -137,7 +155,18 @@
 // Memory management
 #define hv_memcpy(a, b, c) memcpy(a, b, c)
 #define hv_memclear(a, b) memset(a, 0, b)
-#if HV_WIN
+#include "HvArena.h"
+#if HV_BARE_METAL && HV_ARENA_KB > 0
+  #define HV_ARENA 1
+#endif
+#if HV_ARENA
+  // static arena, see HvArena.h
+  #include <alloca.h>
+  #define hv_alloca(_n) alloca(_n)
+  #define hv_malloc(_n) hv_arena_alloc(_n)
+  #define hv_realloc(a, b) hv_arena_realloc(a, b)
+  #define hv_free(x) hv_arena_free(x)
+#elif HV_WIN
   #include <malloc.h>
   #define hv_alloca(_n) _alloca(_n)
   #if HV_SIMD_AVX
@@ -212,6 +241,19 @@
 #define HV_FORCE_INLINE inline __attribute__((always_inline))
 #endif
 
+// Real-time placement: HV_HOT_IN_RAM puts the functions marked HV_HOT(name) (everything
+// process() runs per block, and the message and parameter ingress) in .time_critical.*
+// sections, which the Pico SDK linker scripts copy to SRAM at boot. GCC ignores section
+// attributes on template instantiations, so templates are inlined into a marked function.
+#ifndef HV_HOT_IN_RAM
+#define HV_HOT_IN_RAM 0
+#endif
+#if HV_HOT_IN_RAM && !HV_WIN
+#define HV_HOT(_f) __attribute__((section(".time_critical.hv_" #_f))) _f
+#else
+#define HV_HOT(_f) _f
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -219,6 +261,71 @@ extern "C" {
   hv_uint32_t hv_string_to_hash(const char *str);
 #ifdef __cplusplus
 }
+
+// Compile-time twin of hv_string_to_hash(), the same MurmurHash2 step for step: whole
+// words are read as they are in memory (little-endian, as on every Heavy target but
+// big-endian hosts), tail bytes promote through char exactly as the runtime code does.
+// HV_HASH("name") is a constant expression, usable as a case label or constexpr value.
+// C++11 constexpr functions are a single return statement, so each loop is a recursion.
+constexpr hv_uint32_t hv_hash_constexpr_length(const char *str) {
+  return (*str == '\0') ? 0 : 1 + hv_hash_constexpr_length(str + 1);
+}
+
+// A char byte promotes to int, sign-extended where char is signed. A constant expression
+// may not shift a negative value left, so the sign-extended bits are shifted as unsigned.
+constexpr hv_uint32_t hv_hash_constexpr_byte(char c, int shift) {
+  return (hv_uint32_t) (hv_int32_t) c << shift;
+}
+
+constexpr hv_uint32_t hv_hash_constexpr_word(const char *str) {
+#if HV_EMSCRIPTEN
+  return hv_hash_constexpr_byte(str[0], 0) | hv_hash_constexpr_byte(str[1], 8) |
+      hv_hash_constexpr_byte(str[2], 16) | hv_hash_constexpr_byte(str[3], 24);
+#else
+  return (hv_uint32_t) (unsigned char) str[0] | ((hv_uint32_t) (unsigned char) str[1] << 8) |
+      ((hv_uint32_t) (unsigned char) str[2] << 16) | ((hv_uint32_t) (unsigned char) str[3] << 24);
+#endif
+}
+
+// k = word * n, then k ^= k >> r; k *= n
+constexpr hv_uint32_t hv_hash_constexpr_mixWord(hv_uint32_t k) {
+  return (k ^ (k >> 24)) * 0x5bd1e995u;
+}
+
+constexpr hv_uint32_t hv_hash_constexpr_tail(const char *str, hv_uint32_t len, hv_uint32_t x) {
+  return (len == 3) ? (x ^ hv_hash_constexpr_byte(str[2], 16) ^ hv_hash_constexpr_byte(str[1], 8) ^
+                          hv_hash_constexpr_byte(str[0], 0)) * 0x5bd1e995u
+       : (len == 2) ? (x ^ hv_hash_constexpr_byte(str[1], 8) ^ hv_hash_constexpr_byte(str[0], 0)) * 0x5bd1e995u
+       : (len == 1) ? (x ^ hv_hash_constexpr_byte(str[0], 0)) * 0x5bd1e995u
+       : x;
+}
+
+// x ^= x >> 13; x *= n; x ^= x >> 15
+constexpr hv_uint32_t hv_hash_constexpr_shift15(hv_uint32_t x) {
+  return x ^ (x >> 15);
+}
+
+constexpr hv_uint32_t hv_hash_constexpr_finish(hv_uint32_t x) {
+  return hv_hash_constexpr_shift15((x ^ (x >> 13)) * 0x5bd1e995u);
+}
+
+constexpr hv_uint32_t hv_hash_constexpr_words(const char *str, hv_uint32_t len, hv_uint32_t x) {
+  return (len >= 4)
+      ? hv_hash_constexpr_words(str + 4, len - 4,
+            (x * 0x5bd1e995u) ^ hv_hash_constexpr_mixWord(hv_hash_constexpr_word(str) * 0x5bd1e995u))
+      : hv_hash_constexpr_finish(hv_hash_constexpr_tail(str, len, x));
+}
+
+constexpr hv_uint32_t hv_string_to_hash_constexpr(const char *str) {
+  return (str == nullptr) ? 0 : hv_hash_constexpr_words(str, hv_hash_constexpr_length(str), hv_hash_constexpr_length(str));
+}
+
+template <hv_uint32_t H> struct hv_hash_constant { static constexpr hv_uint32_t value = H; };
+#define HV_HASH(_s) (hv_hash_constant<hv_string_to_hash_constexpr(_s)>::value)
+
+// High-bit tail bytes take the sign-extended path (values of hv_string_to_hash() for each char signedness)
+static_assert(HV_HASH("\xe9t\xe9") == ((char) -1 < 0 ? 0x312e6171u : 0x3eb55790u), "HV_HASH tail bytes");
+static_assert(HV_HASH("freq\xe9") == ((char) -1 < 0 ? 0x74cc7174u : 0xde6db5c9u), "HV_HASH tail bytes");
 #endif
 
 // Math
@@ -0,0 +1,399 @@
+/**
+ * @file capture_diff.cpp
+ * @brief Compare a USB capture of the firmware's Heavy output against a native render
+ * @author Ale Moglia
+ * @date 2026
+ *
+ * Reads the packet stream of the firmware's USB capture sink (USB_CAPTURE=ON, format in
+ * lib/debug/CaptureFormat.h) and compares every block, by sequence number, against the
+ * same block rendered by this host build of Heavy, or against a second capture file.
+ * Reports dropped packets, bytes skipped to resynchronise, and every sample that differs
+ * by more than the tolerance.
+ *
+ *   capture_diff [options] CAPTURE [REFERENCE]   compare (CAPTURE or REFERENCE may be - for stdin)
+ *   capture_diff --render BLOCKS [options] OUT    write a native render in the capture format
+ *
+ * Options:
+ *   --rate HZ        Heavy sample rate of the native render (default 40000, as the firmware)
+ *   --format s16|f32 Encoding written by --render (default s16)
+ *   --frames N       Block size written by --render (default 64)
+ *   --tolerance X    Largest accepted difference: float units for f32, LSBs for s16 (default 0)
+ *   --report N       Mismatching samples printed in full (default 10)
+ *
+ * The native render has no control input, so compare captures of a firmware built with
+ * CONTROL_SCAN=OFF. Exit status: 0 = identical within the tolerance, 1 = mismatch,
+ * 2 = usage or input error.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "Heavy_440tone.h"
+#include "lib/debug/CaptureFormat.h"
+
+#define DIFF_DEFAULT_RATE 40000.0 // Same as the firmware
+#define DIFF_DEFAULT_FRAMES 64
+#define DIFF_FRAME_MULTIPLE 8 // Widest SIMD backend (AVX), hv_processInline() skips a partial vector
+
+/**
+ * @brief Packet reader that resynchronises on the header magic
+ */
+struct CaptureReader
+{
+    FILE *file;
+    CaptureHeader header;
+    uint8_t payload[CAPTURE_MAX_CHANNELS * CAPTURE_MAX_FRAMES * 4];
+    uint64_t skippedBytes; // Bytes discarded while looking for a valid header
+};
+
+static bool readerOpen(CaptureReader *r, const char *path)
+{
+    r->file = strcmp(path, "-") == 0 ? stdin : fopen(path, "rb");
+    r->skippedBytes = 0;
+    if (r->file == NULL)
+    {
+        fprintf(stderr, "capture_diff: cannot open %s\n", path);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Read the next complete packet
+ * @return false at the end of the stream (a packet cut short at the end is ignored)
+ */
+static bool readerNext(CaptureReader *r)
+{
+    uint8_t *h = (uint8_t *)&r->header;
+    if (fread(h, 1, sizeof(CaptureHeader), r->file) != sizeof(CaptureHeader))
+    {
+        return false;
+    }
+
+    // Slide one byte at a time until the header checks out (capture started mid-packet)
+    while (!captureHeaderValid(&r->header))
+    {
+        memmove(h, h + 1, sizeof(CaptureHeader) - 1);
+        if (fread(h + sizeof(CaptureHeader) - 1, 1, 1, r->file) != 1)
+        {
+            return false;
+        }
+        r->skippedBytes++;
+    }
+
+    const size_t bytes = (size_t)r->header.frames * r->header.channels * captureSampleBytes(r->header.format);
+    return fread(r->payload, 1, bytes, r->file) == bytes;
+}
+
+/**
+ * @brief Sample of a packet as a float in the units of its format (s16: integer LSBs)
+ */
+static float packetSample(const CaptureReader *r, uint32_t index)
+{
+    if (r->header.format == CAPTURE_FORMAT_F32)
+    {
+        float x;
+        memcpy(&x, r->payload + index * 4, 4);
+        return x;
+    }
+    int16_t x;
+    memcpy(&x, r->payload + index * 2, 2);
+    return (float)x;
+}
+
+/**
+ * @brief Native Heavy render, one block per sequence number
+ */
+struct NativeRender
+{
+    double sampleRate;
+    HeavyContextInterface *context;
+    uint32_t nextSequence; // Block the next process() call produces
+    uint32_t frames;
+    float output[CAPTURE_MAX_CHANNELS * CAPTURE_MAX_FRAMES] __attribute__((aligned(32)));
+};
+
+static void renderReset(NativeRender *n)
+{
+    if (n->context != NULL)
+    {
+        hv_delete(n->context);
+    }
+    n->context = hv_440tone_new(n->sampleRate);
+    n->nextSequence = 0;
+}
+
+/**
+ * @brief Render blocks up to and including the given sequence number into n->output
+ */
+static void renderBlock(NativeRender *n, uint32_t sequence, uint32_t frames)
+{
+    // A sequence that goes backwards is a firmware reset, and a new block size cannot be replayed
+    if (n->context == NULL || sequence < n->nextSequence || (n->nextSequence > 0 && frames != n->frames))
+    {
+        renderReset(n);
+    }
+    n->frames = frames;
+    while (n->nextSequence <= sequence)
+    {
+        hv_processInline(n->context, NULL, n->output, (int)frames);
+        n->nextSequence++;
+    }
+}
+
+/**
+ * @brief Write BLOCKS native blocks in the capture format
+ */
+static int renderToFile(const char *path, uint32_t blocks, double sampleRate, CaptureFormat format, uint32_t frames)
+{
+    FILE *file = strcmp(path, "-") == 0 ? stdout : fopen(path, "wb");
+    if (file == NULL)
+    {
+        fprintf(stderr, "capture_diff: cannot create %s\n", path);
+        return 2;
+    }
+
+    static NativeRender render;
+    render.sampleRate = sampleRate;
+    renderReset(&render);
+    const uint32_t channels = (uint32_t)hv_getNumOutputChannels(render.context);
+
+    for (uint32_t b = 0; b < blocks; b++)
+    {
+        renderBlock(&render, b, frames);
+        CaptureHeader header = {CAPTURE_MAGIC, b, (uint16_t)frames, (uint8_t)channels, (uint8_t)format, 0};
+        fwrite(&header, sizeof(header), 1, file);
+        for (uint32_t i = 0; i < frames * channels; i++)
+        {
+            if (format == CAPTURE_FORMAT_F32)
+            {
+                fwrite(&render.output[i], 4, 1, file);
+            }
+            else
+            {
+                const int16_t x = captureToS16(render.output[i]);
+                fwrite(&x, 2, 1, file);
+            }
+        }
+    }
+
+    hv_delete(render.context);
+    if (file != stdout)
+    {
+        fclose(file);
+    }
+    return 0;
+}
+
+static void usage(void)
+{
+    fprintf(stderr, "usage: capture_diff [--rate HZ] [--tolerance X] [--report N] CAPTURE [REFERENCE]\n"
+                    "       capture_diff --render BLOCKS [--rate HZ] [--format s16|f32] [--frames N] OUT\n");
+}
+
+int main(int argc, char **argv)
+{
+    double sampleRate = DIFF_DEFAULT_RATE;
+    double tolerance = 0.0;
+    uint32_t maxReport = 10;
+    long renderBlocks = -1;
+    CaptureFormat renderFormat = CAPTURE_FORMAT_S16;
+    uint32_t renderFrames = DIFF_DEFAULT_FRAMES;
+    const char *paths[2] = {NULL, NULL};
+    int numPaths = 0;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--rate") == 0 && hasValue)
+        {
+            sampleRate = atof(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--tolerance") == 0 && hasValue)
+        {
+            tolerance = atof(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--report") == 0 && hasValue)
+        {
+            maxReport = (uint32_t)atol(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--render") == 0 && hasValue)
+        {
+            renderBlocks = atol(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--format") == 0 && hasValue)
+        {
+            renderFormat = strcmp(argv[++i], "f32") == 0 ? CAPTURE_FORMAT_F32 : CAPTURE_FORMAT_S16;
+        }
+        else if (strcmp(argv[i], "--frames") == 0 && hasValue)
+        {
+            renderFrames = (uint32_t)atol(argv[++i]);
+        }
+        else if (argv[i][0] == '-' && argv[i][1] != '\0')
+        {
+            usage();
+            return 2;
+        }
+        else if (numPaths < 2)
+        {
+            paths[numPaths++] = argv[i];
+        }
+        else
+        {
+            usage();
+            return 2;
+        }
+    }
+
+    if (renderBlocks >= 0)
+    {
+        if (numPaths != 1 || renderFrames < 1 || renderFrames > CAPTURE_MAX_FRAMES ||
+            renderFrames % DIFF_FRAME_MULTIPLE != 0)
+        {
+            usage();
+            return 2;
+        }
+        return renderToFile(paths[0], (uint32_t)renderBlocks, sampleRate, renderFormat, renderFrames);
+    }
+    if (numPaths < 1)
+    {
+        usage();
+        return 2;
+    }
+
+    static CaptureReader capture;
+    static CaptureReader reference;
+    static NativeRender render;
+    const bool fromFile = numPaths == 2;
+    if (!readerOpen(&capture, paths[0]) || (fromFile && !readerOpen(&reference, paths[1])))
+    {
+        return 2;
+    }
+    bool referenceValid = fromFile ? readerNext(&reference) : false;
+    render.sampleRate = sampleRate;
+
+    uint64_t packets = 0;
+    uint64_t gaps = 0;
+    uint64_t missingBlocks = 0;
+    uint64_t unmatched = 0;
+    uint64_t mismatches = 0;
+    uint64_t mismatchBlocks = 0;
+    uint32_t reported = 0;
+    uint32_t firstSequence = 0;
+    uint32_t lastSequence = 0;
+    uint32_t sinkDropped = 0;
+    double maxError = 0.0;
+
+    while (readerNext(&capture))
+    {
+        const CaptureHeader &h = capture.header;
+        if (packets > 0 && h.sequence != lastSequence + 1)
+        {
+            gaps++;
+            missingBlocks += h.sequence > lastSequence ? h.sequence - lastSequence - 1 : 0;
+            printf("gap: block %lu follows %lu\n", (unsigned long)h.sequence, (unsigned long)lastSequence);
+        }
+        if (packets == 0)
+        {
+            firstSequence = h.sequence;
+        }
+        lastSequence = h.sequence;
+        sinkDropped = h.dropped;
+        packets++;
+
+        // Reference block with the same sequence number, in the capture's format
+        const uint32_t count = (uint32_t)h.frames * h.channels;
+        float expected[CAPTURE_MAX_CHANNELS * CAPTURE_MAX_FRAMES];
+        if (fromFile)
+        {
+            while (referenceValid && reference.header.sequence < h.sequence)
+            {
+                referenceValid = readerNext(&reference);
+            }
+            if (!referenceValid || reference.header.sequence != h.sequence || reference.header.frames != h.frames ||
+                reference.header.channels != h.channels || reference.header.format != h.format)
+            {
+                unmatched++;
+                continue;
+            }
+            for (uint32_t i = 0; i < count; i++)
+            {
+                expected[i] = packetSample(&reference, i);
+            }
+        }
+        else
+        {
+            if (h.frames % DIFF_FRAME_MULTIPLE != 0)
+            {
+                unmatched++;
+                continue;
+            }
+            renderBlock(&render, h.sequence, h.frames);
+            // A firmware with an output mask sends only its leading channels (planar, so a prefix)
+            if ((int)h.channels > hv_getNumOutputChannels(render.context))
+            {
+                unmatched++;
+                continue;
+            }
+            for (uint32_t i = 0; i < count; i++)
+            {
+                expected[i] = h.format == CAPTURE_FORMAT_F32 ? render.output[i] : (float)captureToS16(render.output[i]);
+            }
+        }
+
+        bool blockDiffers = false;
+        for (uint32_t i = 0; i < count; i++)
+        {
+            const float actual = packetSample(&capture, i);
+            const double error = fabs((double)actual - (double)expected[i]);
+            // Bit-exact mode also catches a -0.0 / +0.0 or NaN payload change
+            const bool differs = tolerance == 0.0 ? memcmp(&actual, &expected[i], sizeof(float)) != 0 : !(error <= tolerance);
+            if (!differs)
+            {
+                continue;
+            }
+            mismatches++;
+            blockDiffers = true;
+            if (error > maxError)
+            {
+                maxError = error;
+            }
+            if (reported < maxReport)
+            {
+                reported++;
+                printf("block %lu ch %u frame %u: capture %.9g, reference %.9g (error %.3g)\n",
+                       (unsigned long)h.sequence, i / h.frames, i % h.frames, actual, expected[i], error);
+            }
+        }
+        mismatchBlocks += blockDiffers ? 1 : 0;
+    }
+
+    if (packets == 0)
+    {
+        fprintf(stderr, "capture_diff: no packets in %s\n", paths[0]);
+        return 2;
+    }
+
+    printf("capture: %lu packets, blocks %lu-%lu, %s x%u x%u, %llu bytes skipped to resync\n", (unsigned long)packets,
+           (unsigned long)firstSequence, (unsigned long)lastSequence,
+           capture.header.format == CAPTURE_FORMAT_F32 ? "f32" : "s16", capture.header.channels,
+           capture.header.frames, (unsigned long long)capture.skippedBytes);
+    printf("gaps: %llu (%llu blocks missing), drops reported by the sink: %lu\n", (unsigned long long)gaps,
+           (unsigned long long)missingBlocks, (unsigned long)sinkDropped);
+    printf("reference: %s%s", fromFile ? paths[1] : "native render", unmatched ? "" : "\n");
+    if (unmatched)
+    {
+        printf(", %llu blocks without a matching reference block\n", (unsigned long long)unmatched);
+    }
+    printf("mismatch: %llu samples in %llu blocks, max |error| %.3g (tolerance %g)\n", (unsigned long long)mismatches,
+           (unsigned long long)mismatchBlocks, maxError, tolerance);
+
+    if (render.context != NULL)
+    {
+        hv_delete(render.context);
+    }
+    return mismatches == 0 && unmatched == 0 ? 0 : 1;
+}
@@ -0,0 +1,280 @@
+/**
+ * @file heavy_bench.cpp
+ * @brief Throughput benchmark of the Heavy 440tone engine, on the host or on the RP2350
+ * @author Ale Moglia
+ * @date 2026
+ *
+ * Runs hv_processInline() and hv_processInlineInterleaved() over a grid of block sizes
+ * and voice counts (independent Heavy contexts processed one after the other, the way a
+ * polyphonic patch would be), then the same voice counts as a single Heavy_440toneBank
+ * context (mode "bank", voices in SIMD lanes) and hv_440tone_process_block() at its
+ * compiled block size (mode "fixed"), and reports, per configuration:
+ * - ns/sample: wall time per output frame of one voice
+ * - Msamples/s: frames of all voices per second
+ * - realtime: how many times faster than BENCH_SAMPLE_RATE the whole voice set runs
+ * - cycles/sample (RP2350 only): clk_sys cycles from the DWT cycle counter
+ *
+ * Host: built by bench/CMakeLists.txt with the compiler's native SIMD backend.
+ *   heavy_bench          table output
+ *   heavy_bench --csv    one line per configuration, for diffing against a baseline
+ * RP2350: the heavy_bench target of the top-level CMakeLists.txt (-DHEAVY_BENCH=ON)
+ * prints the same table over UART once at boot.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "Heavy_440tone.h"
+#include "Heavy_440toneBank.h"
+#include "HvUtils.h"
+
+#ifndef PICO_ON_DEVICE
+#define PICO_ON_DEVICE 0
+#endif
+
+#if PICO_ON_DEVICE
+#include "pico/stdlib.h"
+#include "hardware/clocks.h"
+#include "lib/debug/CycleProfiler.h"
+#else
+#include <chrono>
+#endif
+
+// Benchmark configuration
+#define BENCH_SAMPLE_RATE 40000.0 // Same as the firmware
+#define BENCH_MAX_BLOCK 256
+#define BENCH_MAX_VOICES 16
+#if PICO_ON_DEVICE
+#define BENCH_FRAMES 40000 // Frames per voice and configuration (1 s of audio)
+#else
+#define BENCH_FRAMES 10000000 // 250 s of audio, a few ms per configuration
+#endif
+
+static const int blockSizes[] = {8, 16, 32, 64, 128, 256};
+static const int voiceCounts[] = {1, 2, 4, 8, 16};
+#define BENCH_NUM_VOICE_COUNTS (sizeof(voiceCounts) / sizeof(voiceCounts[0]))
+
+// Output for the widest block, stereo, aligned for the AVX stores
+static float outputBuffer[BENCH_MAX_BLOCK * 2] __attribute__((aligned(32)));
+static volatile float sink; // Keeps the output live
+
+static HeavyContextInterface *voices[BENCH_MAX_VOICES];
+static HeavyContextInterface *banks[BENCH_NUM_VOICE_COUNTS]; // One bank per entry of voiceCounts
+
+enum BenchMode
+{
+    BENCH_INLINE,      // numVoices contexts, hv_processInline()
+    BENCH_INTERLEAVED, // numVoices contexts, hv_processInlineInterleaved()
+    BENCH_BANK,        // One voice bank of numVoices voices, hv_processInline()
+    BENCH_FIXED,       // numVoices contexts, hv_440tone_process_block() (HV_440TONE_BLOCK_SIZE only)
+    BENCH_NUM_MODES
+};
+
+static const char *const modeNames[BENCH_NUM_MODES] = {"inline", "interleaved", "bank", "fixed"};
+
+/**
+ * @brief SIMD backend Heavy was compiled with
+ */
+static const char *simdName(void)
+{
+#if HV_SIMD_AVX
+    return HV_SIMD_FMA ? "AVX+FMA" : "AVX";
+#elif HV_SIMD_SSE
+    return "SSE4.1";
+#elif HV_SIMD_NEON
+    return "NEON";
+#elif HV_SIMD_M33
+    return "Cortex-M33";
+#else
+    return "scalar";
+#endif
+}
+
+/**
+ * @brief Monotonic time stamp (host: nanoseconds, RP2350: clk_sys cycles)
+ */
+static inline uint64_t benchNow(void)
+{
+#if PICO_ON_DEVICE
+    return cycleProfilerNow();
+#else
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+#endif
+}
+
+/**
+ * @brief Elapsed time between two stamps (the 32-bit cycle counter wraps every ~28 s)
+ */
+static inline uint64_t benchElapsed(uint64_t start, uint64_t end)
+{
+#if PICO_ON_DEVICE
+    return (uint32_t)((uint32_t)end - (uint32_t)start);
+#else
+    return end - start;
+#endif
+}
+
+/**
+ * @brief Process one block of every voice
+ */
+static inline void processBlock(BenchMode mode, int blockSize, int numVoices, HeavyContextInterface *bank)
+{
+    if (mode == BENCH_BANK)
+    {
+        hv_processInline(bank, NULL, outputBuffer, blockSize);
+        return;
+    }
+    for (int v = 0; v < numVoices; v++)
+    {
+        if (mode == BENCH_FIXED)
+        {
+            hv_440tone_process_block(voices[v], outputBuffer);
+        }
+        else if (mode == BENCH_INTERLEAVED)
+        {
+            hv_processInlineInterleaved(voices[v], NULL, outputBuffer, blockSize);
+        }
+        else
+        {
+            hv_processInline(voices[v], NULL, outputBuffer, blockSize);
+        }
+    }
+}
+
+/**
+ * @brief Process BENCH_FRAMES frames of numVoices voices
+ * @param bank Voice bank of numVoices voices (BENCH_BANK only)
+ * @return Elapsed time in benchNow() units
+ */
+static uint64_t runConfig(BenchMode mode, int blockSize, int numVoices, HeavyContextInterface *bank)
+{
+    const int numBlocks = BENCH_FRAMES / blockSize;
+
+    // Warm caches and the message queues before timing
+    for (int b = 0; b < 16; b++)
+    {
+        processBlock(mode, blockSize, numVoices, bank);
+    }
+
+    float acc = 0.0f;
+    const uint64_t start = benchNow();
+    for (int b = 0; b < numBlocks; b++)
+    {
+        processBlock(mode, blockSize, numVoices, bank);
+        acc += outputBuffer[0];
+    }
+    const uint64_t elapsed = benchElapsed(start, benchNow());
+    sink = acc;
+    return elapsed;
+}
+
+/**
+ * @brief Run the whole grid and print it
+ * @param csv One comma-separated line per configuration instead of the table
+ * @param unitsPerNs Time stamp units per nanosecond (1 on the host, clk_sys GHz on the RP2350)
+ */
+static void runSuite(bool csv, double unitsPerNs)
+{
+    for (int v = 0; v < BENCH_MAX_VOICES; v++)
+    {
+        voices[v] = hv_440tone_new(BENCH_SAMPLE_RATE);
+    }
+    for (size_t vi = 0; vi < BENCH_NUM_VOICE_COUNTS; vi++)
+    {
+        banks[vi] = hv_440tone_bank_new(BENCH_SAMPLE_RATE, voiceCounts[vi]);
+    }
+
+    if (csv)
+    {
+        printf("mode,block,voices,ns_per_sample,msamples_per_s,realtime,cycles_per_sample\n");
+    }
+    else
+    {
+        printf("\n=== Heavy 440tone benchmark ===\n");
+        printf("SIMD: %s | Sample rate: %.0f Hz | %d frames per voice\n", simdName(), BENCH_SAMPLE_RATE,
+               BENCH_FRAMES);
+        printf("%-12s %6s %6s %12s %12s %12s %14s\n", "mode", "block", "voices", "ns/sample", "Msamples/s",
+               "realtime", "cycles/sample");
+    }
+
+    for (int pass = 0; pass < BENCH_NUM_MODES; pass++)
+    {
+        const BenchMode benchMode = (BenchMode)pass;
+        for (size_t bi = 0; bi < sizeof(blockSizes) / sizeof(blockSizes[0]); bi++)
+        {
+            for (size_t vi = 0; vi < BENCH_NUM_VOICE_COUNTS; vi++)
+            {
+                const int blockSize = blockSizes[bi];
+                const int numVoices = voiceCounts[vi];
+                if (benchMode == BENCH_FIXED && blockSize != HV_440TONE_BLOCK_SIZE)
+                {
+                    continue; // Only one block size is compiled
+                }
+                const uint64_t elapsed = runConfig(benchMode, blockSize, numVoices, banks[vi]);
+
+                const double frames = (double)(BENCH_FRAMES / blockSize) * blockSize * numVoices;
+                const double ns = elapsed / unitsPerNs;
+                const double nsPerSample = ns / frames;
+                const double msps = frames / ns * 1000.0;
+                const double realtime = msps * 1e6 / (BENCH_SAMPLE_RATE * numVoices);
+                const char *mode = modeNames[benchMode];
+
+                if (csv)
+                {
+                    printf("%s,%d,%d,%.3f,%.3f,%.1f,", mode, blockSize, numVoices, nsPerSample, msps, realtime);
+                }
+                else
+                {
+                    printf("%-12s %6d %6d %12.3f %12.3f %11.1fx ", mode, blockSize, numVoices, nsPerSample, msps,
+                           realtime);
+                }
+#if PICO_ON_DEVICE
+                // Only the RP2350 time stamps are cycles
+                printf(csv ? "%.1f\n" : "%14.1f\n", elapsed / frames);
+#else
+                printf(csv ? "\n" : "%14s\n", "-");
+#endif
+            }
+        }
+    }
+
+    for (int v = 0; v < BENCH_MAX_VOICES; v++)
+    {
+        hv_delete(voices[v]);
+        voices[v] = NULL;
+    }
+    for (size_t vi = 0; vi < BENCH_NUM_VOICE_COUNTS; vi++)
+    {
+        hv_440tone_bank_free(banks[vi]);
+        banks[vi] = NULL;
+    }
+}
+
+#if PICO_ON_DEVICE
+int main()
+{
+    stdio_init_all();
+    sleep_ms(2000); // Wait for the serial terminal
+
+    cycleProfilerInit();
+    const uint32_t sysHz = clock_get_hz(clk_sys);
+    printf("clk_sys: %lu Hz\n", sysHz);
+    runSuite(false, sysHz / 1e9);
+
+    while (true)
+    {
+        sleep_ms(1000);
+    }
+    return 0;
+}
+#else
+int main(int argc, char **argv)
+{
+    const bool csv = argc > 1 && strcmp(argv[1], "--csv") == 0;
+    runSuite(csv, 1.0);
+    return 0;
+}
+#endif
@@ -0,0 +1,19 @@
+# Heavy 440tone audio engine source files, shared by the Pico firmware and the host benchmark (bench/)
+# Kept outside 440tone_c/ so a fresh Heavy export does not remove it
+set(HEAVY_440_DIR ${CMAKE_CURRENT_LIST_DIR}/../440tone_c)
+set(HEAVY_440_SOURCES
+    ${HEAVY_440_DIR}/Heavy_440tone.cpp
+    ${HEAVY_440_DIR}/Heavy_440toneBank.cpp
+    ${HEAVY_440_DIR}/HeavyContext.cpp
+    ${HEAVY_440_DIR}/HvHeavy.cpp
+    ${HEAVY_440_DIR}/HvLightPipe.c
+    ${HEAVY_440_DIR}/HvMessage.c
+    ${HEAVY_440_DIR}/HvMessagePool.c
+    ${HEAVY_440_DIR}/HvMessageQueue.c
+    ${HEAVY_440_DIR}/HvParameterBlock.c
+    ${HEAVY_440_DIR}/HvSignalPhasor.c
+    ${HEAVY_440_DIR}/HvSignalVar.c
+    ${HEAVY_440_DIR}/HvTable.c
+    ${HEAVY_440_DIR}/HvUtils.c
+    ${HEAVY_440_DIR}/HvArena.c
+)
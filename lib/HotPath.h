@@ -0,0 +1,31 @@
+/**
+ * @file HotPath.h
+ * @brief SRAM placement of the real-time audio path (HOT_PATH_IN_RAM)
+ * @author Ale Moglia
+ * @date 2026
+ *
+ * Functions defined as HOT_FUNC(name) go into the SDK's .time_critical.<name> sections,
+ * which the crt0 copies from flash to SRAM at boot, so they never wait for an XIP cache
+ * refill from QSPI. The Heavy side of the path uses HV_HOT() (HvUtils.h), switched on by
+ * HV_HOT_IN_RAM. Inline functions end up wherever their caller is.
+ *
+ * With HOT_PATH_IN_RAM=0 (default) HOT_FUNC(name) is just name and everything runs
+ * from flash through the XIP cache.
+ */
+
+#ifndef HOT_PATH_H
+#define HOT_PATH_H
+
+#include "pico/platform.h"
+
+#ifndef HOT_PATH_IN_RAM
+#define HOT_PATH_IN_RAM 0
+#endif
+
+#if HOT_PATH_IN_RAM
+#define HOT_FUNC(name) __not_in_flash_func(name)
+#else
+#define HOT_FUNC(name) name
+#endif
+
+#endif // HOT_PATH_H
@@ -0,0 +1,315 @@
+/**
+ * @file ControlScanner.cpp
+ * @brief ADC121C027 pot/CV scanner sharing I2C1 with the streaming MCP4725 DAC
+ * @author Ale Moglia
+ * @date 2026
+ */
+
+#include "ControlScanner.h"
+#include <stdio.h>
+#include "hardware/irq.h"
+#include "../HotPath.h"
+
+const ControlScanner::Channel ControlScanner::CHANNELS[ControlScanner::NUM_CHANNELS] = {
+    {true, CV_MIN_CHANNEL, "cv_min"},
+    {true, CV_MAX_CHANNEL, "cv_max"},
+    {true, CV_ATTRACTOR_CHANNEL, "cv_attractor"},
+    {true, CV_ENTROPY_CHANNEL, "cv_entropy"},
+    {false, POT_MIN_CHANNEL, "pot_min"},
+    {false, POT_MAX_CHANNEL, "pot_max"},
+    {false, POT_ATTRACTOR_CHANNEL, "pot_attractor"},
+    {false, POT_ENTROPY_CHANNEL, "pot_entropy"},
+    {false, POT_CLOCK_CHANNEL, "pot_clock"},
+};
+
+ControlScanner *ControlScanner::instance_ = nullptr;
+
+ControlScanner::ControlScanner()
+    : initialized_(false), running_(false), readIntervalUs_(0), periodUs_(0), dacTransferUs_(0), readUs_(0),
+      muxMask_((1u << MUX_A0_PIN) | (1u << MUX_A1_PIN) | (1u << MUX_A2_PIN) | (1u << CVPOT_CONTROL_PIN)),
+      lastTickUs_(0), lastReadUs_(0), adcActive_(false), restorePending_(false), current_(0),
+      reads_(0), skipped_(0), errors_(0), collisions_(0)
+{
+    for (int i = 0; i < NUM_CHANNELS; i++)
+    {
+        raw_[i] = 0;
+        seq_[i] = 0;
+    }
+}
+
+ControlScanner::~ControlScanner()
+{
+    end();
+}
+
+bool ControlScanner::init()
+{
+    if (initialized_)
+    {
+        return true;
+    }
+
+    // Mux address and DG469 select pins (the I2C pins are set up by the DAC driver)
+    gpio_init_mask(muxMask_);
+    gpio_set_dir_out_masked(muxMask_);
+
+    // Point the ADC at its conversion result register, every later read is just 2 bytes
+    uint8_t reg = REG_CONVERSION;
+    if (i2c_write_blocking(ADC_I2C_PORT, ADC_I2C_ADDRESS, &reg, 1, false) != 1)
+    {
+        printf("ControlScanner: ADC121C027 not responding at 0x%02X\n", ADC_I2C_ADDRESS);
+        return false;
+    }
+
+    // One blocking pass over every channel: valid values from the start and the read time
+    uint8_t buf[2];
+    for (int i = 0; i < NUM_CHANNELS; i++)
+    {
+        selectChannel(i);
+        sleep_us(20); // TMUX4051 + DG469 settling
+
+        const uint32_t start = time_us_32();
+        if (i2c_read_blocking(ADC_I2C_PORT, ADC_I2C_ADDRESS, buf, 2, false) != 2)
+        {
+            printf("ControlScanner: ADC read failed on %s\n", CHANNELS[i].name);
+            return false;
+        }
+        const uint32_t elapsed = time_us_32() - start;
+        if (elapsed > readUs_)
+        {
+            readUs_ = elapsed;
+        }
+        store(i, (uint16_t)(((buf[0] & 0x0F) << 8) | buf[1]));
+    }
+
+    current_ = 0;
+    selectChannel(current_);
+    initialized_ = true;
+    printf("ControlScanner: %d channels, ADC read %lu us\n", NUM_CHANNELS, readUs_);
+    return true;
+}
+
+bool ControlScanner::begin(uint32_t readRateHz, uint32_t dacPeriodUs, uint32_t dacTransferUs)
+{
+    if (!initialized_ || running_ || readRateHz == 0 || dacPeriodUs == 0)
+    {
+        return false;
+    }
+
+    readIntervalUs_ = 1000000 / readRateHz;
+    periodUs_ = dacPeriodUs;
+    dacTransferUs_ = dacTransferUs;
+    lastTickUs_ = time_us_32();
+    lastReadUs_ = lastTickUs_;
+    instance_ = this;
+
+    printf("ControlScanner: slot %lu us = DAC %lu us + gap %ld us, ADC read needs %lu + %d us guard: %s\n",
+           periodUs_, dacTransferUs_, (long)periodUs_ - (long)dacTransferUs_, readUs_, CONTROL_SCAN_GUARD_US,
+           fits() ? "fits" : "does NOT fit, controls will not update");
+
+    // STOP_DET marks the end of every transaction on the bus, DAC or ADC
+    i2c_hw_t *hw = i2c_get_hw(ADC_I2C_PORT);
+    hw->intr_mask = I2C_IC_INTR_MASK_M_STOP_DET_BITS;
+    (void)hw->clr_stop_det;
+
+    const uint irq = I2C0_IRQ + i2c_get_index(ADC_I2C_PORT);
+    irq_set_exclusive_handler(irq, i2cIrqHandler);
+    irq_set_enabled(irq, true);
+
+    running_ = true;
+    return true;
+}
+
+void ControlScanner::end()
+{
+    if (!running_)
+    {
+        return;
+    }
+    running_ = false;
+
+    // Let an ADC read in flight finish and hand the target back to the DAC
+    while (adcOwnsBus())
+    {
+        tight_loop_contents();
+    }
+
+    const uint irq = I2C0_IRQ + i2c_get_index(ADC_I2C_PORT);
+    irq_set_enabled(irq, false);
+    irq_remove_handler(irq, i2cIrqHandler);
+    i2c_get_hw(ADC_I2C_PORT)->intr_mask = 0;
+    instance_ = nullptr;
+}
+
+bool ControlScanner::fits() const
+{
+    return periodUs_ >= dacTransferUs_ + readUs_ + CONTROL_SCAN_GUARD_US;
+}
+
+uint16_t ControlScanner::getRaw(int channel) const
+{
+    return raw_[channel];
+}
+
+float HOT_FUNC(ControlScanner::getValue)(int channel) const
+{
+    const float unit = raw_[channel] * (1.0f / 4095.0f);
+    return CHANNELS[channel].cv ? unit * 2.0f - 1.0f : unit;
+}
+
+uint32_t HOT_FUNC(ControlScanner::getSequence)(int channel) const
+{
+    return seq_[channel];
+}
+
+uint32_t ControlScanner::getReadCount() const
+{
+    return reads_;
+}
+
+uint32_t ControlScanner::getSkippedCount() const
+{
+    return skipped_;
+}
+
+uint32_t ControlScanner::getErrorCount() const
+{
+    return errors_;
+}
+
+uint32_t ControlScanner::getCollisionCount() const
+{
+    return collisions_;
+}
+
+uint32_t ControlScanner::getReadUs() const
+{
+    return readUs_;
+}
+
+void ControlScanner::printStatus() const
+{
+    printf("  Controls: reads %lu | skipped %lu | errors %lu | collisions %lu |", reads_, skipped_, errors_,
+           collisions_);
+    for (int i = 0; i < NUM_CHANNELS; i++)
+    {
+        printf(" %u", raw_[i]);
+    }
+    printf("\n");
+}
+
+void HOT_FUNC(ControlScanner::i2cIrqHandler)()
+{
+    if (instance_ != nullptr)
+    {
+        instance_->handleStop();
+    }
+}
+
+void HOT_FUNC(ControlScanner::handleStop)()
+{
+    i2c_hw_t *hw = i2c_get_hw(ADC_I2C_PORT);
+    (void)hw->clr_stop_det;
+
+    if (adcActive_)
+    {
+        // Our read just ended: collect it before the target switch flushes the FIFOs
+        const bool aborted = (hw->raw_intr_stat & I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS) != 0;
+        if (!aborted && hw->rxflr >= 2)
+        {
+            const uint8_t high = (uint8_t)hw->data_cmd; // Alert flag, reserved, D11-D8
+            const uint8_t low = (uint8_t)hw->data_cmd;  // D7-D0
+            store(current_, (uint16_t)(((high & 0x0F) << 8) | low));
+            reads_++;
+        }
+        else
+        {
+            // A NAK leaves the TX FIFO held in abort until it is cleared
+            errors_++;
+            if (aborted)
+            {
+                (void)hw->clr_tx_abrt;
+            }
+            while (hw->rxflr != 0)
+            {
+                (void)hw->data_cmd;
+            }
+        }
+        adcActive_ = false;
+
+        if ((hw->status & I2C_IC_STATUS_MST_ACTIVITY_BITS) != 0 || hw->txflr != 0)
+        {
+            // A paced DAC sample was queued before the read finished, it goes out to the
+            // ADC address; restore the target once it is off the bus
+            collisions_++;
+            restorePending_ = true;
+        }
+        else
+        {
+            setTarget(hw, DAC_I2C_ADDRESS);
+        }
+
+        // Next channel: the mux settles for a whole read interval
+        current_ = (current_ + 1 == NUM_CHANNELS) ? 0 : current_ + 1;
+        selectChannel(current_);
+        return;
+    }
+
+    if (restorePending_)
+    {
+        if ((hw->status & I2C_IC_STATUS_MST_ACTIVITY_BITS) == 0 && hw->txflr == 0)
+        {
+            setTarget(hw, DAC_I2C_ADDRESS);
+            restorePending_ = false;
+        }
+        return;
+    }
+
+    // A DAC transfer just ended: start a read if one is due and it ends before the next slot
+    const uint32_t now = time_us_32();
+    if (!running_ || now - lastReadUs_ < readIntervalUs_)
+    {
+        return;
+    }
+    const uint32_t untilNextTick = periodUs_ - (now - lastTickUs_) % periodUs_;
+    if (untilNextTick < readUs_ + CONTROL_SCAN_GUARD_US || hw->txflr != 0)
+    {
+        skipped_++;
+        return;
+    }
+
+    lastReadUs_ = now;
+    adcActive_ = true;
+    setTarget(hw, ADC_I2C_ADDRESS);
+    hw->data_cmd = I2C_IC_DATA_CMD_CMD_BITS;
+    hw->data_cmd = I2C_IC_DATA_CMD_CMD_BITS | I2C_IC_DATA_CMD_STOP_BITS;
+}
+
+void HOT_FUNC(ControlScanner::selectChannel)(int channel)
+{
+    const Channel &c = CHANNELS[channel];
+    uint32_t value = 0;
+    value |= (c.mux & 1u) ? (1u << MUX_A0_PIN) : 0;
+    value |= (c.mux & 2u) ? (1u << MUX_A1_PIN) : 0;
+    value |= (c.mux & 4u) ? (1u << MUX_A2_PIN) : 0;
+    value |= c.cv ? (1u << CVPOT_CONTROL_PIN) : 0; // DG469: HIGH = CV MUX, LOW = POT MUX
+    gpio_put_masked(muxMask_, value);
+}
+
+void HOT_FUNC(ControlScanner::store)(int channel, uint16_t value)
+{
+    const int delta = (int)value - (int)raw_[channel];
+    if (seq_[channel] == 0 || delta > CONTROL_SCAN_HYSTERESIS || delta < -CONTROL_SCAN_HYSTERESIS)
+    {
+        raw_[channel] = value;
+        seq_[channel] = seq_[channel] + 1; // Value first, then the sequence the consumer polls
+    }
+}
+
+void HOT_FUNC(ControlScanner::setTarget)(i2c_hw_t *hw, uint8_t address)
+{
+    // IC_TAR can only be written with the controller disabled (same as MCP4725::beginAsync)
+    hw->enable = 0;
+    hw->tar = address;
+    hw->enable = 1;
+}
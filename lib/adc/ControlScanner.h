@@ -0,0 +1,239 @@
+/**
+ * @file ControlScanner.h
+ * @brief ADC121C027 pot/CV scanner sharing I2C1 with the streaming MCP4725 DAC
+ * @author Ale Moglia
+ * @date 2026
+ *
+ * The DAC and the ADC121C027 sit on the same I2C1 bus. Once the DAC is streaming, the
+ * scanner acts as the bus arbiter: an I2C STOP_DET interrupt marks the end of every DAC
+ * transfer, and if a control read is due and the time left before the next DAC slot
+ * covers a whole ADC read plus a guard time, the scanner switches the target address to
+ * the ADC and issues a 2-byte conversion read. The end of that read (the next STOP_DET)
+ * stores the value, switches the target back to the DAC and moves the TMUX4051/DG469
+ * selection on to the next channel, so the mux has a whole control period to settle.
+ *
+ * A read is never started when it would not finish before the next DAC sample, so the
+ * DAC timing is left untouched. Gaps that are too short are counted as skipped reads.
+ *
+ * The DAC side reports its sample clock so the scanner knows where the next slot starts:
+ * claimDacSlot() from the per-sample timer IRQ (which also refuses the slot if a read is
+ * somehow still on the bus), or markDacTick() with the tick of the last sample of each
+ * DMA-paced block.
+ *
+ * Values are published per channel with a sequence number that only changes when the
+ * reading moved by more than CONTROL_SCAN_HYSTERESIS, so the consumer can poll
+ * lock-free from either core.
+ */
+
+#ifndef CONTROL_SCANNER_H
+#define CONTROL_SCANNER_H
+
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+#include "../hardware.h"
+
+// Minimum change in ADC counts before a channel is republished (filters ADC noise)
+#ifndef CONTROL_SCAN_HYSTERESIS
+#define CONTROL_SCAN_HYSTERESIS 4
+#endif
+
+// Extra microseconds an ADC read must leave before the next DAC slot (IRQ latency, clock stretching)
+#ifndef CONTROL_SCAN_GUARD_US
+#define CONTROL_SCAN_GUARD_US 3
+#endif
+
+/**
+ * @brief Round-robin ADC121C027 reader for the CV and pot multiplexers
+ */
+class ControlScanner
+{
+public:
+    /**
+     * @brief One scanned multiplexer input
+     */
+    struct Channel
+    {
+        bool cv;          ///< true = CV MUX (bipolar), false = POT MUX (unipolar)
+        uint8_t mux;      ///< TMUX4051 channel 0-7
+        const char *name; ///< Status output and Heavy receiver name
+    };
+
+    // Used channels of both multiplexers (CV 4-7 and POT 5-7 are not connected)
+    static const int NUM_CHANNELS = 9;
+    static const Channel CHANNELS[NUM_CHANNELS];
+
+    /**
+     * @brief Constructor
+     */
+    ControlScanner();
+
+    /**
+     * @brief Destructor
+     */
+    ~ControlScanner();
+
+    /**
+     * @brief Set up the mux pins and the ADC (blocking I2C, call before the DAC streams)
+     *
+     * Selects the conversion result register, reads every channel once so the values are
+     * valid from the start, and times one blocking read as the ADC slot length.
+     *
+     * @return true if the ADC acknowledged, false otherwise
+     */
+    bool init();
+
+    /**
+     * @brief Start interleaving reads between DAC transfers
+     * @param readRateHz ADC reads per second (each channel is read at readRateHz / NUM_CHANNELS)
+     * @param dacPeriodUs DAC sample period in microseconds
+     * @param dacTransferUs Duration of one DAC transfer, only used to report whether reads fit
+     * @return true if started, false if not initialized
+     */
+    bool begin(uint32_t readRateHz, uint32_t dacPeriodUs, uint32_t dacTransferUs);
+
+    /**
+     * @brief Stop scanning and hand the bus back to the DAC
+     */
+    void end();
+
+    /**
+     * @brief Report a DAC sample tick (DMA block mode: the last sample of each paced block)
+     * @param tickUs time_us_32() at (or just after) the tick
+     */
+    inline void markDacTick(uint32_t tickUs)
+    {
+        lastTickUs_ = tickUs;
+    }
+
+    /**
+     * @brief Report a DAC sample tick and check the bus is free for it (timer IRQ mode)
+     * @param tickUs time_us_32() at the tick
+     * @return true if the DAC may start its transfer, false (counted as a collision) if the ADC still owns the bus
+     */
+    inline bool claimDacSlot(uint32_t tickUs)
+    {
+        lastTickUs_ = tickUs;
+        if (adcOwnsBus())
+        {
+            collisions_++;
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Check if the bus is addressed to the ADC (the DAC must not start a transfer)
+     */
+    inline bool adcOwnsBus() const
+    {
+        return adcActive_ || restorePending_;
+    }
+
+    /**
+     * @brief Check if a whole ADC read fits in the gap after a DAC transfer
+     */
+    bool fits() const;
+
+    /**
+     * @brief Latest raw 12-bit reading of a channel
+     */
+    uint16_t getRaw(int channel) const;
+
+    /**
+     * @brief Latest reading scaled to 0..1 (POT) or -1..+1 (CV)
+     */
+    float getValue(int channel) const;
+
+    /**
+     * @brief Publish sequence of a channel, changes when a new value is available
+     */
+    uint32_t getSequence(int channel) const;
+
+    /**
+     * @brief Number of completed ADC reads
+     */
+    uint32_t getReadCount() const;
+
+    /**
+     * @brief Number of due reads postponed because the gap before the next DAC slot was too short
+     */
+    uint32_t getSkippedCount() const;
+
+    /**
+     * @brief Number of failed reads (NAK or short read)
+     */
+    uint32_t getErrorCount() const;
+
+    /**
+     * @brief Number of times a DAC slot started while the ADC still owned the bus
+     */
+    uint32_t getCollisionCount() const;
+
+    /**
+     * @brief Measured duration of one blocking ADC read in microseconds
+     */
+    uint32_t getReadUs() const;
+
+    /**
+     * @brief Print the slot budget and the counters
+     */
+    void printStatus() const;
+
+private:
+    // ADC121C027 registers
+    static const uint8_t REG_CONVERSION = 0x00; ///< Conversion result register (pointer value)
+
+    bool initialized_;
+    bool running_;
+    uint32_t readIntervalUs_;
+    uint32_t periodUs_;
+    uint32_t dacTransferUs_;
+    uint32_t readUs_;  ///< Measured ADC read duration
+    uint32_t muxMask_; ///< MUX_A0..A2 and CVPOT_CONTROL_PIN
+
+    // Scan state (I2C IRQ only, lastTickUs_ written by the DAC IRQ)
+    volatile uint32_t lastTickUs_;
+    volatile uint32_t lastReadUs_;
+    volatile bool adcActive_;      ///< ADC read on the bus, TAR = ADC
+    volatile bool restorePending_; ///< A DAC transfer started early, restore TAR on its STOP
+    int current_;                  ///< Channel being read
+
+    // Published values
+    volatile uint16_t raw_[NUM_CHANNELS];
+    volatile uint32_t seq_[NUM_CHANNELS];
+
+    // Statistics
+    volatile uint32_t reads_;
+    volatile uint32_t skipped_;
+    volatile uint32_t errors_;
+    volatile uint32_t collisions_;
+
+    static ControlScanner *instance_;
+
+    /**
+     * @brief I2C1 IRQ handler (STOP_DET)
+     */
+    static void i2cIrqHandler();
+
+    /**
+     * @brief End of a bus transaction: collect an ADC read or start one in the gap
+     */
+    void handleStop();
+
+    /**
+     * @brief Drive the mux address and DG469 pins for a channel
+     */
+    void selectChannel(int channel);
+
+    /**
+     * @brief Store a reading and republish it if it moved past the hysteresis
+     */
+    void store(int channel, uint16_t value);
+
+    /**
+     * @brief Set the I2C target address (controller must be idle)
+     */
+    static void setTarget(i2c_hw_t *hw, uint8_t address);
+};
+
+#endif // CONTROL_SCANNER_H
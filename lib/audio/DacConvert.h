@@ -0,0 +1,154 @@
+/**
+ * @file DacConvert.h
+ * @brief Block conversion from Heavy float samples to MCP4725 I2C data_cmd words
+ * @author Ale Moglia
+ * @date 2026
+ *
+ * Converts a whole processing block in one pass: 12-bit quantisation (optionally TPDF
+ * dithered) with branchless integer saturation and MCP4725 fast-write formatting, so the output IRQ only
+ * has to copy or DMA ready-made words.
+ *
+ * DAC_STREAM selects the word format: 0 = write DAC command with a STOP per sample
+ * (MCP4725::WIRE_WRITE_DAC), 1 = 2-byte fast-mode samples of one open transaction
+ * (MCP4725::WIRE_FAST_STREAM).
+ */
+
+#ifndef DAC_CONVERT_H
+#define DAC_CONVERT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// MCP4725 bus format: 0 = address + 3 bytes + STOP per sample, 1 = one open transaction of 2-byte samples
+#ifndef DAC_STREAM
+#define DAC_STREAM 0
+#endif
+
+#if DAC_STREAM
+// MCP4725 fast mode inside one transaction: 2 data bytes = 2 x 16-bit I2C data_cmd words per sample
+#define DAC_WORDS_PER_SAMPLE 2
+#else
+// MCP4725 fast-write: command byte + 2 data bytes = 3 x 16-bit I2C data_cmd words per sample
+#define DAC_WORDS_PER_SAMPLE 3
+#endif
+
+/**
+ * @brief Saturate a signed value to the unsigned 12-bit DAC range [0, 4095]
+ *
+ * Single USAT instruction on the Cortex-M33, portable fallback elsewhere.
+ */
+static inline uint32_t dacSaturate12(int32_t value)
+{
+#if defined(__ARM_FEATURE_SAT) || defined(__ARM_ARCH_8M_MAIN__)
+    uint32_t result;
+    __asm__("usat %0, #12, %1" : "=r"(result) : "r"(value));
+    return result;
+#else
+    return (uint32_t)(value < 0 ? 0 : (value > 4095 ? 4095 : value));
+#endif
+}
+
+/**
+ * @brief Truncate a scaled sample (nominal [0, 4095]) to a 12-bit DAC code, saturating
+ *
+ * On the M33, VCVT truncates toward zero and saturates to the int32 range by itself, then
+ * USAT clamps to 12 bits: no float clamp, no branches. A NaN gives 0. The portable
+ * fallback clamps before the conversion, which is undefined out of range in C.
+ */
+static inline uint16_t dacQuantize(float scaled)
+{
+#if defined(__ARM_FP) && defined(__ARM_ARCH_8M_MAIN__)
+    int32_t value;
+    __asm__("vcvt.s32.f32 %1, %1\n\tvmov %0, %1" : "=r"(value), "+t"(scaled));
+    return (uint16_t)dacSaturate12(value);
+#else
+    return (uint16_t)(scaled <= 0.0f ? 0 : (scaled >= 4095.0f ? 4095 : (int32_t)scaled));
+#endif
+}
+
+/**
+ * @brief Convert float audio sample (-1.0 to +1.0) to 12-bit DAC value
+ */
+static inline uint16_t audioToDAC(float sample)
+{
+    // Convert from [-1.0, +1.0] to [0, 4095], out-of-range samples saturate
+    return dacQuantize((sample + 1.0f) * 2047.5f);
+}
+
+/**
+ * @brief Format a 12-bit DAC value as an MCP4725 fast-write I2C data_cmd sequence
+ *
+ * DAC_STREAM = 0: words[0] = 0x40 (write DAC register), words[1] = D11-D4, words[2] = D3-D0<<4 | STOP
+ * DAC_STREAM = 1: words[0] = 0000 D11-D8 (fast mode, PD = 00), words[1] = D7-D0, no STOP
+ */
+static inline void formatDacWords(uint16_t dacValue, uint16_t *words)
+{
+#if DAC_STREAM
+    words[0] = (dacValue >> 8) & 0x0F;
+    words[1] = dacValue & 0xFF;
+#else
+    words[0] = 0x40;
+    words[1] = (dacValue >> 4) & 0xFF;
+    words[2] = ((dacValue << 4) & 0xF0) | 0x200;
+#endif
+}
+
+/**
+ * @brief TPDF dither generator for the 12-bit truncation
+ *
+ * Each call sums two independent uniform values of ±0.5 LSB (taken from the two
+ * halves of one xorshift32 output), giving triangular noise in (-1, +1) LSB.
+ */
+struct TpdfDither
+{
+    uint32_t state;
+
+    explicit TpdfDither(uint32_t seed = 0x1234567u) : state(seed ? seed : 1u) {}
+
+    /**
+     * @brief Next dither value
+     * @return Dither in DAC LSBs, range (-1.0, +1.0)
+     */
+    inline float next()
+    {
+        uint32_t x = state;
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        state = x;
+        const int32_t sum = (int32_t)(x >> 16) + (int32_t)(x & 0xFFFF) - 0xFFFF;
+        return (float)sum * (1.0f / 65536.0f);
+    }
+};
+
+/**
+ * @brief Convert a block of float samples straight into MCP4725 data_cmd words
+ *
+ * Without dither the result is bit-identical to formatDacWords(audioToDAC(x)) for every
+ * sample. With dither the noise is added before truncation. Both go through dacQuantize().
+ *
+ * @param samples Input samples, nominal range [-1.0, +1.0]
+ * @param words Output, DAC_WORDS_PER_SAMPLE words per sample
+ * @param count Number of samples
+ * @param dither TPDF dither generator, or NULL for plain truncation
+ * @param stride Words from one sample to the next (larger when several DACs share a sample record)
+ */
+static inline void audioBlockToDacWords(const float *samples, uint16_t *words, uint32_t count,
+                                        TpdfDither *dither = NULL, uint32_t stride = DAC_WORDS_PER_SAMPLE)
+{
+    if (dither == NULL)
+    {
+        for (uint32_t i = 0; i < count; i++)
+        {
+            formatDacWords(audioToDAC(samples[i]), &words[i * stride]);
+        }
+        return;
+    }
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        formatDacWords(dacQuantize((samples[i] + 1.0f) * 2047.5f + dither->next()), &words[i * stride]);
+    }
+}
+
+#endif // DAC_CONVERT_H
@@ -0,0 +1,260 @@
+/**
+ * @file DeadlineMonitor.h
+ * @brief Per-block deadline check of the producer, with stepwise load shedding and recovery
+ * @author Ale Moglia
+ * @date 2026
+ *
+ * A patch that needs more than a block period per block does not fail at once: every
+ * block finishes a little later, the output queue drains, and only then do the underruns
+ * click. addBlock() sees each output block as it is produced, with the time the producer
+ * spent on it and the slack (samples still queued ahead of it), and keeps a running load
+ * (time / block period, one-pole smoothed).
+ *
+ * The caller defines what the shed steps are (step 0 = everything rendered) and applies
+ * getStep() when it renders. The next step is taken when the load passes
+ * DEADLINE_MONITOR_HIGH_PCT. It is taken at once when DEADLINE_MONITOR_SHORT_SLACK_BLOCKS
+ * blocks in a row are published with less than DEADLINE_MONITOR_MIN_SLACK_PCT of a block
+ * of slack and each of them took the producer over DEADLINE_MONITOR_HIGH_PCT itself.
+ * Short slack behind blocks that rendered quickly means something else held the
+ * producer up (a blocking printf on its core, say): it is counted, but shedding DSP
+ * would not help, so no step is taken. After each step up the monitor waits
+ * DEADLINE_MONITOR_SETTLE_BLOCKS blocks so the step can take effect before it judges
+ * again. It steps back down once the load has stayed under DEADLINE_MONITOR_LOW_PCT for
+ * DEADLINE_MONITOR_RECOVER_BLOCKS blocks in a row. The gap between the two thresholds
+ * must be wider than the saving of one step, or it toggles.
+ *
+ * Producer-side object: addBlock() must always be called from the same core. The
+ * counters may be read from anywhere.
+ */
+
+#ifndef DEADLINE_MONITOR_H
+#define DEADLINE_MONITOR_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+// Smoothed load (producer time / block period) above which the next shed step is taken
+#ifndef DEADLINE_MONITOR_HIGH_PCT
+#define DEADLINE_MONITOR_HIGH_PCT 85
+#endif
+
+// Smoothed load under which a step is given back, once it has lasted DEADLINE_MONITOR_RECOVER_BLOCKS
+#ifndef DEADLINE_MONITOR_LOW_PCT
+#define DEADLINE_MONITOR_LOW_PCT 35
+#endif
+
+// Blocks in a row under DEADLINE_MONITOR_LOW_PCT before one step is given back (625 = 1s at 40kHz / 64)
+#ifndef DEADLINE_MONITOR_RECOVER_BLOCKS
+#define DEADLINE_MONITOR_RECOVER_BLOCKS 625
+#endif
+
+// Blocks after a step up before the load is judged again
+#ifndef DEADLINE_MONITOR_SETTLE_BLOCKS
+#define DEADLINE_MONITOR_SETTLE_BLOCKS 8
+#endif
+
+// Slack under this share of a block counts as short
+#ifndef DEADLINE_MONITOR_MIN_SLACK_PCT
+#define DEADLINE_MONITOR_MIN_SLACK_PCT 50
+#endif
+
+// Short-slack blocks in a row, each over DEADLINE_MONITOR_HIGH_PCT itself, that take the next step at once
+#ifndef DEADLINE_MONITOR_SHORT_SLACK_BLOCKS
+#define DEADLINE_MONITOR_SHORT_SLACK_BLOCKS 2
+#endif
+
+// Load smoothing: each block moves the running load by 1 / 2^shift of its difference
+#ifndef DEADLINE_MONITOR_LOAD_SHIFT
+#define DEADLINE_MONITOR_LOAD_SHIFT 3
+#endif
+
+/**
+ * @brief Producer deadline monitor driving a ladder of shed steps
+ */
+class DeadlineMonitor
+{
+public:
+    DeadlineMonitor()
+    {
+        init(1, 1, nullptr, 1);
+    }
+
+    /**
+     * @brief Reset to step 0
+     * @param blockPeriodUs Time one output block plays for
+     * @param blockSamples Samples in one output block
+     * @param stepNames Name of each step, for printStatus() (step 0 first)
+     * @param numSteps Number of steps, step 0 included
+     */
+    void init(uint32_t blockPeriodUs, uint32_t blockSamples, const char *const *stepNames, int numSteps)
+    {
+        blockPeriodUs_ = blockPeriodUs;
+        minSlack_ = blockSamples * DEADLINE_MONITOR_MIN_SLACK_PCT / 100;
+        stepNames_ = stepNames;
+        numSteps_ = numSteps;
+        step_ = 0;
+        loadQ16_ = 0;
+        peakLoadQ16_ = 0;
+        settle_ = 0;
+        goodBlocks_ = 0;
+        overrunRun_ = 0;
+        blocks_ = 0;
+        lowSlack_ = 0;
+        stepUps_ = 0;
+        stepDowns_ = 0;
+        maxStep_ = 0;
+    }
+
+    /**
+     * @brief Account one output block and move the step (producer)
+     * @param busyUs Producer time this block took (0 for a block that was shed)
+     * @param slackSamples Samples still queued ahead of it when it was published
+     * @return the step change: +1, -1 or 0
+     */
+    int addBlock(uint32_t busyUs, uint32_t slackSamples)
+    {
+        blocks_ = blocks_ + 1;
+
+        const uint32_t blockLoadQ16 = (uint32_t)(((uint64_t)busyUs << 16) / blockPeriodUs_);
+        int32_t load = (int32_t)loadQ16_;
+        load += ((int32_t)blockLoadQ16 - load) >> DEADLINE_MONITOR_LOAD_SHIFT;
+        loadQ16_ = (uint32_t)load;
+        if (loadQ16_ > peakLoadQ16_)
+        {
+            peakLoadQ16_ = loadQ16_;
+        }
+
+        // Only the producer's own time makes a short slack an overrun
+        bool overrun = false;
+        if (slackSamples < minSlack_)
+        {
+            lowSlack_ = lowSlack_ + 1;
+            if (blockLoadQ16 > pctToQ16(DEADLINE_MONITOR_HIGH_PCT))
+            {
+                overrunRun_++;
+                overrun = overrunRun_ >= DEADLINE_MONITOR_SHORT_SLACK_BLOCKS;
+            }
+            else
+            {
+                overrunRun_ = 0;
+            }
+        }
+        else
+        {
+            overrunRun_ = 0;
+        }
+
+        if (settle_ > 0)
+        {
+            settle_--;
+            if (!overrun)
+            {
+                return 0; // The last step has not shown in the load yet
+            }
+        }
+
+        if (overrun || loadQ16_ > pctToQ16(DEADLINE_MONITOR_HIGH_PCT))
+        {
+            goodBlocks_ = 0;
+            overrunRun_ = 0;
+            if (step_ + 1 < numSteps_)
+            {
+                step_ = step_ + 1;
+                stepUps_ = stepUps_ + 1;
+                if (step_ > maxStep_)
+                {
+                    maxStep_ = step_;
+                }
+                settle_ = DEADLINE_MONITOR_SETTLE_BLOCKS;
+                return 1;
+            }
+            return 0; // Already at the last step
+        }
+
+        if (step_ > 0 && loadQ16_ < pctToQ16(DEADLINE_MONITOR_LOW_PCT))
+        {
+            if (++goodBlocks_ >= DEADLINE_MONITOR_RECOVER_BLOCKS)
+            {
+                goodBlocks_ = 0;
+                step_ = step_ - 1;
+                stepDowns_ = stepDowns_ + 1;
+                return -1;
+            }
+        }
+        else
+        {
+            goodBlocks_ = 0;
+        }
+        return 0;
+    }
+
+    /**
+     * @brief Shed step in force (0 = nothing shed)
+     */
+    inline int getStep() const
+    {
+        return step_;
+    }
+
+    /**
+     * @brief Smoothed producer load in percent of a block period
+     */
+    inline uint32_t getLoadPct() const
+    {
+        return (uint32_t)(((uint64_t)loadQ16_ * 100) >> 16);
+    }
+
+    /**
+     * @brief Number of blocks published with less than the minimum slack
+     */
+    inline uint32_t getLowSlackCount() const
+    {
+        return lowSlack_;
+    }
+
+    /**
+     * @brief Name of a step
+     */
+    inline const char *stepName(int step) const
+    {
+        return stepNames_ != nullptr && step >= 0 && step < numSteps_ ? stepNames_[step] : "?";
+    }
+
+    /**
+     * @brief Print the step, the load and the counters, and restart the peak load
+     */
+    void printStatus()
+    {
+        printf("  Deadline: step %d/%d (%s) | load %lu%%, peak %lu%% | short slack %lu of %lu blocks | "
+               "steps up/down %lu/%lu, deepest %s\n",
+               step_, numSteps_ - 1, stepName(step_), getLoadPct(),
+               (uint32_t)(((uint64_t)peakLoadQ16_ * 100) >> 16), lowSlack_, blocks_, stepUps_, stepDowns_,
+               stepName(maxStep_));
+        peakLoadQ16_ = loadQ16_;
+    }
+
+private:
+    static inline uint32_t pctToQ16(uint32_t pct)
+    {
+        return (pct << 16) / 100;
+    }
+
+    uint32_t blockPeriodUs_;
+    uint32_t minSlack_;
+    const char *const *stepNames_;
+    int numSteps_;
+
+    volatile int step_;
+    volatile uint32_t loadQ16_;     ///< Smoothed load, 1.0 = one block period per block
+    volatile uint32_t peakLoadQ16_; ///< Highest smoothed load since the last printStatus()
+    uint32_t settle_;               ///< Blocks left before the load is judged again
+    uint32_t goodBlocks_;           ///< Blocks in a row under DEADLINE_MONITOR_LOW_PCT
+    uint32_t overrunRun_;           ///< Short-slack blocks in a row that were over DEADLINE_MONITOR_HIGH_PCT
+    volatile uint32_t blocks_;
+    volatile uint32_t lowSlack_;
+    volatile uint32_t stepUps_;
+    volatile uint32_t stepDowns_;
+    volatile int maxStep_;
+};
+
+#endif // DEADLINE_MONITOR_H
@@ -0,0 +1,236 @@
+/**
+ * @file ElasticResampler.h
+ * @brief PI-controlled fractional resampler between the Heavy output and the DAC queue
+ * @author Ale Moglia
+ * @date 2026
+ *
+ * Heavy blocks are written into a small FIFO at the local HEAVY_SAMPLE_RATE, and DAC
+ * blocks are read from it at whatever rate the output clock actually runs. Every read
+ * compares the FIFO fill with a target and a PI controller trims the read step (input
+ * samples per output sample) until the two rates match, so the fill stays put instead of
+ * drifting into an underrun or an overrun. The step only moves by ppm, which is far below
+ * audible pitch changes, and the output keeps the local time base of the patch.
+ *
+ * Samples between input points are rebuilt with 4-point, 3rd-order Hermite interpolation.
+ *
+ * Producer-side object: write() and read() must be called from the same core.
+ */
+
+#ifndef ELASTIC_RESAMPLER_H
+#define ELASTIC_RESAMPLER_H
+
+#include <stdint.h>
+
+// FIFO capacity in samples, must be a power of 2
+#ifndef ELASTIC_FIFO_SIZE
+#define ELASTIC_FIFO_SIZE 512
+#endif
+
+// Proportional gain: step change per sample of fill error (3e-4 = 300 ppm per sample)
+#ifndef ELASTIC_KP
+#define ELASTIC_KP 3.0e-4f
+#endif
+
+// Integral gain: step change per sample of accumulated error, per read
+#ifndef ELASTIC_KI
+#define ELASTIC_KI 1.5e-6f
+#endif
+
+// One-pole smoothing of the fill error per read (1 = none), filters wake-up jitter
+#ifndef ELASTIC_SMOOTHING
+#define ELASTIC_SMOOTHING 0.25f
+#endif
+
+// Largest step correction in ppm (clock sources further apart are not followed)
+#ifndef ELASTIC_MAX_PPM
+#define ELASTIC_MAX_PPM 20000
+#endif
+
+/**
+ * @brief Elastic FIFO with a PI-controlled Hermite resampler on its read side
+ */
+class ElasticResampler
+{
+    static_assert((ELASTIC_FIFO_SIZE & (ELASTIC_FIFO_SIZE - 1)) == 0, "ELASTIC_FIFO_SIZE must be a power of 2");
+
+public:
+    ElasticResampler()
+    {
+        init(ELASTIC_FIFO_SIZE / 4);
+    }
+
+    /**
+     * @brief Reset the FIFO and the controller
+     * @param targetFill Fill level the controller holds, in input samples
+     */
+    void init(uint32_t targetFill)
+    {
+        for (uint32_t i = 0; i < ELASTIC_FIFO_SIZE; i++)
+        {
+            buffer_[i] = 0.0f;
+        }
+        target_ = targetFill;
+        writePos_ = 0;
+        readPos_ = 0;
+        frac_ = 0;
+        resetControl();
+    }
+
+    /**
+     * @brief Reset the controller and the counters, keeping the FIFO contents
+     */
+    void resetControl()
+    {
+        error_ = 0.0f;
+        integral_ = 0.0f;
+        correction_ = 0.0f;
+        starved_ = 0;
+    }
+
+    /**
+     * @brief Number of input samples waiting, from the current read position
+     */
+    inline uint32_t fill() const
+    {
+        return writePos_ - readPos_;
+    }
+
+    /**
+     * @brief Number of input samples write() accepts (one slot keeps the previous sample)
+     */
+    inline uint32_t space() const
+    {
+        return ELASTIC_FIFO_SIZE - 1 - fill();
+    }
+
+    /**
+     * @brief Append input samples
+     * @param samples Input at the local sample rate
+     * @param count Number of samples, at most space()
+     */
+    void write(const float *samples, uint32_t count)
+    {
+        for (uint32_t i = 0; i < count; i++)
+        {
+            buffer_[(writePos_ + i) & MASK] = samples[i];
+        }
+        writePos_ += count;
+    }
+
+    /**
+     * @brief Update the controller and produce one block of output samples
+     *
+     * The controller input is the fill plus the input samples that the producer's time
+     * base has generated but not yet delivered. Heavy writes whole blocks, so without this
+     * the error would jump by a block at every write.
+     *
+     * @param out Output samples
+     * @param count Number of output samples
+     * @param inputElapsed Input samples that have elapsed since the last write() on the producer's clock
+     * @return true if the block was produced, false (nothing consumed, counted as starved) if the FIFO is short
+     */
+    bool read(float *out, uint32_t count, float inputElapsed)
+    {
+        // PI step on the smoothed fill error
+        const float error = (float)fill() + inputElapsed - (float)target_;
+        const float smoothed = error_ + ELASTIC_SMOOTHING * (error - error_);
+        float integral = integral_ + smoothed;
+        const float maxCorrection = ELASTIC_MAX_PPM * 1e-6f;
+        if (integral * ELASTIC_KI > maxCorrection)
+        {
+            integral = maxCorrection / ELASTIC_KI; // Anti-windup
+        }
+        else if (integral * ELASTIC_KI < -maxCorrection)
+        {
+            integral = -maxCorrection / ELASTIC_KI;
+        }
+        float correction = ELASTIC_KP * smoothed + ELASTIC_KI * integral;
+        correction = correction > maxCorrection ? maxCorrection : (correction < -maxCorrection ? -maxCorrection : correction);
+        const uint64_t step = (uint64_t)((double)STEP_UNITY * (1.0 + (double)correction));
+
+        // Every output needs input samples up to index + 2 (Hermite look-ahead)
+        const uint32_t needed = (uint32_t)(((uint64_t)frac_ + (uint64_t)(count - 1) * step) >> 32) + 3;
+        if (fill() < needed)
+        {
+            starved_++;
+            return false;
+        }
+        error_ = smoothed;
+        integral_ = integral;
+        correction_ = correction;
+
+        uint32_t pos = readPos_;
+        uint32_t frac = frac_;
+        for (uint32_t i = 0; i < count; i++)
+        {
+            const float ym1 = buffer_[(pos - 1) & MASK];
+            const float y0 = buffer_[pos & MASK];
+            const float y1 = buffer_[(pos + 1) & MASK];
+            const float y2 = buffer_[(pos + 2) & MASK];
+            const float x = (float)frac * (1.0f / 4294967296.0f);
+
+            const float c1 = 0.5f * (y1 - ym1);
+            const float c2 = ym1 - 2.5f * y0 + 2.0f * y1 - 0.5f * y2;
+            const float c3 = 0.5f * (y2 - ym1) + 1.5f * (y0 - y1);
+            out[i] = ((c3 * x + c2) * x + c1) * x + y0;
+
+            const uint64_t next = (uint64_t)frac + step;
+            pos += (uint32_t)(next >> 32);
+            frac = (uint32_t)next;
+        }
+        readPos_ = pos;
+        frac_ = frac;
+        return true;
+    }
+
+    /**
+     * @brief Current step correction in ppm (positive = output clock slower than the input clock)
+     */
+    inline float getCorrectionPpm() const
+    {
+        return correction_ * 1e6f;
+    }
+
+    /**
+     * @brief Smoothed fill error of the last successful read, in input samples
+     */
+    inline float getError() const
+    {
+        return error_;
+    }
+
+    /**
+     * @brief Target fill in input samples
+     */
+    inline uint32_t getTarget() const
+    {
+        return target_;
+    }
+
+    /**
+     * @brief Number of reads refused because the FIFO was short
+     */
+    inline uint32_t getStarvedCount() const
+    {
+        return starved_;
+    }
+
+private:
+    static const uint32_t MASK = ELASTIC_FIFO_SIZE - 1;
+    static constexpr uint64_t STEP_UNITY = 1ull << 32; ///< Q32.32 step of 1 input sample per output sample
+
+    float buffer_[ELASTIC_FIFO_SIZE];
+    uint32_t target_;
+    uint32_t writePos_; ///< Free-running index of the next input sample
+    uint32_t readPos_;  ///< Free-running index of the input sample at or before the read position
+    uint32_t frac_;     ///< Read position between readPos_ and readPos_ + 1, Q0.32
+
+    // Controller state
+    float error_;
+    float integral_;
+    float correction_;
+
+    uint32_t starved_;
+};
+
+#endif // ELASTIC_RESAMPLER_H
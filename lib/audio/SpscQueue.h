@@ -0,0 +1,174 @@
+/**
+ * @file SpscQueue.h
+ * @brief Lock-free single-producer / single-consumer queue
+ * @author Ale Moglia
+ * @date 2026
+ *
+ * Fixed-capacity FIFO shared between exactly one producer and one consumer, which may
+ * run on different RP2350 cores or be an IRQ handler and the main loop.
+ */
+
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <stdint.h>
+#include <atomic>
+
+/**
+ * @brief Lock-free SPSC queue with copy and in-place (slot) access
+ *
+ * Head and tail are free-running 32-bit counters, so all N slots are usable and the
+ * fill level is simply head - tail. The producer writes a slot and then publishes it
+ * with a release store of head; the consumer acquires head before reading the slot.
+ * The same pairing on tail hands empty slots back. On the Cortex-M33 this compiles
+ * to LDA/STL (or DMB): no spinlocks, no interrupt masking, safe across cores.
+ *
+ * @tparam T Element type
+ * @tparam N Capacity in elements, must be a power of 2
+ */
+template <typename T, uint32_t N>
+class SpscQueue
+{
+    static_assert(N > 0 && (N & (N - 1)) == 0, "SpscQueue capacity must be a power of 2");
+
+public:
+    SpscQueue() : head_(0), tail_(0) {}
+
+    /**
+     * @brief Get the queue capacity
+     * @return Maximum number of elements (N)
+     */
+    static constexpr uint32_t capacity() { return N; }
+
+    /**
+     * @brief Get number of elements waiting to be consumed (either side)
+     */
+    uint32_t size() const
+    {
+        return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Get number of free slots (either side)
+     */
+    uint32_t free() const
+    {
+        return N - size();
+    }
+
+    // ------------------------------------------------------------------------
+    // Producer side
+    // ------------------------------------------------------------------------
+
+    /**
+     * @brief Copy one element into the queue
+     * @return true if successful, false if the queue is full
+     */
+    bool push(const T &value)
+    {
+        T *slot = writeSlot();
+        if (slot == nullptr)
+        {
+            return false;
+        }
+        *slot = value;
+        commit();
+        return true;
+    }
+
+    /**
+     * @brief Get the next free slot to fill in place
+     * @return Pointer to the slot, or nullptr if the queue is full
+     */
+    T *writeSlot()
+    {
+        const uint32_t head = head_.load(std::memory_order_relaxed);
+        if (head - tail_.load(std::memory_order_acquire) >= N)
+        {
+            return nullptr;
+        }
+        return &buffer_[head & MASK];
+    }
+
+    /**
+     * @brief Publish the slot returned by writeSlot() to the consumer
+     */
+    void commit()
+    {
+        head_.store(head_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // ------------------------------------------------------------------------
+    // Consumer side
+    // ------------------------------------------------------------------------
+
+    /**
+     * @brief Copy the oldest element out of the queue
+     * @return true if successful, false if the queue is empty
+     */
+    bool pop(T &value)
+    {
+        const T *slot = peek();
+        if (slot == nullptr)
+        {
+            return false;
+        }
+        value = *slot;
+        release();
+        return true;
+    }
+
+    /**
+     * @brief Access a committed element without consuming it
+     * @param offset 0 = oldest element
+     * @return Pointer to the element, or nullptr if fewer than offset + 1 are queued
+     */
+    const T *peek(uint32_t offset = 0) const
+    {
+        const uint32_t tail = tail_.load(std::memory_order_relaxed);
+        if (head_.load(std::memory_order_acquire) - tail <= offset)
+        {
+            return nullptr;
+        }
+        return &buffer_[(tail + offset) & MASK];
+    }
+
+    /**
+     * @brief Get the storage index of a committed element (see slot())
+     * @param offset 0 = oldest element
+     */
+    uint32_t peekIndex(uint32_t offset = 0) const
+    {
+        return (tail_.load(std::memory_order_relaxed) + offset) & MASK;
+    }
+
+    /**
+     * @brief Hand the oldest element(s) back to the producer
+     * @param count Number of elements to release
+     */
+    void release(uint32_t count = 1)
+    {
+        tail_.store(tail_.load(std::memory_order_relaxed) + count, std::memory_order_release);
+    }
+
+    // ------------------------------------------------------------------------
+    // Storage
+    // ------------------------------------------------------------------------
+
+    /**
+     * @brief Direct access to a storage slot by index (0 to N-1)
+     *
+     * Slot addresses never change, so they can be handed to DMA descriptors once
+     * at startup. Only touch a slot the calling side currently owns.
+     */
+    T &slot(uint32_t index) { return buffer_[index & MASK]; }
+
+private:
+    static const uint32_t MASK = N - 1;
+
+    T buffer_[N];
+    std::atomic<uint32_t> head_; ///< Written by producer only
+    std::atomic<uint32_t> tail_; ///< Written by consumer only
+};
+
+#endif // SPSC_QUEUE_H
@@ -0,0 +1,65 @@
+/**
+ * @file Thd.h
+ * @brief Total harmonic distortion of a periodic oscillator shape
+ * @author Ale Moglia
+ * @date 2026
+ *
+ * Measures an oscillator defined as a function of a 32-bit phase (0 .. 2^32 = one
+ * period) by sampling exactly one period, taking the fundamental with the Goertzel
+ * algorithm and the rest of the energy as distortion. Used at startup to compare the Heavy
+ * polynomial sine against the wavetable oscillator.
+ */
+
+#ifndef THD_H
+#define THD_H
+
+#include <stdint.h>
+#include <math.h>
+
+/**
+ * @brief Magnitude of one DFT bin (Goertzel), in double precision
+ */
+static inline double thdGoertzel(float (*osc)(uint32_t phase), uint32_t numSamples, uint32_t bin)
+{
+    const double w = 2.0 * M_PI * bin / numSamples;
+    const double coeff = 2.0 * cos(w);
+    const uint32_t step = (uint32_t)(4294967296.0 / numSamples);
+    double s1 = 0.0, s2 = 0.0;
+    for (uint32_t i = 0; i < numSamples; i++)
+    {
+        const double s0 = osc(i * step) + coeff * s1 - s2;
+        s2 = s1;
+        s1 = s0;
+    }
+    return sqrt(s1 * s1 + s2 * s2 - coeff * s1 * s2);
+}
+
+/**
+ * @brief THD of one period of the oscillator shape, all harmonics up to Nyquist
+ *
+ * One exact period holds only harmonics of the fundamental, so the energy that is not
+ * DC or fundamental (Parseval) is the distortion. This also catches the interpolation
+ * error of a wavetable, which lands near multiples of the table size.
+ *
+ * @param osc Oscillator, output for a 32-bit phase
+ * @param numSamples Samples per period (power of 2, so the phase step is exact)
+ * @return THD as a ratio (harmonic RMS / fundamental RMS); 20*log10() gives dB
+ */
+static inline double thdMeasure(float (*osc)(uint32_t phase), uint32_t numSamples = 4096)
+{
+    const uint32_t step = (uint32_t)(4294967296.0 / numSamples);
+    double total = 0.0;
+    for (uint32_t i = 0; i < numSamples; i++)
+    {
+        const double x = osc(i * step);
+        total += x * x;
+    }
+    const double dc = thdGoertzel(osc, numSamples, 0);
+    const double fundamental = thdGoertzel(osc, numSamples, 1);
+    const double dcEnergy = dc * dc / numSamples;
+    const double fundamentalEnergy = 2.0 * fundamental * fundamental / numSamples;
+    const double distortion = total - dcEnergy - fundamentalEnergy;
+    return sqrt((distortion > 0.0 ? distortion : 0.0) / fundamentalEnergy);
+}
+
+#endif // THD_H
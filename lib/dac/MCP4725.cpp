@@ -7,14 +7,29 @@
 
 #include "MCP4725.h"
 #include <stdio.h>
-
-MCP4725::MCP4725()
-    : initialized_(false), currentValue_(0), currentPowerMode_(POWER_DOWN_OFF)
+#include "hardware/irq.h"
+#include "hardware/clocks.h"
+#include "hardware/pwm.h"
+#include "hardware/timer.h"
+#include "../HotPath.h"
+
+MCP4725 *MCP4725::asyncInstances_[MCP4725::MAX_ASYNC_INSTANCES] = {nullptr};
+bool MCP4725::irqHandlerInstalled_ = false;
+MCP4725 *MCP4725::fanOutInstance_ = nullptr;
+
+MCP4725::MCP4725(uint8_t address)
+    : address_(address), initialized_(false), currentValue_(0), currentPowerMode_(POWER_DOWN_OFF),
+      dmaChan_(-1), paceChan_(-1), paceTimer_(-1), paceSlice_(-1),
+      pacedRate_(0.0f), sampleRate_(0), paceY_(0), irqChan_(-1), wire_(WIRE_WRITE_DAC), streamOpen_(false),
+      callback_(nullptr), userData_(nullptr), asyncErrors_(0), lastAsyncError_(ASYNC_OK), lastAbortSource_(0),
+      fanOutAddress_(0), fanOutSecond_(false), fanOutBlock_(false), fanOutRemaining_(0), fanOutLate_(0),
+      fanOutResult_(ASYNC_OK), pacePaused_(false), pacePending_(false)
 {
 }
 
 MCP4725::~MCP4725()
 {
+    endAsync();
     if (initialized_)
     {
         deinit();
@@ -29,7 +44,7 @@ bool MCP4725::init()
     }
 
     // Initialize I2C for DAC communication
-    i2c_init(DAC_I2C_PORT, 2000000); // 2MHz
+    i2c_init(DAC_I2C_PORT, I2C_BAUD_HZ); // 2MHz
 
     // Set up I2C pins
     gpio_set_function(DAC_SDA_PIN, GPIO_FUNC_I2C);
@@ -56,7 +71,7 @@ bool MCP4725::init()
     }
 
     initialized_ = true;
-    printf("MCP4725: Initialized successfully at address 0x%02X\n", DAC_I2C_ADDRESS);
+    printf("MCP4725: Initialized successfully at address 0x%02X\n", address_);
     return true;
 }
 
@@ -163,13 +178,13 @@ bool MCP4725::setPowerDownMode(PowerDownMode mode)
 
 bool MCP4725::readStatus(uint16_t *value, uint16_t *eepromValue, PowerDownMode *powerDown)
 {
-    if (!initialized_)
+    if (!initialized_ || isBusy() || streamOpen_)
     {
         return false;
     }
 
     uint8_t data[5];
-    int result = i2c_read_blocking(DAC_I2C_PORT, DAC_I2C_ADDRESS, data, 5, false);
+    int result = i2c_read_blocking(DAC_I2C_PORT, address_, data, 5, false);
 
     if (result != 5)
     {
@@ -213,13 +228,19 @@ bool MCP4725::isInitialized() const
 bool MCP4725::testCommunication()
 {
     uint8_t testData;
-    int result = i2c_read_blocking(DAC_I2C_PORT, DAC_I2C_ADDRESS, &testData, 1, false);
+    int result = i2c_read_blocking(DAC_I2C_PORT, address_, &testData, 1, false);
 
     return (result == 1);
 }
 
 bool MCP4725::writeDAC(uint16_t value, PowerDownMode powerDown, bool writeEEPROM)
 {
+    // The bus belongs to the DMA while a block is in flight, and to an open stream until endAsync()
+    if (isBusy() || streamOpen_)
+    {
+        return false;
+    }
+
     // Clamp to 12-bit
     value &= 0x0FFF;
 
@@ -240,7 +261,7 @@ bool MCP4725::writeDAC(uint16_t value, PowerDownMode powerDown, bool writeEEPROM
         data[2] = (value << 4) & 0xF0; // Lower 4 bits
     }
 
-    int result = i2c_write_blocking(DAC_I2C_PORT, DAC_I2C_ADDRESS, data, 3, false);
+    int result = i2c_write_blocking(DAC_I2C_PORT, address_, data, 3, false);
 
     if (result == 3)
     {
@@ -251,3 +272,620 @@ bool MCP4725::writeDAC(uint16_t value, PowerDownMode powerDown, bool writeEEPROM
 
     return false;
 }
+
+void MCP4725::setFanOutAddress(uint8_t address)
+{
+    if (dmaChan_ < 0)
+    {
+        fanOutAddress_ = address;
+    }
+}
+
+bool MCP4725::beginAsync(uint32_t sampleRate, SampleClock clock, WireFormat wire)
+{
+    if (!initialized_ || dmaChan_ >= 0)
+    {
+        return false;
+    }
+    if (fanOutAddress_ != 0 && wire == WIRE_FAST_STREAM)
+    {
+        printf("MCP4725: Fan-out to 0x%02X needs a STOP after every sample, not WIRE_FAST_STREAM\n", fanOutAddress_);
+        return false;
+    }
+
+    // Register for the shared DMA IRQ handler
+    int slot = -1;
+    for (int i = 0; i < MAX_ASYNC_INSTANCES; i++)
+    {
+        if (asyncInstances_[i] == nullptr)
+        {
+            slot = i;
+            break;
+        }
+    }
+    if (slot < 0)
+    {
+        printf("MCP4725: No free async slot\n");
+        return false;
+    }
+
+    const uint32_t sysHz = clock_get_hz(clk_sys);
+    uint16_t paceX = 0, paceY = 0;
+    uint32_t pwmDiv16 = 0, pwmTop = 0;
+    if (sampleRate > 0 && clock == SAMPLE_CLOCK_DMA_TIMER && !pacingFraction(sysHz, sampleRate, &paceX, &paceY))
+    {
+        printf("MCP4725: No exact DMA timer fraction for %lu Hz at clk_sys %lu Hz (try SAMPLE_CLOCK_PWM)\n",
+               sampleRate, sysHz);
+        return false;
+    }
+    if (sampleRate > 0 && clock == SAMPLE_CLOCK_PWM && !pwmDivider(sysHz, sampleRate, &pwmDiv16, &pwmTop))
+    {
+        printf("MCP4725: %lu Hz is outside the PWM sample clock range at clk_sys %lu Hz\n", sampleRate, sysHz);
+        return false;
+    }
+
+    // The I2C peripheral keeps the target address for every transfer
+    i2c_hw_t *i2c_hw = i2c_get_hw(DAC_I2C_PORT);
+    setTarget(i2c_hw, address_);
+    wire_ = wire;
+    streamOpen_ = wire == WIRE_FAST_STREAM; // The first sample opens the transaction
+
+    // I2C CHANNEL: 16-bit words into data_cmd, read increment, paced by the I2C TX DREQ
+    dmaChan_ = dma_claim_unused_channel(true);
+    dma_channel_config cfg = dma_channel_get_default_config(dmaChan_);
+    channel_config_set_transfer_data_size(&cfg, DMA_SIZE_16);
+    channel_config_set_read_increment(&cfg, true);
+    channel_config_set_write_increment(&cfg, false);
+    channel_config_set_dreq(&cfg, i2c_get_dreq(DAC_I2C_PORT, true));
+    dma_channel_configure(dmaChan_, &cfg, &i2c_hw->data_cmd, NULL, getWordsPerSample(), false);
+
+    if (sampleRate > 0)
+    {
+        // SAMPLE CLOCK: a free-running counter that raises one DREQ per sample period
+        uint dreq;
+        if (clock == SAMPLE_CLOCK_PWM)
+        {
+            // The slice only counts, no GPIO is switched to the PWM function. The wrap DREQ
+            // is a pulse, so nothing has to service the slice between samples.
+            paceSlice_ = DAC_CLOCK_PWM_SLICE;
+            pwm_config pwmCfg = pwm_get_default_config();
+            pwm_config_set_clkdiv_int_frac(&pwmCfg, pwmDiv16 >> 4, pwmDiv16 & 0xF);
+            pwm_config_set_wrap(&pwmCfg, pwmTop);
+            pwm_init(paceSlice_, &pwmCfg, true);
+            dreq = pwm_get_dreq(paceSlice_);
+            pacedRate_ = (float)((double)sysHz * 16.0 / ((double)pwmDiv16 * (pwmTop + 1)));
+        }
+        else
+        {
+            paceTimer_ = dma_claim_unused_timer(true);
+            dma_timer_set_fraction(paceTimer_, paceX, paceY);
+            dreq = dma_get_timer_dreq(paceTimer_);
+            pacedRate_ = (float)((double)sysHz * paceX / paceY);
+            paceY_ = paceY;
+        }
+
+        // PACING CHANNEL: one 32-bit sample address per sample clock DREQ into the I2C channel's
+        // READ_ADDR trigger alias, which restarts the I2C channel for that sample's words
+        sampleRate_ = sampleRate;
+        paceChan_ = dma_claim_unused_channel(true);
+        dma_channel_config paceCfg = dma_channel_get_default_config(paceChan_);
+        channel_config_set_transfer_data_size(&paceCfg, DMA_SIZE_32);
+        channel_config_set_read_increment(&paceCfg, true);
+        channel_config_set_write_increment(&paceCfg, false);
+        channel_config_set_dreq(&paceCfg, dreq);
+        dma_channel_configure(paceChan_, &paceCfg, &dma_hw->ch[dmaChan_].al3_read_addr_trig, NULL, 0, false);
+    }
+
+    if (fanOutAddress_ != 0)
+    {
+        // STOP_DET ends each half of a sample, the IRQ moves the target to the other DAC
+        fanOutSecond_ = false;
+        fanOutBlock_ = false;
+        pacePaused_ = false;
+        pacePending_ = false;
+        fanOutInstance_ = this;
+        i2c_hw->intr_mask = I2C_IC_INTR_MASK_M_STOP_DET_BITS;
+        (void)i2c_hw->clr_stop_det;
+        const uint irq = I2C0_IRQ + i2c_get_index(DAC_I2C_PORT);
+        irq_set_exclusive_handler(irq, i2cIrqHandler);
+        irq_set_enabled(irq, true);
+    }
+
+    asyncInstances_[slot] = this;
+    if (!irqHandlerInstalled_)
+    {
+        irq_add_shared_handler(DMA_IRQ_0, dmaIrqHandler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+        irq_set_enabled(DMA_IRQ_0, true);
+        irqHandlerInstalled_ = true;
+    }
+
+    printf("MCP4725: Async DMA channel %d, %s", dmaChan_,
+           wire == WIRE_FAST_STREAM ? "fast-mode stream (2 bytes/sample)" : "write DAC (3 bytes + STOP/sample)");
+    if (paceChan_ >= 0 && paceSlice_ >= 0)
+    {
+        printf(", pacing channel %d, PWM slice %d: clk_sys / (%lu.%04lu x %lu) = %.3f Hz (%+.1f ppm)", paceChan_,
+               paceSlice_, pwmDiv16 >> 4, (pwmDiv16 & 0xF) * 625, pwmTop + 1, pacedRate_,
+               (pacedRate_ / sampleRate - 1.0f) * 1e6f);
+    }
+    else if (paceChan_ >= 0)
+    {
+        printf(", pacing channel %d, timer %d: %u/%u x clk_sys = %lu Hz", paceChan_, paceTimer_,
+               paceX, paceY, sampleRate);
+    }
+    if (fanOutAddress_ != 0)
+    {
+        printf(", fan-out 0x%02X -> 0x%02X", address_, fanOutAddress_);
+    }
+    printf("\n");
+    return true;
+}
+
+void MCP4725::endAsync()
+{
+    if (dmaChan_ < 0)
+    {
+        return;
+    }
+
+    setIrqChannel(-1);
+    if (paceChan_ >= 0)
+    {
+        dma_channel_abort(paceChan_);
+        dma_channel_unclaim(paceChan_);
+        if (paceSlice_ >= 0)
+        {
+            pwm_set_enabled(paceSlice_, false);
+        }
+        else
+        {
+            dma_timer_unclaim(paceTimer_);
+        }
+        paceChan_ = -1;
+        paceTimer_ = -1;
+        paceSlice_ = -1;
+        pacedRate_ = 0.0f;
+        sampleRate_ = 0;
+        paceY_ = 0;
+    }
+    if (fanOutInstance_ == this)
+    {
+        const uint irq = I2C0_IRQ + i2c_get_index(DAC_I2C_PORT);
+        irq_set_enabled(irq, false);
+        irq_remove_handler(irq, i2cIrqHandler);
+        i2c_get_hw(DAC_I2C_PORT)->intr_mask = 0;
+        fanOutInstance_ = nullptr;
+        fanOutSecond_ = false; // The blocking calls set IC_TAR themselves
+        fanOutBlock_ = false;
+        pacePaused_ = false;
+        pacePending_ = false;
+    }
+    dma_channel_abort(dmaChan_);
+    dma_channel_unclaim(dmaChan_);
+    dmaChan_ = -1;
+    if (streamOpen_)
+    {
+        closeStream();
+    }
+
+    for (int i = 0; i < MAX_ASYNC_INSTANCES; i++)
+    {
+        if (asyncInstances_[i] == this)
+        {
+            asyncInstances_[i] = nullptr;
+        }
+    }
+}
+
+bool HOT_FUNC(MCP4725::submitBlock)(const uint16_t *words, uint32_t numSamples)
+{
+    if (dmaChan_ < 0 || numSamples == 0 || isBusy())
+    {
+        return false;
+    }
+
+    // An abort flushes the TX FIFO until cleared - clear it so this block goes out
+    checkAbort();
+
+    if (fanOutAddress_ != 0)
+    {
+        // One DAC's words per DMA run, handleStop() starts the others and calls back at the end
+        setIrqChannel(-1);
+        fanOutResult_ = ASYNC_OK;
+        fanOutRemaining_ = numSamples - 1;
+        fanOutBlock_ = true;
+        dma_channel_set_trans_count(dmaChan_, getWordsPerSample(), false);
+        dma_channel_set_read_addr(dmaChan_, words, true);
+        return true;
+    }
+
+    setIrqChannel(callback_ != nullptr ? dmaChan_ : -1);
+    dma_channel_set_trans_count(dmaChan_, numSamples * getWordsPerSample(), false);
+    dma_channel_set_read_addr(dmaChan_, words, true);
+    return true;
+}
+
+bool HOT_FUNC(MCP4725::submitPacedBlock)(const uint16_t *const *samplePtrs, uint32_t numSamples)
+{
+    // Only the pacing channel has to be idle: the I2C channel may still be sending the
+    // previous block's last sample, the next tick only comes one sample period later
+    if (paceChan_ < 0 || numSamples == 0 || dma_channel_is_busy(paceChan_))
+    {
+        return false;
+    }
+
+    setIrqChannel(callback_ != nullptr ? paceChan_ : -1);
+    dma_channel_set_trans_count(dmaChan_, getWordsPerSample(), false);
+    dma_channel_set_trans_count(paceChan_, numSamples, false);
+    if (fanOutAddress_ == 0)
+    {
+        dma_channel_set_read_addr(paceChan_, samplePtrs, true);
+        return true;
+    }
+
+    // A disabled channel ignores its trigger: while the second DAC's words are out, the
+    // STOP_DET IRQ starts the block when it releases the pacing
+    const uint32_t irqState = save_and_disable_interrupts();
+    dma_channel_set_read_addr(paceChan_, samplePtrs, !pacePaused_);
+    pacePending_ = pacePaused_;
+    restore_interrupts(irqState);
+    return true;
+}
+
+void MCP4725::setCompletionCallback(CompletionCallback callback, void *userData)
+{
+    callback_ = callback;
+    userData_ = userData;
+}
+
+bool HOT_FUNC(MCP4725::isBusy)() const
+{
+    if (dmaChan_ < 0)
+    {
+        return false;
+    }
+    return fanOutBlock_ || fanOutSecond_ || dma_channel_is_busy(dmaChan_) ||
+           (paceChan_ >= 0 && dma_channel_is_busy(paceChan_));
+}
+
+MCP4725::AsyncResult MCP4725::pollAsyncError()
+{
+    return checkAbort();
+}
+
+uint32_t HOT_FUNC(MCP4725::getAsyncErrorCount)() const
+{
+    return asyncErrors_;
+}
+
+MCP4725::AsyncResult MCP4725::getLastAsyncError() const
+{
+    return lastAsyncError_;
+}
+
+uint32_t HOT_FUNC(MCP4725::getLastAbortSource)() const
+{
+    return lastAbortSource_;
+}
+
+int MCP4725::getDmaChannel() const
+{
+    return dmaChan_;
+}
+
+int MCP4725::getPaceChannel() const
+{
+    return paceChan_;
+}
+
+float MCP4725::getPacedRate() const
+{
+    return pacedRate_;
+}
+
+bool MCP4725::canRetime(uint32_t sysHz) const
+{
+    if (dmaChan_ < 0 || wire_ == WIRE_FAST_STREAM || fanOutAddress_ != 0 || paceSlice_ >= 0)
+    {
+        return false;
+    }
+    if (paceTimer_ >= 0)
+    {
+        // X / paceY_ = sampleRate / sysHz, with X a whole 16-bit number
+        const uint64_t scaled = (uint64_t)sampleRate_ * paceY_;
+        if (scaled % sysHz != 0 || scaled / sysHz == 0 || scaled / sysHz > 0xFFFF)
+        {
+            return false;
+        }
+    }
+    return sclTimingValid(sysHz);
+}
+
+bool MCP4725::waitBusIdle(uint32_t timeoutUs) const
+{
+    const i2c_hw_t *hw = i2c_get_hw(DAC_I2C_PORT);
+    const uint32_t start = timer_hw->timerawl;
+    while (dma_channel_is_busy(dmaChan_) || !(hw->status & I2C_IC_STATUS_TFE_BITS) ||
+           (hw->status & I2C_IC_STATUS_ACTIVITY_BITS))
+    {
+        if (timer_hw->timerawl - start > timeoutUs)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool MCP4725::retime()
+{
+    const uint32_t sysHz = clock_get_hz(clk_sys);
+    if (!canRetime(sysHz))
+    {
+        return false;
+    }
+
+    // Disables the controller for a few cycles: IC_TAR and the DMA handshake are kept
+    i2c_set_baudrate(DAC_I2C_PORT, I2C_BAUD_HZ);
+    if (paceTimer_ >= 0)
+    {
+        dma_timer_set_fraction(paceTimer_, (uint16_t)((uint64_t)sampleRate_ * paceY_ / sysHz), paceY_);
+    }
+    return true;
+}
+
+uint32_t MCP4725::getWordsPerSample() const
+{
+    return wire_ == WIRE_FAST_STREAM ? STREAM_WORDS_PER_SAMPLE : WORDS_PER_SAMPLE;
+}
+
+uint32_t MCP4725::getTargetCount() const
+{
+    return fanOutAddress_ != 0 ? 2 : 1;
+}
+
+uint32_t MCP4725::getFanOutLateCount() const
+{
+    return fanOutLate_;
+}
+
+uint8_t MCP4725::getAddress() const
+{
+    return address_;
+}
+
+void HOT_FUNC(MCP4725::dmaIrqHandler)()
+{
+    for (int i = 0; i < MAX_ASYNC_INSTANCES; i++)
+    {
+        if (asyncInstances_[i] != nullptr)
+        {
+            asyncInstances_[i]->handleDmaIrq();
+        }
+    }
+}
+
+void HOT_FUNC(MCP4725::handleDmaIrq)()
+{
+    const int chan = irqChan_;
+    if (chan < 0 || !(dma_hw->ints0 & (1u << chan)))
+    {
+        return;
+    }
+    dma_hw->ints0 = 1u << chan; // Clear interrupt
+
+    const AsyncResult result = checkAbort();
+    if (callback_ != nullptr)
+    {
+        callback_(this, result, userData_);
+    }
+}
+
+void HOT_FUNC(MCP4725::i2cIrqHandler)()
+{
+    if (fanOutInstance_ != nullptr)
+    {
+        fanOutInstance_->handleStop();
+    }
+}
+
+void HOT_FUNC(MCP4725::handleStop)()
+{
+    i2c_hw_t *hw = i2c_get_hw(DAC_I2C_PORT);
+    (void)hw->clr_stop_det;
+
+    // A NAK (second DAC not fitted) flushes and holds the TX FIFO until the abort is cleared
+    const AsyncResult result = checkAbort();
+    if (fanOutResult_ == ASYNC_OK)
+    {
+        fanOutResult_ = result;
+    }
+
+    if (!fanOutSecond_)
+    {
+        // Paced: no tick may restart the channel while IC_TAR points at the second DAC
+        if (!fanOutBlock_)
+        {
+            pausePacing();
+        }
+        if (dma_channel_is_busy(dmaChan_) || hw->txflr != 0 ||
+            (hw->status & I2C_IC_STATUS_MST_ACTIVITY_BITS) != 0)
+        {
+            // The next paced sample already started to this DAC: the second DAC misses this
+            // one and keeps its value, the switch happens after the next sample's STOP
+            fanOutLate_ = fanOutLate_ + 1;
+            resumePacing();
+            return;
+        }
+
+        // The channel stopped at the end of this DAC's words, the second DAC's follow them
+        setTarget(hw, fanOutAddress_);
+        fanOutSecond_ = true;
+        dma_channel_set_trans_count(dmaChan_, getWordsPerSample(), true);
+        return;
+    }
+
+    // Nothing else is on the bus: the pacing was held and a block only restarts from here
+    setTarget(hw, address_);
+    fanOutSecond_ = false;
+    if (!fanOutBlock_)
+    {
+        resumePacing(); // A tick that came meanwhile starts the next sample now
+        return;
+    }
+    if (fanOutRemaining_ != 0)
+    {
+        fanOutRemaining_ = fanOutRemaining_ - 1;
+        dma_channel_set_trans_count(dmaChan_, getWordsPerSample(), true);
+        return;
+    }
+    fanOutBlock_ = false;
+    if (callback_ != nullptr)
+    {
+        callback_(this, fanOutResult_, userData_);
+    }
+}
+
+void HOT_FUNC(MCP4725::pausePacing)()
+{
+    hw_clear_bits(&dma_hw->ch[paceChan_].al1_ctrl, DMA_CH0_CTRL_TRIG_EN_BITS);
+    pacePaused_ = true;
+}
+
+void HOT_FUNC(MCP4725::resumePacing)()
+{
+    if (!pacePaused_)
+    {
+        return;
+    }
+    pacePaused_ = false;
+    hw_set_bits(&dma_hw->ch[paceChan_].al1_ctrl, DMA_CH0_CTRL_TRIG_EN_BITS);
+    if (pacePending_)
+    {
+        pacePending_ = false;
+        dma_channel_start(paceChan_);
+    }
+}
+
+void HOT_FUNC(MCP4725::setTarget)(i2c_hw_t *hw, uint8_t address)
+{
+    hw->enable = 0;
+    hw->tar = address;
+    hw->enable = 1;
+}
+
+void HOT_FUNC(MCP4725::setIrqChannel)(int chan)
+{
+    if (chan == irqChan_)
+    {
+        return;
+    }
+    if (irqChan_ >= 0)
+    {
+        dma_channel_set_irq0_enabled(irqChan_, false);
+    }
+    if (chan >= 0)
+    {
+        dma_channel_set_irq0_enabled(chan, true);
+    }
+    irqChan_ = chan;
+}
+
+MCP4725::AsyncResult HOT_FUNC(MCP4725::checkAbort)()
+{
+    i2c_hw_t *i2c_hw = i2c_get_hw(DAC_I2C_PORT);
+    if (!(i2c_hw->raw_intr_stat & I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS))
+    {
+        return ASYNC_OK;
+    }
+
+    // Reading the source first, then IC_CLR_TX_ABRT releases the flushed TX FIFO
+    const uint32_t source = i2c_hw->tx_abrt_source;
+    (void)i2c_hw->clr_tx_abrt;
+
+    AsyncResult result = ASYNC_ABORTED;
+    if (source & I2C_IC_TX_ABRT_SOURCE_ABRT_7B_ADDR_NOACK_BITS)
+    {
+        result = ASYNC_NAK_ADDRESS;
+    }
+    else if (source & I2C_IC_TX_ABRT_SOURCE_ABRT_TXDATA_NOACK_BITS)
+    {
+        result = ASYNC_NAK_DATA;
+    }
+    else if (source & I2C_IC_TX_ABRT_SOURCE_ARB_LOST_BITS)
+    {
+        result = ASYNC_ARB_LOST;
+    }
+
+    lastAbortSource_ = source;
+    lastAsyncError_ = result;
+    asyncErrors_ = asyncErrors_ + 1;
+    return result;
+}
+
+void MCP4725::closeStream()
+{
+    // ABORT lets the byte on the bus finish, then sends STOP and flushes the TX FIFO.
+    // On an idle bus (no sample sent yet) the bit clears straight away.
+    i2c_hw_t *i2c_hw = i2c_get_hw(DAC_I2C_PORT);
+    hw_set_bits(&i2c_hw->enable, I2C_IC_ENABLE_ABORT_BITS);
+    const uint32_t start = time_us_32();
+    while ((i2c_hw->enable & I2C_IC_ENABLE_ABORT_BITS) && time_us_32() - start < 100)
+    {
+        tight_loop_contents();
+    }
+    (void)i2c_hw->clr_tx_abrt; // ABRT_USER_ABRT, not a bus error
+    streamOpen_ = false;
+}
+
+bool MCP4725::pacingFraction(uint32_t sysHz, uint32_t sampleRate, uint16_t *x, uint16_t *y)
+{
+    uint32_t a = sysHz, b = sampleRate;
+    while (b != 0)
+    {
+        uint32_t t = a % b;
+        a = b;
+        b = t;
+    }
+    const uint32_t num = sampleRate / a;
+    const uint32_t den = sysHz / a;
+    if (num == 0 || num > 0xFFFF || den > 0xFFFF)
+    {
+        return false;
+    }
+    *x = (uint16_t)num;
+    *y = (uint16_t)den;
+    return true;
+}
+
+bool MCP4725::sclTimingValid(uint32_t sysHz)
+{
+    // Same derivation as i2c_set_baudrate() above 1MHz: 3/5 low, 2/5 high, SDA hold from clk_sys
+    const uint32_t period = (sysHz + I2C_BAUD_HZ / 2) / I2C_BAUD_HZ;
+    const uint32_t lcnt = period * 3 / 5;
+    const uint32_t hcnt = period - lcnt;
+    const uint32_t sdaHold = sysHz * 3 / 25000000 + 1;
+    return hcnt >= 8 && lcnt >= 8 && hcnt <= 0xFFFF && lcnt <= 0xFFFF && sdaHold + 2 <= lcnt;
+}
+
+bool MCP4725::pwmDivider(uint32_t sysHz, uint32_t sampleRate, uint32_t *div16, uint32_t *top)
+{
+    // Smallest divider first: ties keep the finest counter (and an integer divider, no fractional jitter)
+    double bestError = -1.0;
+    for (uint32_t d = 16; d <= 0xFFF; d++)
+    {
+        const double period = (double)sysHz * 16.0 / ((double)d * sampleRate);
+        const uint32_t wrap = (uint32_t)(period + 0.5);
+        if (wrap < 2 || wrap > 0x10000)
+        {
+            continue;
+        }
+        const double rate = (double)sysHz * 16.0 / ((double)d * wrap);
+        const double error = rate > sampleRate ? rate - sampleRate : sampleRate - rate;
+        if (bestError < 0.0 || error < bestError)
+        {
+            bestError = error;
+            *div16 = d;
+            *top = wrap - 1;
+        }
+    }
+    return bestError >= 0.0;
+}
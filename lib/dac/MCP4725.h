@@ -13,6 +13,7 @@
 
 #include "pico/stdlib.h"
 #include "hardware/i2c.h"
+#include "hardware/dma.h"
 #include "../hardware.h"
 
 /**
@@ -20,6 +21,19 @@
  *
  * This class provides an interface to the MCP4725 12-bit I2C DAC
  * The DAC output is 0-5V which is then conditioned to -5V to +5V by external circuitry
+ *
+ * Two ways to drive it:
+ * - Blocking: setRaw(), setMillivolts(), setCVMillivolts(), readStatus() (i2c_*_blocking)
+ * - Asynchronous: beginAsync() claims DMA channels; submitBlock() / submitPacedBlock()
+ *   stream pre-formatted I2C data_cmd words with no CPU involvement, and completion and
+ *   NAK/abort errors are reported through a callback from the DMA IRQ.
+ * The blocking calls return false while an asynchronous transfer is in flight, and for
+ * as long as a WIRE_FAST_STREAM transaction is open (until endAsync()).
+ *
+ * A second MCP4725 on the same bus (A0 high, DAC1_I2C_ADDRESS) can be fed from the same
+ * submitted words with setFanOutAddress(): each sample is then this DAC's words followed
+ * by the second DAC's words, and the I2C STOP_DET IRQ switches the target in between.
+ * That costs two STOP_DET IRQs per sample on top of the DMA IRQ per block.
  */
 class MCP4725
 {
@@ -35,10 +49,59 @@ public:
         POWER_DOWN_500K = 3  ///< Power down with 500kΩ to ground
     };
 
+    /**
+     * @brief Result of an asynchronous transfer, decoded from the I2C abort status
+     */
+    enum AsyncResult
+    {
+        ASYNC_OK = 0,      ///< No abort: every byte was acknowledged
+        ASYNC_NAK_ADDRESS, ///< Address not acknowledged (DAC missing or wrong A0 strap)
+        ASYNC_NAK_DATA,    ///< A data byte was not acknowledged
+        ASYNC_ARB_LOST,    ///< Another master won arbitration on the bus
+        ASYNC_ABORTED      ///< Any other I2C abort
+    };
+
+    /**
+     * @brief Completion callback, called from the DMA IRQ when a submitted block has been issued
+     *
+     * For submitPacedBlock() the call comes as soon as the last sample has been handed to the
+     * I2C channel, so a new paced block can be submitted from inside the callback without a gap.
+     *
+     * @param dac Driver instance that completed
+     * @param result ASYNC_OK, or the I2C abort seen since the previous completion
+     * @param userData Pointer given to setCompletionCallback()
+     */
+    typedef void (*CompletionCallback)(MCP4725 *dac, AsyncResult result, void *userData);
+
+    /**
+     * @brief Hardware that raises the pacing DREQ once per sample (submitPacedBlock())
+     */
+    enum SampleClock
+    {
+        SAMPLE_CLOCK_DMA_TIMER = 0, ///< DMA pacing timer, clk_sys * X / Y: exact, or refused if no 16-bit fraction exists
+        SAMPLE_CLOCK_PWM           ///< PWM slice DAC_CLOCK_PWM_SLICE wrap: 8.4 divider x 16-bit TOP, any rate, closest match
+    };
+
+    /**
+     * @brief Bus format of the asynchronous samples
+     */
+    enum WireFormat
+    {
+        WIRE_WRITE_DAC = 0, ///< One transaction per sample: address, 0x40 command, 2 data bytes, STOP
+        WIRE_FAST_STREAM    ///< One open transaction: 2 fast-mode bytes per sample, no START/STOP between samples
+    };
+
+    // I2C data_cmd words per WIRE_WRITE_DAC sample: command, D11-D4, D3-D0<<4 | STOP
+    static const uint32_t WORDS_PER_SAMPLE = 3;
+
+    // I2C data_cmd words per WIRE_FAST_STREAM sample: 0000 D11-D8 (PD = 00), D7-D0
+    static const uint32_t STREAM_WORDS_PER_SAMPLE = 2;
+
     /**
      * @brief Constructor
+     * @param address I2C address of this DAC (DAC_I2C_ADDRESS, or DAC1_I2C_ADDRESS with A0 high)
      */
-    MCP4725();
+    MCP4725(uint8_t address = DAC_I2C_ADDRESS);
 
     /**
      * @brief Destructor
@@ -123,6 +186,169 @@ public:
      */
     bool testCommunication();
 
+    /**
+     * @brief Send every asynchronous sample to a second DAC as well (call before beginAsync())
+     *
+     * A sample is then 2 x getWordsPerSample() words: this DAC's, then the second DAC's.
+     * The DMA issues this DAC's words; on their STOP the I2C STOP_DET IRQ switches IC_TAR to
+     * the second address and restarts the same channel, whose read address already points
+     * at the second half, then switches back after the second STOP. Both transfers of a
+     * sample must fit in one sample period. The IRQ is claimed exclusively, so the bus
+     * cannot be shared with ControlScanner, and WIRE_FAST_STREAM has no STOP to switch on.
+     *
+     * Every sample then costs two STOP_DET IRQs, on top of the one DMA IRQ per block. With
+     * submitPacedBlock() the pacing channel is paused while the second DAC's words are out,
+     * so a sample tick that comes meanwhile is held back by its DREQ count instead of
+     * sending this DAC's words to the second address.
+     *
+     * @param address Second DAC's I2C address, 0 = this DAC only
+     */
+    void setFanOutAddress(uint8_t address);
+
+    /**
+     * @brief Claim DMA resources for asynchronous transfers
+     *
+     * Sets the I2C target address once and configures a 16-bit DMA channel feeding
+     * the I2C data_cmd register (paced by the I2C TX DREQ). With a sample rate, also
+     * claims a pacing channel for submitPacedBlock() and the sample clock that paces it.
+     * Either clock is a free-running hardware counter, so ticks never depend on IRQ latency.
+     *
+     * With WIRE_FAST_STREAM the first sample opens a write transaction that is never
+     * stopped. Between samples the TX FIFO runs empty and the I2C block holds SCL low
+     * (IC_EMPTYFIFO_HOLD_MASTER_EN), so the next sample's two bytes continue the same
+     * transaction. After an abort the controller has sent a STOP, and the next sample's
+     * first byte starts a new transaction with START and address.
+     *
+     * @param sampleRate Paced output rate in Hz, 0 = no pacing (submitBlock() only)
+     * @param clock Sample clock source (ignored without a sample rate)
+     * @param wire Bus format of the submitted words
+     * @return true if successful, false if not initialized, the clock cannot produce the rate, or
+     *         a fan-out address is set with WIRE_FAST_STREAM
+     */
+    bool beginAsync(uint32_t sampleRate = 0, SampleClock clock = SAMPLE_CLOCK_DMA_TIMER,
+                    WireFormat wire = WIRE_WRITE_DAC);
+
+    /**
+     * @brief Stop any transfer, close an open stream with a STOP and release the DMA resources
+     */
+    void endAsync();
+
+    /**
+     * @brief Send samples back to back at I2C speed
+     * @param words getWordsPerSample() x getTargetCount() data_cmd words per sample, must stay valid until completion
+     * @param numSamples Number of samples
+     * @return true if started, false if busy or beginAsync() was not called
+     */
+    bool submitBlock(const uint16_t *words, uint32_t numSamples);
+
+    /**
+     * @brief Send one sample per pacing timer tick
+     * @param samplePtrs Per-sample pointers to getWordsPerSample() x getTargetCount() data_cmd words, must stay
+     *                   valid until completion
+     * @param numSamples Number of samples
+     * @return true if started, false if busy or beginAsync() had no sample rate
+     */
+    bool submitPacedBlock(const uint16_t *const *samplePtrs, uint32_t numSamples);
+
+    /**
+     * @brief Set the completion callback (nullptr = no completion IRQ)
+     */
+    void setCompletionCallback(CompletionCallback callback, void *userData = nullptr);
+
+    /**
+     * @brief Check if a submitted block is still being issued by DMA
+     * @return true while a block is in flight (cheap enough to call from an IRQ)
+     */
+    bool isBusy() const;
+
+    /**
+     * @brief Check for and clear a pending I2C abort (for callers without a callback)
+     * @return ASYNC_OK, or the abort that was pending
+     */
+    AsyncResult pollAsyncError();
+
+    /**
+     * @brief Number of I2C aborts seen by the asynchronous path
+     */
+    uint32_t getAsyncErrorCount() const;
+
+    /**
+     * @brief Most recent I2C abort (ASYNC_OK if none yet)
+     */
+    AsyncResult getLastAsyncError() const;
+
+    /**
+     * @brief Raw IC_TX_ABRT_SOURCE of the most recent abort
+     */
+    uint32_t getLastAbortSource() const;
+
+    /**
+     * @brief DMA channel feeding the I2C data_cmd register (-1 if not in async mode)
+     */
+    int getDmaChannel() const;
+
+    /**
+     * @brief DMA pacing channel (-1 if not paced)
+     */
+    int getPaceChannel() const;
+
+    /**
+     * @brief Rate the sample clock actually runs at, from clk_sys and its divider (0 if not paced)
+     */
+    float getPacedRate() const;
+
+    /**
+     * @brief Check that the clk_sys-derived timings can follow clk_sys to a new rate
+     *
+     * Needs a DMA timer numerator that is exact with the denominator beginAsync() chose, and
+     * legal SCL counts for I2C_BAUD_HZ. Never possible with WIRE_FAST_STREAM (the controller
+     * is only retimed while disabled, which would end the open transaction), a fan-out address
+     * (the STOP_DET hand-off has no idle point the caller can see) or SAMPLE_CLOCK_PWM (the
+     * divider cannot follow clk_sys without a new TOP, which loses the phase).
+     *
+     * @param sysHz Candidate clk_sys rate
+     */
+    bool canRetime(uint32_t sysHz) const;
+
+    /**
+     * @brief Wait for the DMA channel and the bus to go idle (between two samples)
+     * @param timeoutUs Longest wait
+     * @return true if idle
+     */
+    bool waitBusIdle(uint32_t timeoutUs) const;
+
+    /**
+     * @brief Re-derive the I2C SCL counts and the DMA timer numerator after clk_sys changed
+     *
+     * Call with the bus idle, once clock_get_hz(clk_sys) reports the new rate. The DMA timer
+     * keeps its denominator, so its accumulator still counts the same fraction of a sample
+     * period: the sample in progress keeps its length and the paced rate stays exact.
+     *
+     * @return false if canRetime() refuses the new rate (nothing is changed)
+     */
+    bool retime();
+
+    /**
+     * @brief data_cmd words per sample of the bus format selected by beginAsync()
+     */
+    uint32_t getWordsPerSample() const;
+
+    /**
+     * @brief DACs each sample is sent to: 2 with a fan-out address, else 1
+     */
+    uint32_t getTargetCount() const;
+
+    /**
+     * @brief Samples the second DAC missed: the next sample had already started to this DAC
+     *        when the first STOP came, so the second DAC kept its previous value
+     */
+    uint32_t getFanOutLateCount() const;
+
+    /**
+     * @brief I2C address given to the constructor
+     */
+    uint8_t getAddress() const;
+
 private:
     // DAC voltage reference and resolution constants
     static const int32_t DAC_VREF_MV = 5000;    ///< 5V reference in millivolts
@@ -132,11 +358,116 @@ private:
     static const uint8_t CMD_WRITE_DAC = 0x40;        ///< Write DAC register (fast mode)
     static const uint8_t CMD_WRITE_DAC_EEPROM = 0x60; ///< Write DAC and EEPROM
 
+    static const int MAX_ASYNC_INSTANCES = 2; ///< Drivers sharing the DMA IRQ handler
+    static const uint32_t I2C_BAUD_HZ = 2000000; ///< SCL rate, re-derived by retime()
+
     // Internal state variables
+    uint8_t address_;
     bool initialized_;
     uint16_t currentValue_;
     PowerDownMode currentPowerMode_;
 
+    // Asynchronous (DMA) state
+    int dmaChan_;                  ///< I2C data_cmd channel
+    int paceChan_;                 ///< Pacing channel (writes one sample address per tick)
+    int paceTimer_;                ///< DMA pacing timer (SAMPLE_CLOCK_DMA_TIMER)
+    int paceSlice_;                ///< PWM slice (SAMPLE_CLOCK_PWM)
+    float pacedRate_;              ///< Actual sample clock rate in Hz
+    uint32_t sampleRate_;          ///< Paced rate asked of beginAsync(), 0 = not paced
+    uint16_t paceY_;               ///< DMA timer denominator, kept by retime()
+    int irqChan_;                  ///< Channel whose completion raises the callback, -1 = none
+    WireFormat wire_;              ///< Bus format of the submitted words
+    bool streamOpen_;              ///< WIRE_FAST_STREAM: the bus is held by the open transaction
+    CompletionCallback callback_;
+    void *userData_;
+    volatile uint32_t asyncErrors_;
+    volatile AsyncResult lastAsyncError_;
+    volatile uint32_t lastAbortSource_;
+
+    // Fan-out to a second DAC (STOP_DET IRQ)
+    uint8_t fanOutAddress_;              ///< Second DAC, 0 = none
+    volatile bool fanOutSecond_;         ///< IC_TAR points at the second DAC
+    volatile bool fanOutBlock_;          ///< A submitBlock() is in flight (paced samples are not counted)
+    volatile uint32_t fanOutRemaining_;  ///< submitBlock() samples still to start after the current one
+    volatile uint32_t fanOutLate_;
+    volatile AsyncResult fanOutResult_;  ///< First abort seen during the current submitBlock()
+    volatile bool pacePaused_;           ///< Pacing channel held while the second DAC's words are out
+    volatile bool pacePending_;          ///< submitPacedBlock() came while paused, start on resume
+
+    static MCP4725 *asyncInstances_[MAX_ASYNC_INSTANCES];
+    static bool irqHandlerInstalled_;
+    static MCP4725 *fanOutInstance_;
+
+    /**
+     * @brief Shared DMA_IRQ_0 handler, dispatches to every async instance
+     */
+    static void dmaIrqHandler();
+
+    /**
+     * @brief Handle this instance's completion (clear IRQ, decode abort, call back)
+     */
+    void handleDmaIrq();
+
+    /**
+     * @brief I2C STOP_DET handler of the fan-out instance
+     */
+    static void i2cIrqHandler();
+
+    /**
+     * @brief Switch the target after a fan-out transfer and start the next one
+     */
+    void handleStop();
+
+    /**
+     * @brief Hold the sample ticks while the second DAC's words are out (paced fan-out)
+     */
+    void pausePacing();
+
+    /**
+     * @brief Release the sample ticks, starting a block submitted while they were held
+     */
+    void resumePacing();
+
+    /**
+     * @brief Write IC_TAR (only possible with the controller disabled)
+     */
+    static void setTarget(i2c_hw_t *hw, uint8_t address);
+
+    /**
+     * @brief Route the completion IRQ to the given channel (-1 = none)
+     */
+    void setIrqChannel(int chan);
+
+    /**
+     * @brief Decode and clear a pending I2C TX abort
+     */
+    AsyncResult checkAbort();
+
+    /**
+     * @brief End the open WIRE_FAST_STREAM transaction with a STOP (DMA must be stopped)
+     */
+    void closeStream();
+
+    /**
+     * @brief Find X/Y so that clk_sys * X / Y equals the sample rate (DMA pacing timer fraction)
+     * @return true if an exact 16-bit fraction exists
+     */
+    static bool pacingFraction(uint32_t sysHz, uint32_t sampleRate, uint16_t *x, uint16_t *y);
+
+    /**
+     * @brief Find the PWM divider (1.0 to 255.9375 in 1/16 steps) and TOP closest to the sample rate
+     * @param div16 Divider in 1/16 units
+     * @param top Counter wrap value (period = top + 1 divided clocks)
+     * @return true if the rate is within the PWM range
+     */
+    static bool pwmDivider(uint32_t sysHz, uint32_t sampleRate, uint32_t *div16, uint32_t *top);
+
+    /**
+     * @brief Check the SCL counts i2c_set_baudrate() would derive for I2C_BAUD_HZ at sysHz
+     * @return true if they are within the controller's limits
+     */
+    static bool sclTimingValid(uint32_t sysHz);
+
     /**
      * @brief Write value to DAC
      * @param value 12-bit DAC value
@@ -0,0 +1,101 @@
+/**
+ * @file BootLog.cpp
+ * @brief RAM stdout for the start-up log, drained to the UART once audio runs
+ * @author Ale Moglia
+ * @date 2026
+ */
+
+#include "BootLog.h"
+#include <stdio.h>
+#include "pico/stdio_uart.h"
+#include "hardware/uart.h"
+
+BootLog *BootLog::instance_ = nullptr;
+
+BootLog::BootLog() : driver_(), capturing_(false), buffer_(), head_(0), tail_(0), dropped_(0)
+{
+}
+
+bool BootLog::begin()
+{
+    if (capturing_)
+    {
+        return true;
+    }
+
+    driver_.out_chars = outChars;
+#if PICO_STDIO_ENABLE_CRLF_SUPPORT
+    driver_.crlf_enabled = PICO_STDIO_DEFAULT_CRLF; // The ring holds exactly what the UART would have sent
+#endif
+    instance_ = this;
+    capturing_ = true;
+    stdio_set_driver_enabled(&stdio_uart, false);
+    stdio_set_driver_enabled(&driver_, true);
+    return true;
+}
+
+bool BootLog::service()
+{
+    if (!capturing_)
+    {
+        return false;
+    }
+
+    while (tail_ != head_ && uart_is_writable(uart_default))
+    {
+        uart_putc_raw(uart_default, buffer_[tail_ & (BOOT_LOG_BYTES - 1)]);
+        tail_++;
+    }
+    if (tail_ != head_)
+    {
+        return true;
+    }
+
+    release();
+    return false;
+}
+
+void BootLog::flush()
+{
+    while (service())
+    {
+        tight_loop_contents();
+    }
+}
+
+bool BootLog::isCapturing() const
+{
+    return capturing_;
+}
+
+uint32_t BootLog::getDroppedCount() const
+{
+    return dropped_;
+}
+
+void BootLog::outChars(const char *buf, int len)
+{
+    // Called by stdio with its mutex held, so never concurrently with another printf
+    BootLog *log = instance_;
+    for (int i = 0; i < len; i++)
+    {
+        if (log->head_ - log->tail_ == BOOT_LOG_BYTES)
+        {
+            log->dropped_ += (uint32_t)(len - i);
+            return;
+        }
+        log->buffer_[log->head_ & (BOOT_LOG_BYTES - 1)] = buf[i];
+        log->head_++;
+    }
+}
+
+void BootLog::release()
+{
+    stdio_set_driver_enabled(&driver_, false);
+    stdio_set_driver_enabled(&stdio_uart, true);
+    capturing_ = false;
+    if (dropped_ != 0)
+    {
+        printf("BootLog: %lu bytes dropped, raise BOOT_LOG_BYTES\n", dropped_);
+    }
+}
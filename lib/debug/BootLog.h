@@ -0,0 +1,84 @@
+/**
+ * @file BootLog.h
+ * @brief RAM stdout for the start-up log, drained to the UART once audio runs
+ * @author Ale Moglia
+ * @date 2026
+ *
+ * At 115200 baud the UART takes 87µs per character and its FIFO holds 32, so a start-up
+ * banner of a few dozen lines keeps printf waiting for tens of milliseconds before the
+ * first sample is out. begin() takes the UART driver out of stdio and installs one whose
+ * out_chars only copies into a RAM ring, so every printf (the drivers' ones included)
+ * returns in microseconds.
+ *
+ * service() runs in the main loop once the output has started and moves as many bytes
+ * as the UART FIFO has room for, never waiting on it. When the ring is empty it puts the
+ * UART driver back, and printf is blocking UART output again from then on. Bytes that do
+ * not fit the ring are dropped and counted: the earliest lines are the ones kept.
+ */
+
+#ifndef BOOT_LOG_H
+#define BOOT_LOG_H
+
+#include "pico/stdlib.h"
+#include "pico/stdio.h"
+
+// Start-up log held in RAM until the UART has sent it (power of two)
+#ifndef BOOT_LOG_BYTES
+#define BOOT_LOG_BYTES 4096
+#endif
+
+/**
+ * @brief Start-up stdout capture
+ */
+class BootLog
+{
+public:
+    /**
+     * @brief Constructor
+     */
+    BootLog();
+
+    /**
+     * @brief Send stdout to the RAM ring instead of the UART
+     * @return true if capturing
+     */
+    bool begin();
+
+    /**
+     * @brief Move what the UART FIFO can take and hand stdout back once drained (main loop)
+     * @return true while captured output is still waiting
+     */
+    bool service();
+
+    /**
+     * @brief Send everything still held, waiting on the UART, and hand stdout back
+     */
+    void flush();
+
+    /**
+     * @brief true between begin() and the end of the drain
+     */
+    bool isCapturing() const;
+
+    /**
+     * @brief Bytes dropped because the ring was full
+     */
+    uint32_t getDroppedCount() const;
+
+private:
+    static void outChars(const char *buf, int len);
+    void release();
+
+    static_assert((BOOT_LOG_BYTES & (BOOT_LOG_BYTES - 1)) == 0, "BOOT_LOG_BYTES must be a power of two");
+
+    static BootLog *instance_;
+
+    stdio_driver_t driver_;
+    bool capturing_;
+    char buffer_[BOOT_LOG_BYTES];
+    uint32_t head_; ///< Bytes ever captured
+    uint32_t tail_; ///< Bytes ever sent
+    uint32_t dropped_;
+};
+
+#endif // BOOT_LOG_H
@@ -0,0 +1,89 @@
+/**
+ * @file CaptureFormat.h
+ * @brief Packet format of the USB audio capture stream, shared by the firmware and the host tools
+ * @author Ale Moglia
+ * @date 2026
+ *
+ * The stream is a sequence of packets, one per Heavy block, with no framing besides the
+ * header magic. Each packet is a CaptureHeader followed by channels x frames samples in
+ * the layout of the Heavy output buffer (all of channel 0, then all of channel 1, ...).
+ * Everything is little-endian, which is the native order of both the RP2350 and the hosts.
+ *
+ * The sequence number is the index of the Heavy block since the context was created, so a
+ * host can render the same block natively and compare. A jump in the sequence means the
+ * sink dropped packets, not that Heavy skipped a block.
+ *
+ * This header has no Pico SDK dependencies.
+ */
+
+#ifndef CAPTURE_FORMAT_H
+#define CAPTURE_FORMAT_H
+
+#include <stdint.h>
+
+#define CAPTURE_MAGIC 0x31435648u // "HVC1"
+#define CAPTURE_MAX_CHANNELS 8
+#define CAPTURE_MAX_FRAMES 1024
+
+/**
+ * @brief Sample encoding of a packet
+ */
+enum CaptureFormat
+{
+    CAPTURE_FORMAT_S16 = 0, ///< Signed 16-bit, see captureToS16()
+    CAPTURE_FORMAT_F32 = 1, ///< IEEE 754 float, bit-exact copy of the Heavy output
+};
+
+/**
+ * @brief Header in front of every block of samples (16 bytes)
+ */
+struct CaptureHeader
+{
+    uint32_t magic;    ///< CAPTURE_MAGIC
+    uint32_t sequence; ///< Heavy block index since the context was created
+    uint16_t frames;   ///< Samples per channel
+    uint8_t channels;  ///< Number of channels
+    uint8_t format;    ///< CaptureFormat
+    uint32_t dropped;  ///< Packets the sink has dropped so far (queue full)
+};
+
+static_assert(sizeof(CaptureHeader) == 16, "CaptureHeader must have no padding");
+
+/**
+ * @brief Size of one encoded sample in bytes
+ */
+static inline uint32_t captureSampleBytes(uint32_t format)
+{
+    return format == CAPTURE_FORMAT_F32 ? 4 : 2;
+}
+
+/**
+ * @brief Check that a header read from the stream is plausible (used to resynchronise)
+ */
+static inline bool captureHeaderValid(const CaptureHeader *h)
+{
+    return h->magic == CAPTURE_MAGIC && h->format <= CAPTURE_FORMAT_F32 && h->channels >= 1 &&
+           h->channels <= CAPTURE_MAX_CHANNELS && h->frames >= 1 && h->frames <= CAPTURE_MAX_FRAMES;
+}
+
+/**
+ * @brief Convert a Heavy sample to 16 bits: clip to -1..+1, scale by 32767, round half away from zero
+ *
+ * Plain float arithmetic, so the firmware and a host render of the same float produce
+ * the same integer.
+ */
+static inline int16_t captureToS16(float x)
+{
+    if (x > 1.0f)
+    {
+        x = 1.0f;
+    }
+    else if (!(x >= -1.0f)) // also NaN
+    {
+        x = -1.0f;
+    }
+    const float scaled = x * 32767.0f;
+    return (int16_t)(scaled >= 0.0f ? scaled + 0.5f : scaled - 0.5f);
+}
+
+#endif // CAPTURE_FORMAT_H
@@ -0,0 +1,146 @@
+/**
+ * @file CycleProfiler.h
+ * @brief Cycle-accurate section timing with the Cortex-M33 DWT cycle counter
+ * @author Ale Moglia
+ * @date 2026
+ *
+ * Each CycleStat keeps count, min, max, total and a histogram of one code section,
+ * measured in clk_sys cycles with DWT CYCCNT. The histogram has CYCLE_PROFILE_BINS
+ * bins of budget/8 cycles each, so bin 8 onwards is over budget and the last bin
+ * collects everything from 2x the budget upwards.
+ *
+ * With CYCLE_PROFILE=0 (default) the CYCLE_PROFILE_BEGIN/END macros expand to nothing.
+ *
+ * Each stat must only be recorded from one context (one IRQ, or one core's main loop).
+ * The printer reads it without locking, so one line may mix two consecutive updates.
+ */
+
+#ifndef CYCLE_PROFILER_H
+#define CYCLE_PROFILER_H
+
+#include <stdio.h>
+#include <stdint.h>
+
+#ifndef CYCLE_PROFILE
+#define CYCLE_PROFILE 0
+#endif
+
+#define CYCLE_PROFILE_BINS 16 // bin width = budget / 8, last bin = 2x budget and over
+
+#if CYCLE_PROFILE
+#include "hardware/structs/m33.h"
+
+/**
+ * @brief Statistics of one profiled section
+ */
+struct CycleStat
+{
+    const char *name;
+    uint32_t budgetCycles; // deadline of the section
+    uint32_t binCycles;    // histogram bin width
+    volatile uint32_t count;
+    volatile uint32_t minCycles;
+    volatile uint32_t maxCycles;
+    volatile uint64_t totalCycles;
+    volatile uint32_t hist[CYCLE_PROFILE_BINS];
+};
+
+/**
+ * @brief Enable the DWT cycle counter of the calling core (each core has its own)
+ */
+static inline void cycleProfilerInit(void)
+{
+    m33_hw->demcr |= M33_DEMCR_TRCENA_BITS;
+    m33_hw->dwt_cyccnt = 0;
+    m33_hw->dwt_ctrl |= M33_DWT_CTRL_CYCCNTENA_BITS;
+}
+
+/**
+ * @brief Current cycle count of the calling core
+ */
+static inline uint32_t cycleProfilerNow(void)
+{
+    return m33_hw->dwt_cyccnt;
+}
+
+/**
+ * @brief Clear a stat and set its name and deadline
+ * @param budgetCycles Deadline in clk_sys cycles, sets the histogram scale
+ */
+static inline void cycleStatInit(CycleStat *s, const char *name, uint32_t budgetCycles)
+{
+    s->name = name;
+    s->budgetCycles = budgetCycles;
+    s->binCycles = budgetCycles >= 8 ? budgetCycles / 8 : 1;
+    s->count = 0;
+    s->minCycles = UINT32_MAX;
+    s->maxCycles = 0;
+    s->totalCycles = 0;
+    for (int i = 0; i < CYCLE_PROFILE_BINS; i++)
+    {
+        s->hist[i] = 0;
+    }
+}
+
+/**
+ * @brief Add one measurement (a few cycles: compares, one UDIV, two stores)
+ */
+static inline void cycleStatRecord(CycleStat *s, uint32_t cycles)
+{
+    s->count = s->count + 1;
+    s->totalCycles = s->totalCycles + cycles;
+    if (cycles < s->minCycles)
+    {
+        s->minCycles = cycles;
+    }
+    if (cycles > s->maxCycles)
+    {
+        s->maxCycles = cycles;
+    }
+    uint32_t bin = cycles / s->binCycles;
+    if (bin >= CYCLE_PROFILE_BINS)
+    {
+        bin = CYCLE_PROFILE_BINS - 1;
+    }
+    s->hist[bin] = s->hist[bin] + 1;
+}
+
+/**
+ * @brief Print one stat: min/mean/max in cycles and microseconds, worst case against the
+ * budget, then the histogram (bins of budget/8, '|' marks the deadline)
+ * @param cyclesPerUs clk_sys cycles per microsecond
+ */
+static inline void cycleStatPrint(const CycleStat *s, uint32_t cyclesPerUs)
+{
+    const uint32_t count = s->count;
+    if (count == 0)
+    {
+        printf("  %-16s no samples\n", s->name);
+        return;
+    }
+    const uint32_t mean = (uint32_t)(s->totalCycles / count);
+    printf("  %-16s n=%lu min/mean/max %lu/%lu/%lu cyc = %.2f/%.2f/%.2f us, worst %.1f%% of %.1f us\n",
+           s->name, (unsigned long)count, (unsigned long)s->minCycles, (unsigned long)mean,
+           (unsigned long)s->maxCycles, (float)s->minCycles / cyclesPerUs, (float)mean / cyclesPerUs,
+           (float)s->maxCycles / cyclesPerUs, s->maxCycles * 100.0f / s->budgetCycles,
+           (float)s->budgetCycles / cyclesPerUs);
+    printf("  %-16s", "");
+    for (int i = 0; i < CYCLE_PROFILE_BINS; i++)
+    {
+        printf(i == 8 ? " | %lu" : " %lu", (unsigned long)s->hist[i]);
+    }
+    printf("\n");
+}
+
+// Time a section: CYCLE_PROFILE_BEGIN(t); ... CYCLE_PROFILE_END(stat, t);
+#define CYCLE_PROFILE_BEGIN(_t) const uint32_t _t = cycleProfilerNow()
+#define CYCLE_PROFILE_END(_stat, _t) cycleStatRecord(&(_stat), cycleProfilerNow() - (_t))
+
+#else // CYCLE_PROFILE
+
+#define CYCLE_PROFILE_BEGIN(_t)
+#define CYCLE_PROFILE_END(_stat, _t)
+
+#endif // CYCLE_PROFILE
+
+#endif // CYCLE_PROFILER_H
@@ -0,0 +1,134 @@
+/**
+ * @file EventLog.cpp
+ * @brief Timestamped ring of output glitches (underruns, bus collisions, I2C aborts, overruns)
+ * @author Ale Moglia
+ * @date 2026
+ */
+
+#include "EventLog.h"
+#include <stdio.h>
+#include "hardware/timer.h"
+#include "../HotPath.h"
+
+const char *const EventLog::CAUSE_NAMES[EVENT_CAUSE_COUNT] = {
+    "queue empty", "DAC busy", "bus collision", "I2C abort", "producer late", "overrun", "IRQ late", "load shed",
+};
+
+EventLog::EventLog() : lock_(nullptr), events_(), head_(0), counts_()
+{
+}
+
+bool EventLog::init()
+{
+    lock_ = spin_lock_instance(spin_lock_claim_unused(true));
+    clear();
+    return true;
+}
+
+void HOT_FUNC(EventLog::record)(EventCause cause, uint32_t fill, uint32_t detail)
+{
+    if (lock_ == nullptr)
+    {
+        return;
+    }
+
+    const uint32_t now = timer_hw->timerawl;
+    const uint32_t saved = spin_lock_blocking(lock_);
+
+    counts_[cause] = counts_[cause] + 1;
+
+    const uint32_t head = head_;
+    Event *last = &events_[(head - 1) & (EVENT_LOG_SIZE - 1)];
+    if (head != 0 && last->cause == cause && now - last->lastUs <= EVENT_LOG_MERGE_US && last->count != 0xFFFF)
+    {
+        // Same glitch still going on: one entry for the whole run
+        last->lastUs = now;
+        last->count = last->count + 1;
+    }
+    else
+    {
+        Event *e = &events_[head & (EVENT_LOG_SIZE - 1)];
+        e->timeUs = now;
+        e->lastUs = now;
+        e->detail = detail;
+        e->fill = fill > 0xFFFF ? 0xFFFF : (uint16_t)fill;
+        e->count = 1;
+        e->cause = cause;
+        head_ = head + 1;
+    }
+
+    spin_unlock(lock_, saved);
+}
+
+void EventLog::clear()
+{
+    if (lock_ == nullptr)
+    {
+        return;
+    }
+    const uint32_t saved = spin_lock_blocking(lock_);
+    head_ = 0;
+    for (int i = 0; i < EVENT_CAUSE_COUNT; i++)
+    {
+        counts_[i] = 0;
+    }
+    spin_unlock(lock_, saved);
+}
+
+uint32_t EventLog::getEntryCount() const
+{
+    return head_;
+}
+
+uint32_t EventLog::getCount(EventCause cause) const
+{
+    return counts_[cause];
+}
+
+void EventLog::dump() const
+{
+    const uint32_t head = head_;
+    const uint32_t held = head < EVENT_LOG_SIZE ? head : EVENT_LOG_SIZE;
+    const uint32_t now = timer_hw->timerawl;
+    printf("Event log: %lu entries, %lu held (TIMERAWL now %lu us)\n", head, held, now);
+
+    for (uint32_t i = head - held; i != head; i++)
+    {
+        // Copy under the lock so a merge in progress is never printed half-written
+        const uint32_t saved = spin_lock_blocking(lock_);
+        const bool overwritten = head_ - i > EVENT_LOG_SIZE;
+        const Event e = events_[i & (EVENT_LOG_SIZE - 1)];
+        spin_unlock(lock_, saved);
+        if (overwritten)
+        {
+            continue; // Recorded over while printing
+        }
+
+        printf("  #%-5lu %10lu us (%lu ms ago) %-14s fill %3u", i, e.timeUs, (now - e.timeUs) / 1000,
+               causeName(e.cause), e.fill);
+        if (e.count > 1)
+        {
+            printf(" x%u over %lu us", e.count, e.lastUs - e.timeUs);
+        }
+        if (e.detail != 0)
+        {
+            printf(" detail 0x%08lx", e.detail);
+        }
+        printf("\n");
+    }
+}
+
+void EventLog::printStatus() const
+{
+    printf("  Events: %lu logged |", head_);
+    for (int i = 0; i < EVENT_CAUSE_COUNT; i++)
+    {
+        printf(" %s %lu%s", causeName((EventCause)i), counts_[i], i + 1 < EVENT_CAUSE_COUNT ? "," : "");
+    }
+    printf(" | 'e' dumps, 'c' clears\n");
+}
+
+const char *EventLog::causeName(EventCause cause)
+{
+    return cause < EVENT_CAUSE_COUNT ? CAUSE_NAMES[cause] : "?";
+}
@@ -0,0 +1,133 @@
+/**
+ * @file EventLog.h
+ * @brief Timestamped ring of output glitches (underruns, bus collisions, I2C aborts, overruns)
+ * @author Ale Moglia
+ * @date 2026
+ *
+ * The aggregate underrun and overrun counters cannot tell a busy bus from a late
+ * producer. record() keeps each anomaly instead: the TIMERAWL microsecond timestamp,
+ * the cause, the output fill level at that moment and a cause-specific detail word.
+ *
+ * It is cheap enough to leave on: nothing runs until something goes wrong, and then a
+ * hardware spin lock (IRQs off for a few dozen cycles) makes it safe from any IRQ on
+ * either core. An event of the same cause within EVENT_LOG_MERGE_US of the previous one
+ * is folded into it as a repeat, so a long stall takes one entry, not one per sample.
+ * The oldest entries are overwritten once the ring is full. Per-cause totals are kept
+ * separately and never wrap.
+ *
+ * dump() prints the ring from the main loop (the firmware does it on 'e' over UART),
+ * copying one entry at a time so the IRQs are never held off for longer than a record.
+ */
+
+#ifndef EVENT_LOG_H
+#define EVENT_LOG_H
+
+#include "pico/stdlib.h"
+#include "hardware/sync.h"
+
+// Entries kept (power of two, 20 bytes each)
+#ifndef EVENT_LOG_SIZE
+#define EVENT_LOG_SIZE 128
+#endif
+
+// Same-cause events closer than this are merged into one entry (a little over one 64-sample block)
+#ifndef EVENT_LOG_MERGE_US
+#define EVENT_LOG_MERGE_US 2000
+#endif
+
+/**
+ * @brief Why the output glitched
+ */
+enum EventCause : uint8_t
+{
+    EVENT_QUEUE_EMPTY = 0, ///< Sample tick with no queued sample (timer IRQ mode)
+    EVENT_DAC_BUSY,        ///< Sample tick while the previous DMA transfer still runs
+    EVENT_BUS_COLLISION,   ///< Sample tick while the control scanner owns the bus
+    EVENT_I2C_ABORT,       ///< I2C abort (NAK, arbitration lost), detail = IC_TX_ABRT_SOURCE
+    EVENT_PRODUCER_LATE,   ///< No block ready at a block boundary, the DAC holds (DMA block mode)
+    EVENT_OVERRUN,         ///< Heavy block dropped, the resampler FIFO was full
+    EVENT_IRQ_LATE,        ///< Sample IRQ ran a whole period late, detail = microseconds late
+    EVENT_LOAD_SHED,       ///< Deadline monitor took a shed step, detail = step now in force
+    EVENT_CAUSE_COUNT
+};
+
+/**
+ * @brief Fixed-size glitch log shared by the IRQs and the producer
+ */
+class EventLog
+{
+public:
+    /**
+     * @brief One anomaly, or a run of the same one
+     */
+    struct Event
+    {
+        uint32_t timeUs; ///< TIMERAWL at the first occurrence
+        uint32_t lastUs; ///< TIMERAWL at the last merged occurrence
+        uint32_t detail; ///< Cause-specific, see EventCause
+        uint16_t fill;   ///< Output fill in samples at the first occurrence
+        uint16_t count;  ///< Occurrences merged into this entry (saturates)
+        EventCause cause;
+    };
+
+    /**
+     * @brief Constructor
+     */
+    EventLog();
+
+    /**
+     * @brief Claim the spin lock (record() ignores events before this)
+     * @return true if initialized
+     */
+    bool init();
+
+    /**
+     * @brief Log one anomaly (any core, any IRQ)
+     * @param cause What went wrong
+     * @param fill Output fill level in samples
+     * @param detail Cause-specific value, see EventCause
+     */
+    void record(EventCause cause, uint32_t fill, uint32_t detail = 0);
+
+    /**
+     * @brief Forget every entry and total
+     */
+    void clear();
+
+    /**
+     * @brief Number of entries recorded since the last clear (held ones are the last EVENT_LOG_SIZE)
+     */
+    uint32_t getEntryCount() const;
+
+    /**
+     * @brief Occurrences of one cause, merged repeats included
+     */
+    uint32_t getCount(EventCause cause) const;
+
+    /**
+     * @brief Print the held entries, oldest first (main loop)
+     */
+    void dump() const;
+
+    /**
+     * @brief Print the per-cause totals
+     */
+    void printStatus() const;
+
+    /**
+     * @brief Short name of a cause
+     */
+    static const char *causeName(EventCause cause);
+
+private:
+    static const char *const CAUSE_NAMES[EVENT_CAUSE_COUNT];
+
+    static_assert((EVENT_LOG_SIZE & (EVENT_LOG_SIZE - 1)) == 0, "EVENT_LOG_SIZE must be a power of two");
+
+    spin_lock_t *lock_;
+    Event events_[EVENT_LOG_SIZE];
+    volatile uint32_t head_; ///< Entries ever written, the newest is events_[(head_ - 1) % EVENT_LOG_SIZE]
+    volatile uint32_t counts_[EVENT_CAUSE_COUNT];
+};
+
+#endif // EVENT_LOG_H
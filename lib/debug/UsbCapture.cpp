@@ -0,0 +1,133 @@
+/**
+ * @file UsbCapture.cpp
+ * @brief Debug sink that streams Heavy output blocks over USB CDC for bit-exact regression tests
+ * @author Ale Moglia
+ * @date 2026
+ */
+
+#include "UsbCapture.h"
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdio.h"
+#include "pico/stdio_usb.h"
+#include "tusb.h"
+#include "../HotPath.h"
+
+UsbCapture::UsbCapture()
+    : initialized_(false), format_(CAPTURE_FORMAT_S16), sequence_(0), dropped_(0), sendOffset_(0),
+      connected_(false), sent_(0)
+{
+}
+
+bool UsbCapture::init(CaptureFormat format)
+{
+    // The CDC port now carries packets only, printf keeps the UART
+    stdio_set_driver_enabled(&stdio_usb, false);
+    format_ = format;
+    initialized_ = true;
+    return true;
+}
+
+bool HOT_FUNC(UsbCapture::push)(const float *samples, uint32_t frames, uint32_t channels)
+{
+    const uint32_t sequence = sequence_++;
+    const uint32_t count = frames * channels;
+    if (!initialized_ || count > USB_CAPTURE_MAX_SAMPLES)
+    {
+        return false;
+    }
+
+    Packet *packet = queue_.writeSlot();
+    if (packet == nullptr)
+    {
+        dropped_ = dropped_ + 1;
+        return false;
+    }
+
+    packet->header.magic = CAPTURE_MAGIC;
+    packet->header.sequence = sequence;
+    packet->header.frames = (uint16_t)frames;
+    packet->header.channels = (uint8_t)channels;
+    packet->header.format = (uint8_t)format_;
+    packet->header.dropped = dropped_;
+    if (format_ == CAPTURE_FORMAT_F32)
+    {
+        memcpy(packet->f32, samples, count * sizeof(float));
+    }
+    else
+    {
+        for (uint32_t i = 0; i < count; i++)
+        {
+            packet->s16[i] = captureToS16(samples[i]);
+        }
+    }
+    packet->bytes = sizeof(CaptureHeader) + count * captureSampleBytes(format_);
+
+    // Publish the packet (release store: header and samples are visible to service() first)
+    queue_.commit();
+    return true;
+}
+
+void UsbCapture::service()
+{
+    if (!initialized_)
+    {
+        return;
+    }
+
+    connected_ = stdio_usb_connected();
+    if (!connected_)
+    {
+        // Nobody is listening: keep the queue empty so the producer does not count drops
+        queue_.release(queue_.size());
+        sendOffset_ = 0;
+        return;
+    }
+
+    const Packet *packet;
+    while ((packet = queue_.peek()) != nullptr)
+    {
+        // Never offer more than the FIFO has room for, so the stdio_usb write does not wait
+        const uint32_t space = tud_cdc_write_available();
+        if (space == 0)
+        {
+            return;
+        }
+        uint32_t n = packet->bytes - sendOffset_;
+        if (n > space)
+        {
+            n = space;
+        }
+        stdio_usb.out_chars((const char *)packet + sendOffset_, (int)n);
+        sendOffset_ += n;
+        if (sendOffset_ < packet->bytes)
+        {
+            return;
+        }
+
+        queue_.release();
+        sendOffset_ = 0;
+        sent_ = sent_ + 1;
+    }
+}
+
+bool UsbCapture::isConnected() const
+{
+    return connected_;
+}
+
+uint32_t UsbCapture::getSentCount() const
+{
+    return sent_;
+}
+
+uint32_t UsbCapture::getDroppedCount() const
+{
+    return dropped_;
+}
+
+void UsbCapture::printStatus() const
+{
+    printf("  USB capture: %s | %s | sent %lu | dropped %lu | queued %lu\n", connected_ ? "connected" : "no host",
+           format_ == CAPTURE_FORMAT_F32 ? "f32" : "s16", sent_, dropped_, queue_.size());
+}
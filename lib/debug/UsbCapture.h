@@ -0,0 +1,126 @@
+/**
+ * @file UsbCapture.h
+ * @brief Debug sink that streams Heavy output blocks over USB CDC for bit-exact regression tests
+ * @author Ale Moglia
+ * @date 2026
+ *
+ * The producer hands each rendered block to push(), which encodes it (16-bit or raw
+ * float, see CaptureFormat.h) into a free packet of a lock-free SPSC queue and returns.
+ * It never waits for USB: if every packet is still queued, the block is dropped and
+ * counted, and the header of the next packet sent carries the running drop count.
+ *
+ * service() runs in the core 0 main loop and moves queued packets into the TinyUSB CDC
+ * FIFO, never more than the FIFO can take at once, so the SDK's stdio_usb write returns
+ * straight away. While no host has the port open, queued packets are discarded instead
+ * of being counted as drops.
+ *
+ * printf stays on the UART: init() takes the USB CDC driver out of stdio so the capture
+ * stream carries nothing but packets.
+ */
+
+#ifndef USB_CAPTURE_H
+#define USB_CAPTURE_H
+
+#include "pico/stdlib.h"
+#include "CaptureFormat.h"
+#include "../audio/SpscQueue.h"
+
+// Largest block in samples, all channels together (Heavy stereo output x 64 frames)
+#ifndef USB_CAPTURE_MAX_SAMPLES
+#define USB_CAPTURE_MAX_SAMPLES 128
+#endif
+
+// Packets between the producer and the USB FIFO (8 x 64 frames = 12.8ms @ 40kHz)
+#ifndef USB_CAPTURE_QUEUE_PACKETS
+#define USB_CAPTURE_QUEUE_PACKETS 8
+#endif
+
+/**
+ * @brief Heavy output tee over the USB CDC port
+ */
+class UsbCapture
+{
+public:
+    /**
+     * @brief Constructor
+     */
+    UsbCapture();
+
+    /**
+     * @brief Take the USB CDC port out of stdio and select the sample encoding
+     *
+     * Call after stdio_init_all(), with the firmware linked against pico_stdio_usb.
+     *
+     * @param format CAPTURE_FORMAT_S16 or CAPTURE_FORMAT_F32
+     * @return true if initialized
+     */
+    bool init(CaptureFormat format);
+
+    /**
+     * @brief Queue one Heavy block (producer only, never blocks)
+     *
+     * Every call is one Heavy block and advances the sequence number, including the
+     * blocks that are dropped.
+     *
+     * @param samples Heavy output: frames samples of channel 0, then channel 1, ...
+     * @param frames Samples per channel
+     * @param channels Number of channels
+     * @return true if queued, false if dropped (queue full or block too large)
+     */
+    bool push(const float *samples, uint32_t frames, uint32_t channels);
+
+    /**
+     * @brief Hand queued packets to USB, as much as the CDC FIFO can take (core 0 main loop)
+     */
+    void service();
+
+    /**
+     * @brief Check if a host has the CDC port open
+     */
+    bool isConnected() const;
+
+    /**
+     * @brief Number of packets completely handed to USB
+     */
+    uint32_t getSentCount() const;
+
+    /**
+     * @brief Number of blocks dropped because every packet was queued
+     */
+    uint32_t getDroppedCount() const;
+
+    /**
+     * @brief Print the connection state and the counters
+     */
+    void printStatus() const;
+
+private:
+    /**
+     * @brief One queued block, header and encoded samples
+     */
+    struct Packet
+    {
+        CaptureHeader header;
+        union
+        {
+            int16_t s16[USB_CAPTURE_MAX_SAMPLES];
+            float f32[USB_CAPTURE_MAX_SAMPLES];
+        };
+        uint32_t bytes; ///< Header plus samples, not sent
+    };
+
+    bool initialized_;
+    CaptureFormat format_;
+    SpscQueue<Packet, USB_CAPTURE_QUEUE_PACKETS> queue_;
+
+    // Producer only (read by the status print)
+    uint32_t sequence_;
+    volatile uint32_t dropped_;
+
+    // service() only
+    uint32_t sendOffset_; ///< Bytes of the oldest packet already handed to USB
+    bool connected_;
+    volatile uint32_t sent_;
+};
+
+#endif // USB_CAPTURE_H
@@ -0,0 +1,134 @@
+/**
+ * @file XipStats.h
+ * @brief XIP cache hit and miss counters, for the whole system and per real-time section
+ * @author Ale Moglia
+ * @date 2026
+ *
+ * The XIP controller counts every cached flash access (CTR_ACC) and every hit (CTR_HIT).
+ * Access minus hit is the number of misses, each one a QSPI refill that stalls the
+ * requesting master for far longer than a hit.
+ *
+ * xipStatsPrint() reports the totals since the previous call and clears the saturating
+ * counters. An XipSection keeps the misses between XIP_SECTION_BEGIN and XIP_SECTION_END
+ * of one code section: how many runs missed at all, the total and the worst run. With
+ * HOT_PATH_IN_RAM the real-time sections should show no misses.
+ *
+ * The counters are shared by both cores and the DMA, so a section also counts misses
+ * made elsewhere while it runs. A count of zero still proves the section never waited
+ * for flash. A run during which the printer cleared the counters is not recorded.
+ *
+ * With XIP_STATS=0 (default) the XIP_SECTION_BEGIN/END macros expand to nothing.
+ */
+
+#ifndef XIP_STATS_H
+#define XIP_STATS_H
+
+#include <stdio.h>
+#include <stdint.h>
+
+#ifndef XIP_STATS
+#define XIP_STATS 0
+#endif
+
+#if XIP_STATS
+#include "hardware/structs/xip_ctrl.h"
+
+/**
+ * @brief XIP misses of one section
+ */
+struct XipSection
+{
+    const char *name;
+    volatile uint32_t count;     // runs recorded
+    volatile uint32_t missed;    // runs with at least one miss
+    volatile uint32_t misses;    // total misses
+    volatile uint32_t maxMisses; // worst run
+};
+
+/**
+ * @brief Misses since the counters were last cleared (two register reads)
+ */
+static inline uint32_t xipMissCount(void)
+{
+    const uint32_t hits = xip_ctrl_hw->ctr_hit;
+    return xip_ctrl_hw->ctr_acc - hits;
+}
+
+/**
+ * @brief Clear the hit and access counters (writing any value clears them)
+ */
+static inline void xipStatsClear(void)
+{
+    xip_ctrl_hw->ctr_hit = 0;
+    xip_ctrl_hw->ctr_acc = 0;
+}
+
+/**
+ * @brief Clear a section and set its name
+ */
+static inline void xipSectionInit(XipSection *s, const char *name)
+{
+    s->name = name;
+    s->count = 0;
+    s->missed = 0;
+    s->misses = 0;
+    s->maxMisses = 0;
+}
+
+/**
+ * @brief Add one run of the section
+ * @param misses Difference of xipMissCount() across the run
+ */
+static inline void xipSectionRecord(XipSection *s, uint32_t misses)
+{
+    if (misses >= 0x80000000u)
+    {
+        return; // The counters were cleared during the run
+    }
+    s->count = s->count + 1;
+    if (misses != 0)
+    {
+        s->missed = s->missed + 1;
+        s->misses = s->misses + misses;
+        if (misses > s->maxMisses)
+        {
+            s->maxMisses = misses;
+        }
+    }
+}
+
+/**
+ * @brief Print the accesses and misses since the last call, then clear the counters
+ */
+static inline void xipStatsPrint(void)
+{
+    const uint32_t hits = xip_ctrl_hw->ctr_hit;
+    const uint32_t accesses = xip_ctrl_hw->ctr_acc;
+    xipStatsClear();
+    const uint32_t misses = accesses > hits ? accesses - hits : 0;
+    printf("  XIP cache: %lu accesses, %lu misses (%.3f%% hits)\n", (unsigned long)accesses,
+           (unsigned long)misses, accesses != 0 ? hits * 100.0f / accesses : 100.0f);
+}
+
+/**
+ * @brief Print one section: runs with a miss, total and worst run
+ */
+static inline void xipSectionPrint(const XipSection *s)
+{
+    printf("  %-16s XIP misses in %lu of %lu runs, total %lu, worst run %lu\n", s->name,
+           (unsigned long)s->missed, (unsigned long)s->count, (unsigned long)s->misses,
+           (unsigned long)s->maxMisses);
+}
+
+// Count a section's misses: XIP_SECTION_BEGIN(m); ... XIP_SECTION_END(section, m);
+#define XIP_SECTION_BEGIN(_m) const uint32_t _m = xipMissCount()
+#define XIP_SECTION_END(_sec, _m) xipSectionRecord(&(_sec), xipMissCount() - (_m))
+
+#else // XIP_STATS
+
+#define XIP_SECTION_BEGIN(_m)
+#define XIP_SECTION_END(_sec, _m)
+
+#endif // XIP_STATS
+
+#endif // XIP_STATS_H
@@ -0,0 +1,152 @@
+/**
+ * @file GateInput.cpp
+ * @brief CLK and LOOP gate inputs captured with their edge time for sample-accurate Heavy messages
+ * @author Ale Moglia
+ * @date 2026
+ */
+
+#include "GateInput.h"
+#include <stdio.h>
+#include "hardware/gpio.h"
+#include "hardware/irq.h"
+#include "hardware/timer.h"
+#include "../HotPath.h"
+
+const GateInput::Input GateInput::INPUTS[GateInput::NUM_INPUTS] = {
+    {CLK_GATE_INPUT_PIN, "clk_gate"},
+    {LOOP_GATE_INPUT_PIN, "loop_gate"},
+};
+
+GateInput *GateInput::instance_ = nullptr;
+
+GateInput::GateInput() : initialized_(false), edgeCount_(0), dropped_(0)
+{
+}
+
+bool GateInput::init()
+{
+    if (initialized_)
+    {
+        return true;
+    }
+
+    uint32_t mask = 0;
+    for (int i = 0; i < NUM_INPUTS; i++)
+    {
+        gpio_init(INPUTS[i].pin);
+        gpio_set_dir(INPUTS[i].pin, GPIO_IN);
+        mask |= 1u << INPUTS[i].pin;
+    }
+
+    instance_ = this;
+    gpio_add_raw_irq_handler_masked(mask, irqHandler);
+    for (int i = 0; i < NUM_INPUTS; i++)
+    {
+        gpio_set_irq_enabled(INPUTS[i].pin, GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL, true);
+    }
+    irq_set_enabled(IO_IRQ_BANK0, true);
+
+    initialized_ = true;
+    printf("GateInput: %s on GPIO%u, %s on GPIO%u\n", INPUTS[0].name, INPUTS[0].pin, INPUTS[1].name,
+           INPUTS[1].pin);
+    return true;
+}
+
+void GateInput::deinit()
+{
+    if (!initialized_)
+    {
+        return;
+    }
+
+    uint32_t mask = 0;
+    for (int i = 0; i < NUM_INPUTS; i++)
+    {
+        gpio_set_irq_enabled(INPUTS[i].pin, GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL, false);
+        mask |= 1u << INPUTS[i].pin;
+    }
+    gpio_remove_raw_irq_handler_masked(mask, irqHandler);
+    instance_ = nullptr;
+    initialized_ = false;
+}
+
+uint8_t GateInput::getLevel(int input) const
+{
+    return (uint8_t)(gpio_get(INPUTS[input].pin) ^ GATE_INPUT_INVERTED);
+}
+
+uint32_t GateInput::getEdgeCount() const
+{
+    return edgeCount_;
+}
+
+uint32_t GateInput::getDroppedCount() const
+{
+    return dropped_;
+}
+
+void GateInput::printStatus() const
+{
+    printf("  Gates: edges %lu | dropped %lu |", edgeCount_, dropped_);
+    for (int i = 0; i < NUM_INPUTS; i++)
+    {
+        printf(" %s %u", INPUTS[i].name, getLevel(i));
+    }
+    printf("\n");
+}
+
+void HOT_FUNC(GateInput::irqHandler)()
+{
+    if (instance_ != nullptr)
+    {
+        instance_->handleIrq();
+    }
+}
+
+void HOT_FUNC(GateInput::handleIrq)()
+{
+    // The edge time is IRQ entry: read it before anything else
+    const uint32_t now = timer_hw->timerawl;
+
+    for (int i = 0; i < NUM_INPUTS; i++)
+    {
+        const uint pin = INPUTS[i].pin;
+        const uint32_t events = gpio_get_irq_event_mask(pin) & (GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL);
+        if (events == 0)
+        {
+            continue;
+        }
+        // Acknowledge the latched edges (INTR is write-1-to-clear, 4 bits per GPIO)
+        io_bank0_hw->intr[pin / 8] = events << (4 * (pin % 8));
+
+        const uint8_t pinLevel = gpio_get(pin) ? 1 : 0;
+        const uint8_t rise = (events & GPIO_IRQ_EDGE_RISE) ? 1 : 0;
+        const uint8_t fall = (events & GPIO_IRQ_EDGE_FALL) ? 1 : 0;
+        if (rise && fall)
+        {
+            // A pulse shorter than the IRQ latency: the pin level tells which edge came last
+            capture(now, i, (uint8_t)(!pinLevel ^ GATE_INPUT_INVERTED));
+            capture(now, i, (uint8_t)(pinLevel ^ GATE_INPUT_INVERTED));
+        }
+        else
+        {
+            capture(now, i, (uint8_t)(rise ^ GATE_INPUT_INVERTED));
+        }
+    }
+}
+
+void HOT_FUNC(GateInput::capture)(uint32_t timeUs, int input, uint8_t level)
+{
+    edgeCount_ = edgeCount_ + 1;
+
+    Edge *edge = edges_.writeSlot();
+    if (edge == nullptr)
+    {
+        dropped_ = dropped_ + 1;
+        return;
+    }
+    edge->timeUs = timeUs;
+    edge->input = (uint8_t)input;
+    edge->level = level;
+    edges_.commit();
+}
@@ -0,0 +1,124 @@
+/**
+ * @file GateInput.h
+ * @brief CLK and LOOP gate inputs captured with their edge time for sample-accurate Heavy messages
+ * @author Ale Moglia
+ * @date 2026
+ *
+ * A message sent to Heavy with hv_sendFloatToReceiver() takes effect at the start of the
+ * next block, up to 64 samples (1.6ms) after the edge that caused it. Instead, the GPIO
+ * bank IRQ reads TIMERAWL as it enters and queues every edge of CLK_GATE_INPUT_PIN and
+ * LOOP_GATE_INPUT_PIN with that microsecond timestamp. The producer pops the edges before
+ * it renders a block, turns each time into a Heavy sample index and sends the gate level
+ * with that timestamp, so Heavy's message queue fires it at the right sample inside
+ * process().
+ *
+ * IRQ entry latency (well under a microsecond, plus any higher-priority handler that is
+ * running) is far below one 25µs sample. An edge the queue has no room for is counted
+ * and dropped.
+ */
+
+#ifndef GATE_INPUT_H
+#define GATE_INPUT_H
+
+#include "pico/stdlib.h"
+#include "../hardware.h"
+#include "../audio/SpscQueue.h"
+
+// Edges between the GPIO IRQ and the producer (one block at a 10kHz clock fits twice over)
+#ifndef GATE_INPUT_QUEUE_EDGES
+#define GATE_INPUT_QUEUE_EDGES 32
+#endif
+
+// 1 = the input stage inverts (a high jack reads low on the GPIO)
+#ifndef GATE_INPUT_INVERTED
+#define GATE_INPUT_INVERTED 0
+#endif
+
+/**
+ * @brief Timestamped edge capture of the module's gate inputs
+ */
+class GateInput
+{
+public:
+    static const int NUM_INPUTS = 2;
+
+    /**
+     * @brief One gate input
+     */
+    struct Input
+    {
+        uint8_t pin;      ///< GPIO
+        const char *name; ///< Heavy receiver name and status output
+    };
+
+    static const Input INPUTS[NUM_INPUTS];
+
+    /**
+     * @brief One captured edge
+     */
+    struct Edge
+    {
+        uint32_t timeUs; ///< TIMERAWL at IRQ entry
+        uint8_t input;   ///< Index into INPUTS
+        uint8_t level;   ///< Gate level after the edge (1 = high at the jack)
+    };
+
+    /**
+     * @brief Constructor
+     */
+    GateInput();
+
+    /**
+     * @brief Configure the pins and enable both-edge interrupts on the calling core
+     * @return true if initialized
+     */
+    bool init();
+
+    /**
+     * @brief Stop capturing
+     */
+    void deinit();
+
+    /**
+     * @brief Take the oldest captured edge (consumer only)
+     * @return true if an edge was returned
+     */
+    inline bool pop(Edge &edge)
+    {
+        return edges_.pop(edge);
+    }
+
+    /**
+     * @brief Current level of an input (1 = high at the jack)
+     */
+    uint8_t getLevel(int input) const;
+
+    /**
+     * @brief Number of edges captured, dropped ones included
+     */
+    uint32_t getEdgeCount() const;
+
+    /**
+     * @brief Number of edges dropped because the queue was full
+     */
+    uint32_t getDroppedCount() const;
+
+    /**
+     * @brief Print the counters and the current levels
+     */
+    void printStatus() const;
+
+private:
+    static void irqHandler();
+    void handleIrq();
+    void capture(uint32_t timeUs, int input, uint8_t level);
+
+    static GateInput *instance_;
+
+    bool initialized_;
+    SpscQueue<Edge, GATE_INPUT_QUEUE_EDGES> edges_;
+    volatile uint32_t edgeCount_;
+    volatile uint32_t dropped_;
+};
+
+#endif // GATE_INPUT_H
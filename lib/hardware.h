@@ -32,6 +32,11 @@ Author: Alejandro Moglia
 #define DAC_SCL_PIN 3
 #define DAC_I2C_PORT i2c1
 #define DAC_I2C_ADDRESS 0x60 // MCP4725AOT I2C address with A0 to GND
+#define DAC1_I2C_ADDRESS 0x61 // Optional second MCP4725 on the same bus, A0 to VCC (Heavy output channel 1)
+
+// PWM slice used as the DAC sample clock (MCP4725::SAMPLE_CLOCK_PWM). Slices 8-11 have no
+// GPIO on the QFN-60 package, so this one never conflicts with a pin function.
+#define DAC_CLOCK_PWM_SLICE 11
 
 // ADC ADC121C027 on I2C1 using GPIO2 and GPIO3
 // Address pin can be tied to GND (0x50) or VCC (0x51)
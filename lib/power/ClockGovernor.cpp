@@ -0,0 +1,215 @@
+/**
+ * @file ClockGovernor.cpp
+ * @brief Load-adaptive clk_sys and core voltage, driven by the measured Heavy block time
+ * @author Ale Moglia
+ * @date 2026
+ */
+
+#include "ClockGovernor.h"
+#include <stdio.h>
+#include "hardware/clocks.h"
+#include "hardware/uart.h"
+
+ClockGovernor::ClockGovernor()
+    : dac_(nullptr), initialized_(false), pllHz_(0), blockPeriodUs_(0), dividers_(), numLevels_(0),
+      voltage_(CLOCK_GOVERNOR_HIGH_VREG), busyUs_(0), blocks_(0), peakUs_(0), windowStartUs_(0), windowBusyUs_(0),
+      windowBlocks_(0), lastDutyPermille_(0), lastPeakUs_(0), lowerWindows_(0), targetLevel_(-1), settleStartUs_(0),
+      level_(0), pendingLevel_(0), switches_(0), busyTimeouts_(0)
+{
+}
+
+bool ClockGovernor::init(MCP4725 *dac, uint32_t blockPeriodUs)
+{
+    if (initialized_)
+    {
+        return true;
+    }
+
+    dac_ = dac;
+    blockPeriodUs_ = blockPeriodUs;
+
+    // The levels divide the clock clk_sys booted at, so the divider must still be 1
+    pllHz_ = clock_get_hz(clk_sys);
+    dividers_[0] = 1;
+    numLevels_ = 1;
+    if (clocks_hw->clk[clk_sys].div == 1u << CLOCKS_CLK_SYS_DIV_INT_LSB)
+    {
+        for (uint32_t div = 2; div <= 0xFF && numLevels_ < MAX_LEVELS; div++)
+        {
+            const uint32_t hz = pllHz_ / div;
+            if (hz < CLOCK_GOVERNOR_MIN_KHZ * 1000u)
+            {
+                break;
+            }
+            if (pllHz_ % div == 0 && dac_->canRetime(hz))
+            {
+                dividers_[numLevels_++] = (uint8_t)div;
+            }
+        }
+    }
+
+    if (numLevels_ > 1)
+    {
+        // clk_peri follows clk_sys by default: the UART moves to pll_usb so its baud rate stays put
+        uart_tx_wait_blocking(uart_default);
+        const uint32_t usbHz = clock_get_hz(clk_usb);
+        clock_configure(clk_peri, 0, CLOCKS_CLK_PERI_CTRL_AUXSRC_VALUE_CLKSRC_PLL_USB, usbHz, usbHz);
+        uart_set_baudrate(uart_default, PICO_DEFAULT_UART_BAUD_RATE);
+    }
+
+    voltage_ = CLOCK_GOVERNOR_HIGH_VREG;
+    windowStartUs_ = time_us_32();
+    initialized_ = true;
+
+    printf("ClockGovernor: levels");
+    for (int i = 0; i < numLevels_; i++)
+    {
+        printf(" %lu", levelHz(i) / 1000000);
+    }
+    printf(" MHz, target %d%% of a %lu us block%s\n", CLOCK_GOVERNOR_TARGET_PCT, blockPeriodUs_,
+           numLevels_ > 1 ? "" : " (the DAC setup cannot follow clk_sys, measuring only)");
+    return true;
+}
+
+void ClockGovernor::update()
+{
+    if (!initialized_)
+    {
+        return;
+    }
+    const uint32_t now = time_us_32();
+
+    // A switch up waits until the higher core voltage has settled
+    if (targetLevel_ >= 0 && now - settleStartUs_ >= CLOCK_GOVERNOR_VREG_SETTLE_US)
+    {
+        pendingLevel_ = targetLevel_;
+        targetLevel_ = -1;
+    }
+    // A switch down lowers the voltage once the output IRQ has made it
+    if (targetLevel_ < 0 && pendingLevel_ == level_ && levelVoltage(level_) < voltage_)
+    {
+        voltage_ = levelVoltage(level_);
+        vreg_set_voltage(voltage_);
+    }
+
+    const uint32_t elapsed = now - windowStartUs_;
+    if (elapsed < CLOCK_GOVERNOR_WINDOW_MS * 1000u)
+    {
+        return;
+    }
+
+    const uint32_t busy = busyUs_;
+    const uint32_t blocks = blocks_;
+    const uint32_t peak = peakUs_;
+    peakUs_ = 0;
+    lastDutyPermille_ = (uint32_t)((uint64_t)(busy - windowBusyUs_) * 1000u / elapsed);
+    lastPeakUs_ = peak;
+    const bool produced = blocks != windowBlocks_;
+    windowStartUs_ = now;
+    windowBusyUs_ = busy;
+    windowBlocks_ = blocks;
+
+    if (!produced || numLevels_ < 2 || targetLevel_ >= 0 || pendingLevel_ != level_)
+    {
+        return; // Nothing measured, nothing to choose from, or a switch is still under way
+    }
+
+    const int needed = neededLevel(peak);
+    if (needed < level_)
+    {
+        // Too slow: go straight to the level the patch needs
+        lowerWindows_ = 0;
+        requestLevel(needed);
+    }
+    else if (needed > level_)
+    {
+        // Headroom: only step down one level once it has lasted CLOCK_GOVERNOR_HOLD_WINDOWS windows
+        if (++lowerWindows_ >= CLOCK_GOVERNOR_HOLD_WINDOWS)
+        {
+            lowerWindows_ = 0;
+            requestLevel(level_ + 1);
+        }
+    }
+    else
+    {
+        lowerWindows_ = 0;
+    }
+}
+
+uint32_t ClockGovernor::getClockHz() const
+{
+    return levelHz(level_);
+}
+
+uint32_t ClockGovernor::getSwitchCount() const
+{
+    return switches_;
+}
+
+void ClockGovernor::printStatus() const
+{
+    printf("  Clock: %lu MHz (level %d of %d), core %u mV | Heavy duty %lu.%lu%%, slowest block %lu of %lu us | "
+           "switches %lu, bus busy %lu\n",
+           getClockHz() / 1000000, level_ + 1, numLevels_, 550u + 50u * (unsigned)voltage_, lastDutyPermille_ / 10,
+           lastDutyPermille_ % 10, lastPeakUs_, blockPeriodUs_, switches_, busyTimeouts_);
+}
+
+void ClockGovernor::switchClock()
+{
+    // Only between samples: if the last one is still on the bus, the next IRQ tries again
+    if (!dac_->waitBusIdle(CLOCK_GOVERNOR_IDLE_WAIT_US))
+    {
+        busyTimeouts_ = busyTimeouts_ + 1;
+        return;
+    }
+
+    // The integer divider changes glitch-free on the fly, the PLL keeps running
+    const int level = pendingLevel_;
+    clocks_hw->clk[clk_sys].div = (uint32_t)dividers_[level] << CLOCKS_CLK_SYS_DIV_INT_LSB;
+    clock_set_reported_hz(clk_sys, levelHz(level));
+    dac_->retime();
+    level_ = level;
+    switches_ = switches_ + 1;
+}
+
+void ClockGovernor::requestLevel(int level)
+{
+    const enum vreg_voltage voltage = levelVoltage(level);
+    if (voltage > voltage_)
+    {
+        // Voltage first, the clock follows once it has settled
+        voltage_ = voltage;
+        vreg_set_voltage(voltage_);
+        targetLevel_ = level;
+        settleStartUs_ = time_us_32();
+    }
+    else
+    {
+        pendingLevel_ = level;
+    }
+}
+
+uint32_t ClockGovernor::levelHz(int level) const
+{
+    return pllHz_ / dividers_[level];
+}
+
+enum vreg_voltage ClockGovernor::levelVoltage(int level) const
+{
+    return levelHz(level) <= CLOCK_GOVERNOR_LOW_VREG_MAX_KHZ * 1000u ? CLOCK_GOVERNOR_LOW_VREG
+                                                                     : CLOCK_GOVERNOR_HIGH_VREG;
+}
+
+int ClockGovernor::neededLevel(uint32_t peakUs) const
+{
+    // Heavy is CPU-bound: its block time scales with the clock divider
+    const uint32_t budgetUs = blockPeriodUs_ * CLOCK_GOVERNOR_TARGET_PCT / 100;
+    for (int level = numLevels_ - 1; level > 0; level--)
+    {
+        if ((uint64_t)peakUs * dividers_[level] <= (uint64_t)budgetUs * dividers_[level_])
+        {
+            return level;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,184 @@
+/**
+ * @file ClockGovernor.h
+ * @brief Load-adaptive clk_sys and core voltage, driven by the measured Heavy block time
+ * @author Ale Moglia
+ * @date 2026
+ *
+ * One sine voice keeps the producer busy for a small share of each block, so most of
+ * the time the cores sleep at full clock and full voltage. The governor runs clk_sys at
+ * the lowest level that still keeps the slowest Heavy block of the last window under
+ * CLOCK_GOVERNOR_TARGET_PCT of a block period, and moves up as soon as the patch gets
+ * heavier.
+ *
+ * The levels divide the boot PLL by a whole number (150, 75, 50MHz from 150MHz), so a
+ * change is a glitch-free write of the clk_sys divider with the PLL left running. Only
+ * the clk_sys-derived timings have to follow: the DAC driver re-derives the I2C SCL
+ * counts and the DMA timer numerator (MCP4725::retime()), keeping the denominator so the
+ * output stays at exactly DAC_SAMPLE_RATE. The sample timer counts the 1MHz tick from
+ * clk_ref and is not affected. init() moves clk_peri, which follows clk_sys by default,
+ * over to pll_usb so the UART keeps its baud rate.
+ *
+ * The switch itself runs in the output IRQ (service()), between two samples with the
+ * bus idle. The main loop decides the level (update()), raises the core voltage and lets
+ * it settle before a switch up, and lowers it only after a switch down.
+ */
+
+#ifndef CLOCK_GOVERNOR_H
+#define CLOCK_GOVERNOR_H
+
+#include "pico/stdlib.h"
+#include "hardware/vreg.h"
+#include "../dac/MCP4725.h"
+
+// Slowest clk_sys level (not below clk_peri and clk_usb, 48MHz)
+#ifndef CLOCK_GOVERNOR_MIN_KHZ
+#define CLOCK_GOVERNOR_MIN_KHZ 48000
+#endif
+
+// Level is chosen so the slowest Heavy block takes at most this share of a block period
+#ifndef CLOCK_GOVERNOR_TARGET_PCT
+#define CLOCK_GOVERNOR_TARGET_PCT 50
+#endif
+
+// Measurement window: block times are collected this long before each decision
+#ifndef CLOCK_GOVERNOR_WINDOW_MS
+#define CLOCK_GOVERNOR_WINDOW_MS 100
+#endif
+
+// Windows in a row a lower level must suffice before the clock steps down (up is immediate)
+#ifndef CLOCK_GOVERNOR_HOLD_WINDOWS
+#define CLOCK_GOVERNOR_HOLD_WINDOWS 10
+#endif
+
+// Core voltage above CLOCK_GOVERNOR_LOW_VREG_MAX_KHZ (the SDK's boot voltage)
+#ifndef CLOCK_GOVERNOR_HIGH_VREG
+#define CLOCK_GOVERNOR_HIGH_VREG VREG_VOLTAGE_DEFAULT
+#endif
+
+// Core voltage at and below CLOCK_GOVERNOR_LOW_VREG_MAX_KHZ
+#ifndef CLOCK_GOVERNOR_LOW_VREG
+#define CLOCK_GOVERNOR_LOW_VREG VREG_VOLTAGE_1_00
+#endif
+#ifndef CLOCK_GOVERNOR_LOW_VREG_MAX_KHZ
+#define CLOCK_GOVERNOR_LOW_VREG_MAX_KHZ 75000
+#endif
+
+// Wait after raising the core voltage before the clock goes up
+#ifndef CLOCK_GOVERNOR_VREG_SETTLE_US
+#define CLOCK_GOVERNOR_VREG_SETTLE_US 1000
+#endif
+
+// Longest the output IRQ waits for the previous sample to leave the bus before it switches
+#ifndef CLOCK_GOVERNOR_IDLE_WAIT_US
+#define CLOCK_GOVERNOR_IDLE_WAIT_US 20
+#endif
+
+/**
+ * @brief clk_sys level governor for the audio producer
+ */
+class ClockGovernor
+{
+public:
+    static const int MAX_LEVELS = 4;
+
+    /**
+     * @brief Constructor
+     */
+    ClockGovernor();
+
+    /**
+     * @brief Find the levels the DAC can follow and move clk_peri off clk_sys
+     *
+     * Call after MCP4725::beginAsync() and before the output starts. The boot clock is the
+     * fastest level. With a single level (a DAC setup that cannot be retimed, see
+     * MCP4725::canRetime()) the governor only measures.
+     *
+     * @param dac Output DAC whose timings follow clk_sys
+     * @param blockPeriodUs Length of one Heavy block at the output rate
+     * @return true if initialized
+     */
+    bool init(MCP4725 *dac, uint32_t blockPeriodUs);
+
+    /**
+     * @brief Account one Heavy block (producer, either core)
+     * @param busyUs Time the block took
+     */
+    inline void addBlock(uint32_t busyUs)
+    {
+        busyUs_ = busyUs_ + busyUs;
+        blocks_ = blocks_ + 1;
+        if (busyUs > peakUs_)
+        {
+            peakUs_ = busyUs; // The main loop clears it: a race only loses one block's peak
+        }
+    }
+
+    /**
+     * @brief Decide the level at the end of each window and manage the core voltage (main loop)
+     */
+    void update();
+
+    /**
+     * @brief Carry out a pending switch (output IRQ, before the next sample is started)
+     */
+    inline void service()
+    {
+        if (pendingLevel_ != level_)
+        {
+            switchClock();
+        }
+    }
+
+    /**
+     * @brief Current clk_sys in Hz
+     */
+    uint32_t getClockHz() const;
+
+    /**
+     * @brief Number of clock switches made
+     */
+    uint32_t getSwitchCount() const;
+
+    /**
+     * @brief Print the level, voltage and the last window's Heavy load
+     */
+    void printStatus() const;
+
+private:
+    void switchClock();
+    void requestLevel(int level);
+    uint32_t levelHz(int level) const;
+    enum vreg_voltage levelVoltage(int level) const;
+    int neededLevel(uint32_t peakUs) const;
+
+    MCP4725 *dac_;
+    bool initialized_;
+    uint32_t pllHz_;
+    uint32_t blockPeriodUs_;
+    uint8_t dividers_[MAX_LEVELS]; ///< clk_sys = pllHz_ / divider, fastest first
+    int numLevels_;
+    enum vreg_voltage voltage_;
+
+    // Producer side
+    volatile uint32_t busyUs_;
+    volatile uint32_t blocks_;
+    volatile uint32_t peakUs_;
+
+    // Main loop side
+    uint32_t windowStartUs_;
+    uint32_t windowBusyUs_;     ///< busyUs_ at the start of the window
+    uint32_t windowBlocks_;     ///< blocks_ at the start of the window
+    uint32_t lastDutyPermille_; ///< Share of the last window spent in Heavy, in 0.1% steps
+    uint32_t lastPeakUs_;       ///< Slowest block of the last window
+    int lowerWindows_;          ///< Windows in a row a slower level would have sufficed
+    int targetLevel_;           ///< Level waiting for the core voltage to settle, -1 = none
+    uint32_t settleStartUs_;
+
+    // Output IRQ side
+    volatile int level_;
+    volatile int pendingLevel_;
+    volatile uint32_t switches_;
+    volatile uint32_t busyTimeouts_;
+};
+
+#endif // CLOCK_GOVERNOR_H
@@ -10,12 +10,12 @@
  * Sample rate uses exact 25μs timer period for perfect accuracy.
  *
  * SIGNAL PATH:
- * Heavy DSP Engine (40kHz) → Ring Buffer → Timer Interrupt (40kHz) → DMA → I2C → MCP4725 DAC
+ * Heavy DSP Engine (40kHz) → Block Queue → Timer Interrupt (40kHz) → DMA → I2C → MCP4725 DAC
  *
  * KEY INNOVATIONS:
  * - DMA handles I2C transfers asynchronously (~12μs per transfer at 2MHz I2C)
  * - Timer interrupt only queues DMA transfers (420ns measured overhead)
- * - Ring buffer decouples audio generation from DAC updates
+ * - Block queue of pre-formatted I2C words decouples audio generation from DAC updates
  * - Achieves perfect 440Hz sine wave at 40kHz sample rate
  * - Simple timer: 25μs period = exact 40kHz (1,000,000 / 40,000 = 25)
  *
@@ -23,11 +23,53 @@
  * - Timer interrupt: 420ns (1.7% CPU usage)
  * - DMA transfer: ~12μs (handled by hardware in background)
  * - Heavy processing: Amortized across 64-sample blocks (every 1.6ms)
- * - Ring buffer: 512 samples (12.8ms @ 40kHz) provides elasticity
+ * - Block queue: 2 x 64 samples (3.2ms @ 40kHz) provides elasticity
  *
  * SAMPLE RATE DESIGN:
  * 40kHz chosen for exact timer period: 1,000,000μs / 40,000Hz = 25μs exactly.
  * No fractional timing needed - simple and accurate.
+ *
+ * OUTPUT MODES (DAC_OUTPUT_MODE):
+ * - DAC_OUTPUT_TIMER_IRQ (default): timer IRQ every 25μs re-arms a 3-word DMA transfer
+ * - DAC_OUTPUT_DMA_BLOCK: main loop pre-formats whole 64-sample blocks of MCP4725
+ *   fast-write words. A DMA pacing timer or PWM slice (DREQ at DAC_SAMPLE_RATE) drives a
+ *   control channel that re-triggers the I2C channel once per sample, so the CPU only
+ *   takes one DMA interrupt per block (625/s) instead of one timer interrupt per sample.
+ *
+ * ELASTIC OUTPUT (ELASTIC_RESAMPLER):
+ * Heavy runs on its own local-clock schedule (one block per BUFFER_SIZE / HEAVY_SAMPLE_RATE)
+ * into an ElasticResampler FIFO, and DAC blocks are resampled out of it. A PI loop on the
+ * FIFO fill matches the two rates, so an output clock that drifts from HEAVY_SAMPLE_RATE
+ * neither underruns nor overruns a small fixed buffer.
+ *
+ * OUTPUT CHANNELS (DAC_CHANNELS):
+ * Heavy computes only the outputs that have a DAC (hv_440tone_set_output_mask()). With 2,
+ * a second MCP4725 at 0x61 gets the right channel: its words follow the left DAC's in each
+ * sample record and go out in the same DMA submission, the driver's STOP_DET IRQ switching
+ * the I2C target in between. Both transfers must fit in one sample period.
+ *
+ * SRAM HOT PATH (HOT_PATH_IN_RAM):
+ * The output IRQ, the producer (Heavy, conversion, queue hand-off) and the driver IRQ
+ * handlers run from SRAM, so a flash access by the main loop or a cold XIP cache can no
+ * longer stall them. XIP_STATS reports the cache misses of each real-time section.
+ *
+ * DEADLINE MONITOR (DEADLINE_MONITOR):
+ * Every output block is checked against its deadline (producer time per block period,
+ * samples still queued ahead of it). A producer that falls behind sheds load in steps
+ * (mono, then every 4th, then every 2nd block faded out and in instead of rendered)
+ * before the queue can run dry, and gives each step back once the headroom returns.
+ *
+ * CLOCK GOVERNOR (CLOCK_GOVERNOR):
+ * clk_sys follows the measured Heavy block time between whole divisions of the boot PLL,
+ * with the core voltage lowered at the slow levels. The output IRQ makes each switch
+ * between two samples and the DAC driver re-derives its I2C and DMA timer dividers, so
+ * the output rate stays exact.
+ *
+ * FAST BOOT (FAST_BOOT):
+ * Production start-up: no USB or DAC settle waits and no boot self-tests (first-block
+ * dump, oscillator THD). Everything main() prints goes to a RAM log (BootLog) instead of
+ * waiting on the UART, so the output starts a few milliseconds after reset and the log
+ * is sent from the main loop once audio runs.
  */
 
 #include <stdio.h>
@@ -36,42 +78,309 @@
 #include "hardware/timer.h"
 #include "hardware/irq.h"
 #include "hardware/dma.h"
+#include "hardware/clocks.h"
+#include "hardware/sync.h"
+#include "hardware/uart.h"
 #include "pico/platform.h" // For time functions// needed for RP2350 FPU access
 
+#if HEAVY_ON_CORE1
+#include "pico/multicore.h"
+#endif
+
 #include "Heavy_440tone.h"
+#include "HvSignalWavetable.hpp"
 #include "lib/hardware.h"
 #include "lib/dac/MCP4725.h"
+#include "lib/audio/SpscQueue.h"
+#include "lib/audio/DacConvert.h"
+#include "lib/audio/ElasticResampler.h"
+#include "lib/audio/Thd.h"
+#include "lib/debug/CycleProfiler.h"
+#include "lib/debug/XipStats.h"
+#include "lib/HotPath.h"
+#include "lib/adc/ControlScanner.h"
 
 // Audio configuration - 40kHz with exact timer period
-#define DAC_SAMPLE_RATE 40000      // Standard rate with exact timer period
-#define HEAVY_SAMPLE_RATE 40000.0f // Must match DAC rate for correct 440Hz
-#define BUFFER_SIZE 64             // Heavy processing block size
+#ifndef DAC_SAMPLE_RATE
+#define DAC_SAMPLE_RATE 40000 // Standard rate with exact timer period
+#endif
+#define HEAVY_SAMPLE_RATE ((float)DAC_SAMPLE_RATE) // Must match DAC rate for correct 440Hz
+#define BUFFER_SIZE 64                             // Heavy processing block size
+
+// Timer period - exact integer microseconds in the timer IRQ mode (nearest, for budgets only, otherwise)
+#define TIMER_PERIOD_US (1000000 / DAC_SAMPLE_RATE) // 1,000,000 / 40,000 = 25μs exactly
+
+// DAC output mode
+#define DAC_OUTPUT_TIMER_IRQ 0 // Timer IRQ per sample triggers a 3-word DMA transfer
+#define DAC_OUTPUT_DMA_BLOCK 1 // DMA pacing timer streams pre-formatted blocks, one IRQ per block
+#ifndef DAC_OUTPUT_MODE
+#define DAC_OUTPUT_MODE DAC_OUTPUT_TIMER_IRQ
+#endif
+#if DAC_OUTPUT_MODE == DAC_OUTPUT_TIMER_IRQ && (1000000 % DAC_SAMPLE_RATE) != 0
+#error "DAC_OUTPUT_TIMER_IRQ needs an integer-microsecond sample period, use DAC_OUTPUT_DMA_BLOCK for other rates"
+#endif
+
+// Sample clock of the DMA block mode (MCP4725::SampleClock)
+#ifndef DAC_SAMPLE_CLOCK
+#define DAC_SAMPLE_CLOCK 0 // 0 = DMA pacing timer (exact X/Y fraction only), 1 = PWM slice (any rate)
+#endif
+
+// TPDF dither on the 12-bit truncation (0 = off, output identical to plain audioToDAC)
+#ifndef DAC_DITHER
+#define DAC_DITHER 0
+#endif
+
+// Pot/CV scanning on the shared I2C1 bus, interleaved between DAC transfers (0 = off)
+#ifndef CONTROL_SCAN
+#define CONTROL_SCAN 0
+#endif
+#ifndef CONTROL_SCAN_RATE_HZ
+#define CONTROL_SCAN_RATE_HZ 2000 // ADC reads per second, shared round-robin by all channels
+#endif
+// MCP4725 bus format (DAC_STREAM, lib/audio/DacConvert.h): the scanner switches the bus to the ADC after a STOP
+#if CONTROL_SCAN && DAC_STREAM
+#error "CONTROL_SCAN needs a STOP after every DAC sample to switch the bus to the ADC, turn DAC_STREAM off"
+#endif
+
+// Elastic output: Heavy on the local clock, PI-controlled resampler into the DAC queue (0 = off)
+#ifndef ELASTIC_RESAMPLER
+#define ELASTIC_RESAMPLER 0
+#endif
+#ifndef ELASTIC_TARGET_FILL
+#define ELASTIC_TARGET_FILL 160 // Samples: one 64-sample read + look-ahead while the next Heavy block is in progress
+#endif
+
+// USB capture: tee every Heavy block over the USB CDC port for regression diffs (0 = off)
+#ifndef USB_CAPTURE
+#define USB_CAPTURE 0
+#endif
+#ifndef USB_CAPTURE_FORMAT
+#define USB_CAPTURE_FORMAT 0 // CaptureFormat: 0 = 16-bit, 1 = raw float
+#endif
+#if USB_CAPTURE
+#include "lib/debug/UsbCapture.h"
+#endif
+
+// Glitch log: every underrun/overrun with timestamp, cause and fill, dumped with 'e' on UART (0 = counters only)
+#ifndef EVENT_LOG
+#define EVENT_LOG 1
+#endif
+#if EVENT_LOG
+#include "lib/debug/EventLog.h"
+#endif
+
+// Production start-up: output within milliseconds of reset, start-up log printed once audio runs (0 = dev boot)
+#ifndef FAST_BOOT
+#define FAST_BOOT 0
+#endif
+#if FAST_BOOT
+#include "lib/debug/BootLog.h"
+#endif
+
+// Scale clk_sys and the core voltage with the Heavy load (0 = fixed boot clock)
+#ifndef CLOCK_GOVERNOR
+#define CLOCK_GOVERNOR 0
+#endif
+#if CLOCK_GOVERNOR
+#include "lib/power/ClockGovernor.h"
+#endif
+#if CLOCK_GOVERNOR && CONTROL_SCAN
+#error "CLOCK_GOVERNOR cannot retime the bus while the control scanner's ADC reads share it"
+#endif
+
+// Output channels: 1 = Heavy left on the DAC at 0x60, 2 = Heavy right on a second MCP4725 at 0x61 as well
+#ifndef DAC_CHANNELS
+#define DAC_CHANNELS 1
+#endif
+#if DAC_CHANNELS != 1 && DAC_CHANNELS != 2
+#error "DAC_CHANNELS must be 1 or 2"
+#endif
+#if DAC_CHANNELS == 2 && (DAC_STREAM || CONTROL_SCAN || ELASTIC_RESAMPLER)
+#error "DAC_CHANNELS 2 switches the target on every STOP (no DAC_STREAM, does not share the bus with CONTROL_SCAN) and the resampler is mono"
+#endif
+#if (HV_440TONE_OUTPUT_MASK & ((1 << DAC_CHANNELS) - 1)) != ((1 << DAC_CHANNELS) - 1)
+#error "HV_440TONE_OUTPUT_MASK must include every DAC channel"
+#endif
+#define DAC_SAMPLE_WORDS (DAC_WORDS_PER_SAMPLE * DAC_CHANNELS) // One sample record: DAC 0x60 words, then 0x61
+
+// Deadline monitor: a late producer sheds load step by step instead of underrunning (0 = off)
+#ifndef DEADLINE_MONITOR
+#define DEADLINE_MONITOR 0
+#endif
+#if DEADLINE_MONITOR
+#include "lib/audio/DeadlineMonitor.h"
+#endif
+
+// Output block queue configuration (power of 2)
+#if DAC_OUTPUT_MODE == DAC_OUTPUT_TIMER_IRQ
+#define DAC_BLOCK_COUNT 2 // Ping-pong: 2 x 64 = 128 samples = 3.2ms @ 40kHz
+#else
+#define DAC_BLOCK_COUNT 4 // 1 draining + 1 streaming + 2 queued: 4 x 64 = 256 samples = 6.4ms @ 40kHz
+#endif
 
-// Timer period - exact integer microseconds for 40kHz
-#define TIMER_PERIOD_US 25 // 1,000,000 / 40,000 = 25μs exactly
+// CLK/LOOP gate inputs: edge-timestamped, delivered to Heavy at the sample they map to (0 = off)
+#ifndef GATE_INPUTS
+#define GATE_INPUTS 0
+#endif
+#ifndef GATE_LATENCY_SAMPLES
+#define GATE_LATENCY_SAMPLES ((DAC_BLOCK_COUNT + 1) * BUFFER_SIZE) // Edge to output: every queued block + one render
+#endif
+#if GATE_INPUTS
+#include "lib/gate/GateInput.h"
+#endif
 
-// Ring buffer configuration
-#define RING_BUFFER_SIZE 512 // Power of 2 for efficient modulo
-#define RING_BUFFER_MASK (RING_BUFFER_SIZE - 1)
-#define BUFFER_LOW_WATERMARK (RING_BUFFER_SIZE / 2) // Keep buffer at least 50% full (256 samples = 6.4ms @ 40kHz)
+// Run the Heavy producer loop on core 1 (core 0 keeps the IRQs and the UART status output)
+#ifndef HEAVY_ON_CORE1
+#define HEAVY_ON_CORE1 0
+#endif
 
-// Ring buffer for DAC samples (16-bit values ready for DAC)
-static volatile uint16_t ringBuffer[RING_BUFFER_SIZE];
-static volatile uint32_t writeIndex = 0; // Where Heavy writes
-static volatile uint32_t readIndex = 0;  // Where IRQ reads
+// Heavy entry point: 1 = hv_440tone_process_block(), compiled for BUFFER_SIZE frames; 0 = hv_processInline()
+#ifndef HEAVY_FIXED_BLOCK
+#define HEAVY_FIXED_BLOCK 1
+#endif
+#if HEAVY_FIXED_BLOCK && BUFFER_SIZE != HV_440TONE_BLOCK_SIZE
+#error "HEAVY_FIXED_BLOCK: HV_440TONE_BLOCK_SIZE must equal BUFFER_SIZE"
+#endif
+
+static_assert(DAC_WORDS_PER_SAMPLE == (DAC_STREAM ? MCP4725::STREAM_WORDS_PER_SAMPLE : MCP4725::WORDS_PER_SAMPLE),
+              "DacConvert word format must match the MCP4725 wire format");
+
+// Pre-formatted I2C data_cmd words, one block per Heavy processing block
+struct DacBlock
+{
+    uint16_t words[BUFFER_SIZE * DAC_SAMPLE_WORDS];
+#if GATE_INPUTS
+    uint32_t heavySample; // Heavy timestamp of the block's first sample
+#endif
+};
+
+// Lock-free SPSC block queue: Heavy producer (main loop or core 1) -> DAC IRQ (core 0)
+// The IRQ hands back whole blocks and signals the producer with __sev()
+static SpscQueue<DacBlock, DAC_BLOCK_COUNT> dacBlockQueue;
+
+#if DAC_OUTPUT_MODE == DAC_OUTPUT_TIMER_IRQ
+static uint32_t blockReadPos = 0; // Next sample within the oldest queued block (IRQ only)
+static uint32_t timerNextAlarm;   // Deadline of the next sample tick (IRQ only once started)
+#else
+
+// Per-sample read addresses written into the I2C channel by the pacing channel (built once at startup)
+static const uint16_t *dacBlockSamplePtrs[DAC_BLOCK_COUNT][BUFFER_SIZE];
+
+// Hold block: repeats the last sample when the producer is late (no DMA stall, no output step)
+static uint16_t dacHoldWords[DAC_SAMPLE_WORDS];
+static const uint16_t *dacHoldSamplePtrs[BUFFER_SIZE];
+
+// Consumer-side state (IRQ only)
+static bool blockActive = false;              // Pacing channel is streaming a real block
+static bool blockDraining = false;            // Oldest queued block's last sample may still be on the bus
+#endif
 
 // Audio buffers
 static float audioBuffer[BUFFER_SIZE * 2]; // Stereo output from Heavy
+#if GATE_INPUTS
+static uint32_t renderedHeavySample = 0; // Heavy timestamp of audioBuffer[0] (producer only)
+#endif
+
+#if DAC_DITHER
+static TpdfDither dacDither; // Producer only
+#endif
+
+#if ELASTIC_RESAMPLER
+// Producer only: Heavy is due every BUFFER_SIZE / HEAVY_SAMPLE_RATE of local time
+static ElasticResampler resampler;
+static float resampledBuffer[BUFFER_SIZE];
+static uint64_t heavyStartUs = 0;   // Local time of Heavy block 0 of the schedule
+static uint64_t heavyBlockDue = 0;  // Next block of the schedule
+static uint64_t heavyLastDueUs = 0; // Scheduled time of the last block written to the resampler
+#endif
 
 // Heavy context
 static HeavyContextInterface *heavyContext = NULL;
 
-// MCP4725 DAC instance
+// MCP4725 DAC instance (blocking setup calls, then DMA-driven async output)
 static MCP4725 dac;
 
-// DMA channel for I2C transfers
-static int dma_chan = -1;
-static uint16_t dma_i2c_buffer[3]; // 16-bit buffer for I2C data_cmd writes
+// DACs in use, and the Heavy outputs computed and converted (DAC_CHANNELS 2 without a DAC at 0x61 = 1)
+static int dacChannels = 1;
+#if DAC_CHANNELS == 2
+static MCP4725 dac1(DAC1_I2C_ADDRESS); // Blocking probe only, dac sends its samples (fan-out)
+#endif
+
+#if USB_CAPTURE
+// Heavy output tee: filled by the producer, drained by the core 0 main loop
+static UsbCapture usbCapture;
+#endif
+
+#if EVENT_LOG
+// Glitch log: written by the output IRQs and the producer, printed by the core 0 main loop
+static EventLog eventLog;
+static uint32_t dacAbortsLogged = 0; // Driver abort count already in the log (output IRQ only)
+#endif
+
+#if FAST_BOOT
+// Start-up stdout: filled by main() before the output starts, drained by the core 0 main loop
+static BootLog bootLog;
+#endif
+
+#if DEADLINE_MONITOR
+/**
+ * @brief One rung of the load-shedding ladder
+ */
+struct ShedStep
+{
+    const char *name;
+    uint8_t mono;      ///< 1 = only Heavy's left output is computed, and sent to both DACs
+    uint8_t skipEvery; ///< Every Nth block is faded out instead of rendered (0 = none)
+};
+
+// Cheapest loss first: the second channel, then a quarter, then half of the blocks
+static const ShedStep SHED_STEPS[] = {
+    {"full", 0, 0},
+#if DAC_CHANNELS == 2
+    {"mono", 1, 0},
+#endif
+    {"skip 1/4", DAC_CHANNELS == 2, 4},
+    {"skip 1/2", DAC_CHANNELS == 2, 2},
+};
+static const int NUM_SHED_STEPS = sizeof(SHED_STEPS) / sizeof(SHED_STEPS[0]);
+static const char *shedStepNames[NUM_SHED_STEPS];
+
+// Producer only, the status output reads the counters
+static DeadlineMonitor deadline;
+static int shedChannels = 1;           // Heavy outputs currently computed
+static uint32_t shedPhase = 0;         // Blocks since the last shed one
+static bool shedFadeIn = false;        // The next rendered block fades in from mid-scale
+static volatile uint32_t shedBlocks = 0; // Blocks faded out instead of rendered
+#endif
+
+#if CLOCK_GOVERNOR
+// clk_sys level: block times from the producer, decisions in the core 0 main loop, switches in the output IRQ
+static ClockGovernor governor;
+#endif
+
+#if GATE_INPUTS
+// Gate edges (GPIO IRQ) delivered to the Heavy receivers of the same name (producer only)
+static GateInput gates;
+static uint32_t gateHashes[GateInput::NUM_INPUTS];
+static volatile uint32_t gateLateEdges = 0; // Edges that mapped before the block being rendered
+// Output clock anchor: local time the Heavy sample gateAnchorSample starts playing (seqlock, one writer)
+static volatile uint32_t gateAnchorSeq = 0;
+static volatile uint32_t gateAnchorUs = 0;
+static volatile uint32_t gateAnchorSample = 0;
+#endif
+
+#if CONTROL_SCAN
+// ADC121C027 scanner (I2C IRQ) and its delivery to Heavy receivers of the same name (producer only)
+static ControlScanner controls;
+static bool controlsActive = false;
+static uint32_t controlHashes[ControlScanner::NUM_CHANNELS];
+static int controlParams[ControlScanner::NUM_CHANNELS]; // Heavy parameter index with the channel's hash, -1 = message
+static uint32_t controlSeqSent[ControlScanner::NUM_CHANNELS];
+#endif
+
+#if DAC_OUTPUT_MODE == DAC_OUTPUT_TIMER_IRQ
+static uint16_t dma_i2c_buffer[DAC_SAMPLE_WORDS]; // Words of the sample in flight (block may be released)
+#endif
 
 // Statistics
 static volatile uint32_t samplesGenerated = 0;
@@ -81,37 +390,109 @@ static volatile uint32_t bufferOverruns = 0;
 static uint32_t lastDacCount = 0;
 static uint64_t lastMeasureTime = 0;
 
+#if CYCLE_PROFILE
+static CycleStat profIrq;     // timerCallback / dacBlockComplete (core 0 IRQ)
+static CycleStat profHeavy;   // renderHeavyBlock's Heavy call (producer)
+static CycleStat profConvert; // audioBlockToDacWords (producer)
+#endif
+#if XIP_STATS
+static XipSection xipIrq;     // timerCallback / dacBlockComplete (core 0 IRQ)
+static XipSection xipHeavy;   // renderHeavyBlock's Heavy call (producer)
+static XipSection xipConvert; // audioBlockToDacWords (producer)
+#endif
+
 /**
- * @brief Convert float audio sample (-1.0 to +1.0) to 12-bit DAC value
+ * @brief Get number of pre-formatted blocks owned by the IRQ side (queued, streaming or draining)
  */
-static inline uint16_t audioToDAC(float sample)
+static inline uint32_t dacBlocksQueued(void)
 {
-    // Clamp sample to valid range
-    if (sample > 1.0f)
-        sample = 1.0f;
-    if (sample < -1.0f)
-        sample = -1.0f;
-
-    // Convert from [-1.0, +1.0] to [0, 4095]
-    return (uint16_t)((sample + 1.0f) * 2047.5f);
+    return dacBlockQueue.size();
 }
 
+#if GATE_INPUTS
 /**
- * @brief Get number of samples available in ring buffer
+ * @brief Publish the local time a Heavy sample starts playing (output IRQ, or the producer with ELASTIC_RESAMPLER)
  */
-static inline uint32_t ringBufferAvailable(void)
+static inline void setGateAnchor(uint32_t timeUs, uint32_t heavySample)
 {
-    return (writeIndex - readIndex) & RING_BUFFER_MASK;
+    gateAnchorSeq = gateAnchorSeq + 1; // Odd: update in progress
+    __dmb();
+    gateAnchorUs = timeUs;
+    gateAnchorSample = heavySample;
+    __dmb();
+    gateAnchorSeq = gateAnchorSeq + 1;
 }
 
 /**
- * @brief Get free space in ring buffer
+ * @brief Heavy sample playing at a local time, from the latest anchor (either core)
  */
-static inline uint32_t ringBufferFree(void)
+static uint32_t heavySampleAt(uint32_t timeUs)
 {
-    return RING_BUFFER_SIZE - ringBufferAvailable() - 1;
+    uint32_t seq, anchorUs, anchorSample;
+    do
+    {
+        seq = gateAnchorSeq;
+        __dmb();
+        anchorUs = gateAnchorUs;
+        anchorSample = gateAnchorSample;
+        __dmb();
+    } while ((seq & 1) != 0 || seq != gateAnchorSeq);
+
+    // Floor of the elapsed samples, also for an edge just before the anchor
+    const int64_t scaled = (int64_t)(int32_t)(timeUs - anchorUs) * DAC_SAMPLE_RATE;
+    const int64_t samples = scaled >= 0 ? scaled / 1000000 : -((-scaled + 999999) / 1000000);
+    return anchorSample + (uint32_t)(int32_t)samples;
 }
 
+/**
+ * @brief Send the captured gate edges to Heavy, timestamped at their sample (producer, before rendering)
+ *
+ * Every edge arrives GATE_LATENCY_SAMPLES after the sample that was playing when it came in,
+ * so the patch sees gate timing with a constant delay and no block-size jitter. An edge
+ * that would land before the block being rendered fires at its first sample and is counted.
+ */
+static void HOT_FUNC(deliverGateEdges)(void)
+{
+    const uint32_t blockStart = hv_getCurrentSample(heavyContext);
+    GateInput::Edge edge;
+    while (gates.pop(edge))
+    {
+        // Until the output IRQ has published an anchor there is no clock to map to
+        uint32_t timestamp = gateAnchorSeq != 0 ? heavySampleAt(edge.timeUs) + GATE_LATENCY_SAMPLES : blockStart;
+        if ((int32_t)(timestamp - blockStart) < 0)
+        {
+            timestamp = blockStart;
+            gateLateEdges = gateLateEdges + 1;
+        }
+
+        // Heavy's message queue fires it at that sample inside process()
+        HvMessage *m = hv_reserveMessageForReceiver(heavyContext, gateHashes[edge.input], 0.0, 1);
+        if (m != NULL)
+        {
+            msg_setTimestamp(m, timestamp);
+            msg_setFloat(m, 0, (float)edge.level);
+            hv_commitMessage(heavyContext);
+        }
+    }
+}
+#endif
+
+#if EVENT_LOG
+/**
+ * @brief Log the I2C aborts the driver has counted since the last call (output IRQ only)
+ */
+static inline void logDacAborts(uint32_t fill)
+{
+    const uint32_t aborts = dac.getAsyncErrorCount();
+    if (aborts != dacAbortsLogged)
+    {
+        dacAbortsLogged = aborts;
+        eventLog.record(EVENT_I2C_ABORT, fill, dac.getLastAbortSource());
+    }
+}
+#endif
+
+#if DAC_OUTPUT_MODE == DAC_OUTPUT_TIMER_IRQ
 /**
  * @brief Timer IRQ handler - Queues DMA transfers for DAC updates
  *
@@ -148,6 +529,9 @@ static inline uint32_t ringBufferFree(void)
  * Byte 1: D11-D4 = Upper 8 bits of 12-bit value
  * Byte 2: D3-D0<<4 = Lower 4 bits, left-justified (bits 7-4)
  *
+ * With DAC_STREAM the transaction stays open and each sample is 2 fast-mode bytes
+ * (0000 D11-D8, D7-D0) with no START, address or STOP (MCP4725::WIRE_FAST_STREAM).
+ *
  * DMA TRANSFER:
  * - Hardware automatically feeds I2C TX FIFO using DREQ signal
  * - I2C peripheral handles START, address, ACK, STOP automatically
@@ -155,49 +539,560 @@ static inline uint32_t ringBufferFree(void)
  * - CPU is free to process audio during transfer
  *
  *
- * The core logic checks two conditions: whether there is data available in the ring buffer (readIndex != writeIndex)
- * and whether the DMA channel is free (!dma_channel_is_busy(dma_chan)). If both are true, it reads the next sample from the buffer,
- * advances the read index (wrapping around using the ring buffer mask), and prepares a 3-byte I2C command sequence for the DAC.
- * This sequence is loaded into a DMA buffer, and the DMA transfer is started, allowing the hardware to handle the actual data transmission.
- * The dacUpdates counter is incremented to track successful updates.
+ * The core logic checks two conditions: whether there is a queued block (dacBlockQueue.peek() is not null)
+ * and whether the DAC driver's DMA channel is free (!dac.isBusy()). If both are true, it copies the next sample's
+ * pre-formatted 3-word I2C command sequence into the DMA buffer and submits it (dac.submitBlock), allowing the
+ * hardware to handle the actual data transmission. The dacUpdates counter is incremented to track successful updates.
+ * After the last sample of a block, the block is released back to the producer and __sev() wakes it.
  *
- * If there is data in the buffer but the DMA channel is busy, or if the buffer is empty, the function increments the bufferUnderruns counter.
+ * If there is data in the buffer but the DMA channel is busy, or if the queue is empty, the function increments the bufferUnderruns counter.
  * This helps track situations where the DAC could not be updated in time, which could lead to audio glitches.
+ * With EVENT_LOG each of them is also logged with its cause (queue empty, DAC busy, bus collision) and the fill level.
  *
  */
-static void __isr timerCallback(void)
+static void __isr HOT_FUNC(timerCallback)(void)
 {
     gpio_put(TEST_PIN, 1); // START: Measure interrupt time (420ns pulse)
+    CYCLE_PROFILE_BEGIN(irqStart);
+    XIP_SECTION_BEGIN(irqMisses);
 
     // Clear interrupt
     hw_clear_bits(&timer_hw->intr, 1u << 0);
 
-    if (readIndex != writeIndex && !dma_channel_is_busy(dma_chan))
-    {
-        uint16_t dacValue = ringBuffer[readIndex];
-        readIndex = (readIndex + 1) & RING_BUFFER_MASK;
+#if CLOCK_GOVERNOR
+    // The previous sample has left the bus by now: the only safe point for a clock switch
+    governor.service();
+#endif
+
+    const bool dacFree = !dac.isBusy();
+    bool slotFree = true;
+#if CONTROL_SCAN
+    // An ADC read is only started when it ends before this tick, so this refusal should never happen
+    slotFree = controls.claimDacSlot(time_us_32());
+#endif
 
-        dma_i2c_buffer[0] = 0x40;
-        dma_i2c_buffer[1] = (dacValue >> 4) & 0xFF;
-        dma_i2c_buffer[2] = ((dacValue << 4) & 0xF0) | 0x200;
+    const DacBlock *block = dacBlockQueue.peek();
+    if (block != nullptr && dacFree && slotFree)
+    {
+        // Copy the pre-formatted words so the block can be handed back straight away
+        const uint16_t *words = &block->words[blockReadPos * DAC_SAMPLE_WORDS];
+        for (int i = 0; i < DAC_SAMPLE_WORDS; i++)
+        {
+            dma_i2c_buffer[i] = words[i];
+        }
+#if GATE_INPUTS && !ELASTIC_RESAMPLER
+        if (blockReadPos == 0)
+        {
+            // This tick's deadline is when the block's first sample goes out
+            setGateAnchor(timerNextAlarm, block->heavySample);
+        }
+#endif
 
-        dma_channel_set_read_addr(dma_chan, dma_i2c_buffer, true);
+        dac.submitBlock(dma_i2c_buffer, 1);
         dacUpdates++;
+#if EVENT_LOG
+        // submitBlock() has just cleared any abort of the previous sample
+        logDacAborts(dacBlocksQueued() * BUFFER_SIZE - blockReadPos);
+#endif
+
+        // Whole block sent - return it to the producer and wake it
+        if (++blockReadPos == BUFFER_SIZE)
+        {
+            blockReadPos = 0;
+            dacBlockQueue.release();
+            __sev();
+        }
     }
-    else if (readIndex != writeIndex)
+    else
     {
         bufferUnderruns++;
+#if EVENT_LOG
+        const EventCause cause = block == nullptr ? EVENT_QUEUE_EMPTY : !dacFree ? EVENT_DAC_BUSY : EVENT_BUS_COLLISION;
+        eventLog.record(cause, dacBlocksQueued() * BUFFER_SIZE - blockReadPos);
+#endif
+    }
+
+    // Schedule next interrupt from the previous deadline, so IRQ latency never accumulates
+    timerNextAlarm += TIMER_PERIOD_US;
+    if ((int32_t)(timerNextAlarm - timer_hw->timerawl) <= 0)
+    {
+        // A whole period late: restart the schedule rather than arm an alarm in the past
+#if EVENT_LOG
+        eventLog.record(EVENT_IRQ_LATE, dacBlocksQueued() * BUFFER_SIZE - blockReadPos,
+                        timer_hw->timerawl - (timerNextAlarm - TIMER_PERIOD_US));
+#endif
+        timerNextAlarm = timer_hw->timerawl + TIMER_PERIOD_US;
+    }
+    timer_hw->alarm[0] = timerNextAlarm;
+
+    XIP_SECTION_END(xipIrq, irqMisses);
+    CYCLE_PROFILE_END(profIrq, irqStart);
+    gpio_put(TEST_PIN, 0); // END: Interrupt complete
+}
+#else
+/**
+ * @brief DAC block-complete callback - Hands the next pre-formatted block to the pacing channel
+ *
+ * Called by the MCP4725 driver from the DMA IRQ, once per BUFFER_SIZE samples
+ * (625 times per second at 40kHz / 64).
+ *
+ * DMA PIPELINE (MCP4725::beginAsync with a sample rate):
+ * - DMA pacing timer raises a DREQ at exactly DAC_SAMPLE_RATE
+ * - Pacing channel (32-bit, DREQ = pacing timer) copies one entry of a per-sample
+ *   pointer table into the I2C channel's READ_ADDR trigger alias
+ * - I2C channel (16-bit, DREQ = I2C TX) then feeds the 3 data_cmd words of that sample
+ * - When the pacing channel has issued all BUFFER_SIZE samples the driver calls back here
+ *
+ * BLOCK OWNERSHIP:
+ * When this IRQ fires, the last sample of the block is still being clocked out on the
+ * bus (~12μs), so that block is only returned to the main loop on the following IRQ.
+ * If no new block is ready, the pacing channel is pointed at the hold block, which keeps
+ * repeating the last sample sent until the producer catches up.
+ */
+static void HOT_FUNC(dacBlockComplete)(MCP4725 *device, MCP4725::AsyncResult result, void *userData)
+{
+    gpio_put(TEST_PIN, 1); // START: Measure interrupt time
+    CYCLE_PROFILE_BEGIN(irqStart);
+    XIP_SECTION_BEGIN(irqMisses);
+
+#if CONTROL_SCAN
+    // This IRQ follows the pacing tick of the block's last sample, the scanner times its gaps from it
+    controls.markDacTick(time_us_32());
+#endif
+
+    // I2C aborts (NAK, arbitration) are counted by the driver and reported in the status output
+    (void)result;
+    (void)userData;
+#if EVENT_LOG
+    logDacAborts(dacBlocksQueued() * BUFFER_SIZE);
+#endif
+
+    // The block that finished one IRQ ago has long left the bus - return it
+    if (blockDraining)
+    {
+        dacBlockQueue.release();
+        blockDraining = false;
+        __sev(); // Wake the producer
+    }
+
+    // The block that just finished (now the oldest queued) is draining its last sample
+    const uint16_t *lastSample = dacHoldWords;
+    if (blockActive)
+    {
+        lastSample = &dacBlockQueue.peek(0)->words[(BUFFER_SIZE - 1) * DAC_SAMPLE_WORDS];
+        blockDraining = true;
+    }
+
+    const uint16_t *const *samplePtrs;
+    const uint32_t inFlight = blockDraining ? 1 : 0;
+    if (dacBlockQueue.peek(inFlight) != nullptr)
+    {
+        samplePtrs = dacBlockSamplePtrs[dacBlockQueue.peekIndex(inFlight)];
+        blockActive = true;
+#if GATE_INPUTS && !ELASTIC_RESAMPLER
+        // This IRQ follows the last tick of the previous block, the new one starts on the next tick
+        setGateAnchor(timer_hw->timerawl + TIMER_PERIOD_US, dacBlockQueue.peek(inFlight)->heavySample);
+#endif
+        dacUpdates += BUFFER_SIZE;
     }
     else
     {
-        bufferUnderruns++;
+        // Producer is late: keep the DAC at its last value for one block
+        if (lastSample != dacHoldWords)
+        {
+            for (int i = 0; i < DAC_SAMPLE_WORDS; i++)
+            {
+                dacHoldWords[i] = lastSample[i];
+            }
+        }
+        samplePtrs = dacHoldSamplePtrs;
+        blockActive = false;
+        bufferUnderruns += BUFFER_SIZE;
+#if EVENT_LOG
+        eventLog.record(EVENT_PRODUCER_LATE, 0, BUFFER_SIZE);
+#endif
     }
 
-    // Schedule next interrupt
-    timer_hw->alarm[0] = timer_hw->timerawl + TIMER_PERIOD_US;
+    // Restart the pacing channel (it is idle - this callback is its completion)
+    device->submitPacedBlock(samplePtrs, BUFFER_SIZE);
 
+#if CLOCK_GOVERNOR
+    // Switch once the block's last sample has left the bus, well before the next tick
+    governor.service();
+#endif
+
+    XIP_SECTION_END(xipIrq, irqMisses);
+    CYCLE_PROFILE_END(profIrq, irqStart);
     gpio_put(TEST_PIN, 0); // END: Interrupt complete
 }
+#endif
+
+/**
+ * @brief Deliver control changes and run Heavy for one block into audioBuffer
+ */
+static void HOT_FUNC(renderHeavyBlock)(void)
+{
+#if GATE_INPUTS
+    renderedHeavySample = hv_getCurrentSample(heavyContext);
+#endif
+#if CONTROL_SCAN
+    // Hand changed control readings to Heavy so they take effect at this block boundary
+    for (int i = 0; controlsActive && i < ControlScanner::NUM_CHANNELS; i++)
+    {
+        const uint32_t seq = controls.getSequence(i);
+        if (seq != controlSeqSent[i])
+        {
+            controlSeqSent[i] = seq;
+            if (controlParams[i] >= 0)
+            {
+                hv_setParameter(heavyContext, controlParams[i], controls.getValue(i));
+            }
+            else
+            {
+                hv_sendFloatToReceiver(heavyContext, controlHashes[i], controls.getValue(i));
+            }
+        }
+    }
+#endif
+
+#if GATE_INPUTS
+    deliverGateEdges();
+#endif
+
+    // Process audio from Heavy
+    CYCLE_PROFILE_BEGIN(heavyStart);
+    XIP_SECTION_BEGIN(heavyMisses);
+#if CLOCK_GOVERNOR
+    const uint32_t renderStartUs = timer_hw->timerawl;
+#endif
+#if HEAVY_FIXED_BLOCK
+    hv_440tone_process_block(heavyContext, audioBuffer);
+#else
+    hv_processInline(heavyContext, NULL, audioBuffer, BUFFER_SIZE);
+#endif
+#if CLOCK_GOVERNOR
+    governor.addBlock(timer_hw->timerawl - renderStartUs); // Microseconds, not cycles: the clock moves
+#endif
+    XIP_SECTION_END(xipHeavy, heavyMisses);
+    CYCLE_PROFILE_END(profHeavy, heavyStart);
+#if USB_CAPTURE
+    usbCapture.push(audioBuffer, BUFFER_SIZE, dacChannels);
+#endif
+    samplesGenerated += BUFFER_SIZE;
+}
+
+#if DEADLINE_MONITOR
+/**
+ * @brief Render one block into audioBuffer, or shed it, as the deadline monitor's step asks
+ *
+ * A shed block is not rendered: the last sample sent fades linearly to mid-scale over the
+ * block, and the next rendered block fades in from there, so skipping never steps the
+ * output. Heavy's clock stands still meanwhile: the patch loses time, not its place.
+ *
+ * @return Producer time the block took, in microseconds
+ */
+static uint32_t HOT_FUNC(renderOutputBlock)(void)
+{
+    const uint32_t startUs = timer_hw->timerawl;
+    const ShedStep &step = SHED_STEPS[deadline.getStep()];
+
+    if (step.skipEvery != 0 && ++shedPhase >= step.skipEvery)
+    {
+        shedPhase = 0;
+        for (int ch = 0; ch < dacChannels; ch++)
+        {
+            float *out = &audioBuffer[ch * BUFFER_SIZE];
+            const float last = out[BUFFER_SIZE - 1];
+            for (int i = 0; i < BUFFER_SIZE; i++)
+            {
+                out[i] = last * (float)(BUFFER_SIZE - 1 - i) * (1.0f / BUFFER_SIZE);
+            }
+        }
+        shedFadeIn = true;
+        shedBlocks = shedBlocks + 1;
+        return timer_hw->timerawl - startUs;
+    }
+
+    const int channels = step.mono ? 1 : dacChannels;
+    if (channels != shedChannels)
+    {
+        hv_440tone_set_output_mask(heavyContext, (1u << channels) - 1);
+        shedChannels = channels;
+    }
+    renderHeavyBlock();
+#if DAC_CHANNELS == 2
+    if (channels < dacChannels)
+    {
+        for (int i = 0; i < BUFFER_SIZE; i++)
+        {
+            audioBuffer[BUFFER_SIZE + i] = audioBuffer[i]; // The right DAC plays the left output
+        }
+    }
+#endif
+
+    if (shedFadeIn)
+    {
+        for (int ch = 0; ch < dacChannels; ch++)
+        {
+            float *out = &audioBuffer[ch * BUFFER_SIZE];
+            for (int i = 0; i < BUFFER_SIZE; i++)
+            {
+                out[i] *= (float)(i + 1) * (1.0f / BUFFER_SIZE);
+            }
+        }
+        shedFadeIn = false;
+    }
+    return timer_hw->timerawl - startUs;
+}
+
+/**
+ * @brief Samples the output still has queued ahead of the producer
+ *
+ * In DMA block mode the streaming block is counted in full, so this is high by up to one block.
+ */
+static inline uint32_t outputSlack(void)
+{
+#if DAC_OUTPUT_MODE == DAC_OUTPUT_TIMER_IRQ
+    return dacBlocksQueued() * BUFFER_SIZE - blockReadPos;
+#else
+    // The oldest block may only be draining its last sample
+    const uint32_t queued = dacBlocksQueued();
+    return queued > 1 ? (queued - 1) * BUFFER_SIZE : 0;
+#endif
+}
+
+/**
+ * @brief Hand one block's time and slack to the deadline monitor and apply a step change
+ */
+static inline void monitorBlock(uint32_t busyUs, uint32_t slackSamples)
+{
+    const int change = deadline.addBlock(busyUs, slackSamples);
+    if (change != 0)
+    {
+        shedPhase = 0;
+    }
+#if EVENT_LOG
+    if (change > 0)
+    {
+        eventLog.record(EVENT_LOAD_SHED, slackSamples, (uint32_t)deadline.getStep());
+    }
+#endif
+}
+#endif
+
+/**
+ * @brief Convert one block of samples into a free output block and publish it
+ */
+static void HOT_FUNC(queueDacBlock)(const float *samples, DacBlock *block)
+{
+    // Convert and pre-format the whole block as I2C data_cmd words
+    CYCLE_PROFILE_BEGIN(convertStart);
+    XIP_SECTION_BEGIN(convertMisses);
+#if DAC_DITHER
+    TpdfDither *const dither = &dacDither;
+#else
+    TpdfDither *const dither = NULL;
+#endif
+    audioBlockToDacWords(samples, block->words, BUFFER_SIZE, dither, DAC_SAMPLE_WORDS);
+#if DAC_CHANNELS == 2
+    if (dacChannels == 2)
+    {
+        // Right channel into the second half of each sample record (second DAC)
+        audioBlockToDacWords(samples + BUFFER_SIZE, block->words + DAC_WORDS_PER_SAMPLE, BUFFER_SIZE, dither,
+                             DAC_SAMPLE_WORDS);
+    }
+#endif
+    XIP_SECTION_END(xipConvert, convertMisses);
+    CYCLE_PROFILE_END(profConvert, convertStart);
+#if GATE_INPUTS
+    block->heavySample = renderedHeavySample;
+#endif
+
+    // Publish the block (release store: all of its words are visible to the IRQ first)
+    dacBlockQueue.commit();
+}
+
+#if ELASTIC_RESAMPLER
+/**
+ * @brief Local time the next Heavy block of the schedule is due
+ */
+static inline uint64_t heavyDueUs(void)
+{
+    return heavyStartUs + heavyBlockDue * BUFFER_SIZE * 1000000ull / (uint32_t)HEAVY_SAMPLE_RATE;
+}
+
+/**
+ * @brief Start the Heavy schedule now (the resampler keeps its fill)
+ */
+static void startHeavySchedule(void)
+{
+    // The last pre-filled block counts as block 0, the next one is due one block period from now
+    heavyStartUs = time_us_64();
+    heavyBlockDue = 1;
+    heavyLastDueUs = heavyStartUs;
+}
+
+/**
+ * @brief Run Heavy into the resampler if its next block is due, and resample into a free output block
+ *
+ * Heavy keeps its own time base, so the DAC side may run at any nearby rate. A Heavy block
+ * that does not fit the resampler FIFO is dropped and counted as an overrun, so the patch
+ * never falls behind the local clock.
+ *
+ * @return true if either side did work, false if there is nothing to do yet
+ */
+static bool HOT_FUNC(produceAudio)(void)
+{
+    bool worked = false;
+
+    const uint64_t now = time_us_64();
+    if (now >= heavyDueUs())
+    {
+#if GATE_INPUTS
+        // Heavy runs on the local clock here: its schedule is the anchor
+        setGateAnchor((uint32_t)heavyDueUs(), hv_getCurrentSample(heavyContext));
+#endif
+#if DEADLINE_MONITOR
+        const uint32_t busyUs = renderOutputBlock();
+        // The resampler FIFO is part of the slack: Heavy may be that late before the DAC notices
+        const uint32_t slackSamples = resampler.fill() + outputSlack();
+#else
+        renderHeavyBlock();
+#endif
+        if (resampler.space() >= BUFFER_SIZE)
+        {
+            // Use left channel
+            resampler.write(audioBuffer, BUFFER_SIZE);
+        }
+        else
+        {
+            bufferOverruns += BUFFER_SIZE;
+#if EVENT_LOG
+            eventLog.record(EVENT_OVERRUN, resampler.fill(), BUFFER_SIZE);
+#endif
+        }
+        heavyLastDueUs = heavyDueUs();
+        heavyBlockDue++;
+        worked = true;
+#if DEADLINE_MONITOR
+        monitorBlock(busyUs, slackSamples);
+#endif
+    }
+
+    DacBlock *block = dacBlockQueue.writeSlot();
+    if (block != nullptr)
+    {
+        // Samples Heavy's clock has produced since its last block, so the fill error has no block steps
+        const float elapsed = (float)(time_us_64() - heavyLastDueUs) * (HEAVY_SAMPLE_RATE / 1000000.0f);
+        if (resampler.read(resampledBuffer, BUFFER_SIZE, elapsed))
+        {
+            queueDacBlock(resampledBuffer, block);
+            worked = true;
+        }
+    }
+    return worked;
+}
+
+/**
+ * @brief Sleep until an IRQ event or until the next Heavy block is due
+ */
+static inline void waitForWork(void)
+{
+    best_effort_wfe_or_timeout(from_us_since_boot(heavyDueUs()));
+}
+#else
+/**
+ * @brief Run Heavy for one block and hand the samples to the output queue
+ *
+ * This is the only producer of the SPSC queue. The consumer is the output IRQ on
+ * core 0, so this may run either in the core 0 main loop or on core 1.
+ *
+ * @return true if a block was generated, false if every block is queued
+ */
+static bool HOT_FUNC(produceAudio)(void)
+{
+    // Fill every block the IRQ side has handed back
+    DacBlock *block = dacBlockQueue.writeSlot();
+    if (block == nullptr)
+    {
+        return false;
+    }
+
+#if DEADLINE_MONITOR
+    const uint32_t busyUs = renderOutputBlock();
+    const uint32_t slackSamples = outputSlack(); // What plays before this block does
+#else
+    renderHeavyBlock();
+#endif
+
+    // Use left channel
+    queueDacBlock(audioBuffer, block);
+#if DEADLINE_MONITOR
+    monitorBlock(busyUs, slackSamples);
+#endif
+    return true;
+}
+
+/**
+ * @brief Sleep until the IRQ hands a block back (or any other event)
+ */
+static inline void waitForWork(void)
+{
+    __wfe();
+}
+#endif
+
+#if CYCLE_PROFILE
+/**
+ * @brief Clear the profiled sections and set their deadlines in cycles of the current clk_sys
+ * @return clk_sys cycles per microsecond, for cycleStatPrint()
+ */
+static uint32_t cycleProfileStart(void)
+{
+    // Deadlines: one sample period for the IRQ, one block period for each producer stage
+    const uint32_t cyclesPerUs = clock_get_hz(clk_sys) / 1000000;
+    cycleStatInit(&profIrq, DAC_OUTPUT_MODE == DAC_OUTPUT_TIMER_IRQ ? "timer IRQ" : "DMA block IRQ",
+                  TIMER_PERIOD_US * cyclesPerUs);
+    cycleStatInit(&profHeavy, "hv_processInline", BUFFER_SIZE * TIMER_PERIOD_US * cyclesPerUs);
+    cycleStatInit(&profConvert, "DAC conversion", BUFFER_SIZE * TIMER_PERIOD_US * cyclesPerUs);
+    return cyclesPerUs;
+}
+#endif
+
+#if HEAVY_ON_CORE1
+/**
+ * @brief Core 1 entry point: dedicated Heavy producer loop
+ */
+static void HOT_FUNC(core1Entry)(void)
+{
+#if CYCLE_PROFILE
+    cycleProfilerInit(); // core 1 has its own DWT
+#endif
+    while (true)
+    {
+        if (!produceAudio())
+        {
+            // Every block is queued - sleep until the IRQ hands one back
+            waitForWork();
+        }
+    }
+}
+#endif
+
+/**
+ * @brief Start-up failure: blink the LED forever
+ */
+static void haltBlinking(void)
+{
+#if FAST_BOOT
+    bootLog.flush(); // The error message is still in RAM
+#endif
+    while (1)
+    {
+        gpio_put(LED_PIN, !gpio_get(LED_PIN));
+        sleep_ms(100);
+    }
+}
 
 int main()
 {
@@ -206,14 +1101,46 @@ int main()
     // Note: RP2350 hardware FPU is automatically enabled by Pico SDK
     // Heavy's DSP processing will use hardware floating-point instructions
 
+#if FAST_BOOT
+    // Nobody waits for a serial terminal: printf only fills RAM until the output runs
+    bootLog.begin();
+#else
     sleep_ms(2000); // Wait for USB serial
+#endif
 
     printf("\n=== Timer-Driven 440Hz Tone Test ===\n");
     printf("Hardware FPU: Enabled (Cortex-M33 FPv5)\n");
     printf("FPU: Hardware floating-point enabled\n");
     printf("DAC Sample Rate: %d Hz (Hardware Timer)\n", DAC_SAMPLE_RATE);
     printf("Heavy Sample Rate: %.0f Hz\n", HEAVY_SAMPLE_RATE);
-    printf("Ring Buffer Size: %d samples\n", RING_BUFFER_SIZE);
+    printf("Output Queue: %d blocks x %d samples\n", DAC_BLOCK_COUNT, BUFFER_SIZE);
+#if USB_CAPTURE
+    usbCapture.init((CaptureFormat)USB_CAPTURE_FORMAT);
+    printf("USB capture: %s blocks on the USB CDC port, status on UART\n", USB_CAPTURE_FORMAT ? "f32" : "s16");
+#endif
+#if ELASTIC_RESAMPLER
+    printf("Elastic resampler: target fill %d samples, +/-%d ppm\n", ELASTIC_TARGET_FILL, ELASTIC_MAX_PPM);
+#endif
+#if EVENT_LOG
+    eventLog.init();
+    printf("Event log: %d entries, 'e' on UART dumps it, 'c' clears it\n", EVENT_LOG_SIZE);
+#endif
+
+#if CYCLE_PROFILE
+    cycleProfilerInit();
+    uint32_t cyclesPerUs = cycleProfileStart();
+    printf("Cycle profiling: DWT CYCCNT at %lu MHz\n", cyclesPerUs);
+#if CLOCK_GOVERNOR
+    uint32_t profileSwitches = 0; // governor switches the current profile was counted after
+#endif
+#endif
+#if XIP_STATS
+    xipSectionInit(&xipIrq, DAC_OUTPUT_MODE == DAC_OUTPUT_TIMER_IRQ ? "timer IRQ" : "DMA block IRQ");
+    xipSectionInit(&xipHeavy, "hv_processInline");
+    xipSectionInit(&xipConvert, "DAC conversion");
+    xipStatsClear();
+    printf("XIP stats: cache hit/miss counters, hot path %s\n", HOT_PATH_IN_RAM ? "in SRAM" : "in flash");
+#endif
 
     // Initialize LED
     gpio_init(LED_PIN);
@@ -230,19 +1157,50 @@ int main()
     if (!dac.init())
     {
         printf("ERROR: Failed to initialize DAC!\n");
-        while (1)
-        {
-            gpio_put(LED_PIN, !gpio_get(LED_PIN));
-            sleep_ms(100);
-        }
+        haltBlinking();
     }
     printf("DAC initialized successfully.\n");
 
     // Test DAC with a few values
     printf("\nTesting DAC output...\n");
     printf("  Setting to 2.5V (DAC=2048)...\n");
+    uint32_t dacTransferUs = time_us_32();
     dac.setRaw(2048, false);
+    dacTransferUs = time_us_32() - dacTransferUs; // Blocking write: upper bound of one DMA transfer
+    printf("  Blocking write: %lu us\n", dacTransferUs);
+#if !FAST_BOOT
     sleep_ms(500);
+#endif
+
+#if DAC_CHANNELS == 2
+    // The second DAC is optional: without it only Heavy's left channel is computed
+    printf("\nProbing second MCP4725 at 0x%02X...\n", DAC1_I2C_ADDRESS);
+    if (dac1.init())
+    {
+        dac1.setRaw(2048, false);
+        dac.setFanOutAddress(DAC1_I2C_ADDRESS);
+        dacChannels = 2;
+        printf("  Two transfers per sample: ~%lu of %d us\n", 2 * dacTransferUs, TIMER_PERIOD_US);
+        if (2 * dacTransferUs >= TIMER_PERIOD_US)
+        {
+            printf("WARNING: Both transfers do not fit in one sample period, lower DAC_SAMPLE_RATE\n");
+        }
+    }
+    else
+    {
+        printf("WARNING: No DAC at 0x%02X, right channel disabled\n", DAC1_I2C_ADDRESS);
+    }
+#endif
+
+#if CONTROL_SCAN
+    // Blocking ADC setup must happen before the DAC owns the bus
+    printf("\nInitializing ADC121C027 control scanner...\n");
+    controlsActive = controls.init();
+    if (!controlsActive)
+    {
+        printf("WARNING: No ADC, running without pot/CV input\n");
+    }
+#endif
 
     // Initialize Heavy audio engine
     printf("\nInitializing Heavy audio engine...\n");
@@ -250,21 +1208,60 @@ int main()
     if (!heavyContext)
     {
         printf("ERROR: Failed to create Heavy context!\n");
-        while (1)
-        {
-            gpio_put(LED_PIN, !gpio_get(LED_PIN));
-            sleep_ms(100);
-        }
+        haltBlinking();
     }
 
     printf("Heavy context created:\n");
     printf("  Sample rate: %.0f Hz\n", hv_getSampleRate(heavyContext));
     printf("  Input channels: %d\n", hv_getNumInputChannels(heavyContext));
     printf("  Output channels: %d\n", hv_getNumOutputChannels(heavyContext));
+    // Outputs without a DAC are neither computed nor converted
+    hv_440tone_set_output_mask(heavyContext, (1u << dacChannels) - 1);
+#if DEADLINE_MONITOR
+    shedChannels = dacChannels;
+#endif
+    printf("  Computed outputs: %d (mask 0x%x)\n", dacChannels, (1u << dacChannels) - 1);
+#if CONTROL_SCAN
+    int numControlParams = 0;
+    const int numParams = hv_getParameterInfo(heavyContext, 0, NULL);
+    for (int i = 0; i < ControlScanner::NUM_CHANNELS; i++)
+    {
+        controlHashes[i] = hv_stringToHash(ControlScanner::CHANNELS[i].name);
+        controlParams[i] = -1;
+        for (int p = 0; p < numParams; p++)
+        {
+            HvParameterInfo info;
+            hv_getParameterInfo(heavyContext, p, &info);
+            if (info.hash == controlHashes[i])
+            {
+                controlParams[i] = p; // Coalesced in the parameter block instead of one message per reading
+                numControlParams++;
+            }
+        }
+        controlSeqSent[i] = 0; // Deliver the initial readings with the first block
+    }
+    printf("  Controls: %d of %d as parameters\n", numControlParams, ControlScanner::NUM_CHANNELS);
+#endif
+#if GATE_INPUTS
+    for (int i = 0; i < GateInput::NUM_INPUTS; i++)
+    {
+        gateHashes[i] = hv_stringToHash(GateInput::INPUTS[i].name);
+    }
+    printf("  Gates: %s, %s, %d samples edge to output\n", GateInput::INPUTS[0].name, GateInput::INPUTS[1].name,
+           GATE_LATENCY_SAMPLES);
+#endif
+#if HV_ARENA
+    printf("  Arena: %u / %u bytes used%s\n", (unsigned)hv_arena_used(), (unsigned)hv_arena_size(),
+           HV_ARENA_SEAL ? ", sealed on first process()" : "");
+#endif
 
+#if !FAST_BOOT
     // Test Heavy output
     printf("\nTesting Heavy engine output...\n");
     hv_processInline(heavyContext, NULL, audioBuffer, BUFFER_SIZE);
+#if USB_CAPTURE
+    usbCapture.push(audioBuffer, BUFFER_SIZE, dacChannels); // Block 0 of the capture sequence
+#endif
     printf("First 8 samples (Left channel):\n");
     for (int i = 0; i < 8; i++)
     {
@@ -272,67 +1269,115 @@ int main()
         printf("  [%d] %.4f -> DAC=%u\n", i, audioBuffer[i], dacVal);
     }
 
-    // Pre-fill ring buffer with some samples to prevent initial underrun
-    printf("\nPre-filling ring buffer...\n");
-    for (int buf = 0; buf < 4; buf++)
+    // Compare the oscillator shapes (one exact period, all harmonics up to Nyquist)
+    double thdPoly = thdMeasure(hv_wavetable_polyCos);
+    double thdTable = thdMeasure(hv_wavetable_cos);
+    printf("Oscillator THD: polynomial %.5f%% (%.1f dB), wavetable %u pts %.5f%% (%.1f dB)\n",
+           thdPoly * 100.0, 20.0 * log10(thdPoly), HV_WAVETABLE_SIZE, thdTable * 100.0, 20.0 * log10(thdTable));
+    printf("  Active oscillator: %s\n", HV_OSC_WAVETABLE ? "wavetable" : "polynomial");
+#endif
+
+#if DAC_OUTPUT_MODE == DAC_OUTPUT_DMA_BLOCK
+    // Build the per-sample pointer tables once - block addresses never change
+    for (int buf = 0; buf < DAC_BLOCK_COUNT; buf++)
     {
-        hv_processInline(heavyContext, NULL, audioBuffer, BUFFER_SIZE);
         for (int i = 0; i < BUFFER_SIZE; i++)
         {
-            ringBuffer[writeIndex] = audioToDAC(audioBuffer[i]);
-            writeIndex = (writeIndex + 1) & RING_BUFFER_MASK;
+            dacBlockSamplePtrs[buf][i] = &dacBlockQueue.slot(buf).words[i * DAC_SAMPLE_WORDS];
+            dacHoldSamplePtrs[i] = dacHoldWords;
+        }
+    }
+    for (int ch = 0; ch < DAC_CHANNELS; ch++)
+    {
+        formatDacWords(2048, &dacHoldWords[ch * DAC_WORDS_PER_SAMPLE]); // Mid-scale until the first block has been sent
+    }
+#endif
+
+    // Pre-fill every block to prevent initial underrun
+    printf("\nPre-filling DAC blocks...\n");
+#if ELASTIC_RESAMPLER
+    // Run Heavy as fast as the blocks need it, then top the resampler up to its target fill
+    resampler.init(ELASTIC_TARGET_FILL);
+    DacBlock *prefillBlock;
+    while ((prefillBlock = dacBlockQueue.writeSlot()) != nullptr)
+    {
+        while (!resampler.read(resampledBuffer, BUFFER_SIZE, 0.0f))
+        {
+            renderHeavyBlock();
+            resampler.write(audioBuffer, BUFFER_SIZE);
         }
+        queueDacBlock(resampledBuffer, prefillBlock);
+    }
+    while (resampler.fill() + BUFFER_SIZE <= ELASTIC_TARGET_FILL)
+    {
+        renderHeavyBlock();
+        resampler.write(audioBuffer, BUFFER_SIZE);
+    }
+    resampler.resetControl(); // The pre-fill reads are not clock errors
+    printf("Resampler pre-filled with %lu samples (target %d).\n", resampler.fill(), ELASTIC_TARGET_FILL);
+#else
+    while (produceAudio())
+    {
+    }
+#endif
+    printf("DAC blocks pre-filled with %lu samples.\n", dacBlocksQueued() * BUFFER_SIZE);
+
+#if DEADLINE_MONITOR
+    // Armed once the queue is full: the pre-fill starts from no slack at all
+    for (int i = 0; i < NUM_SHED_STEPS; i++)
+    {
+        shedStepNames[i] = SHED_STEPS[i].name;
+    }
+    deadline.init(BUFFER_SIZE * TIMER_PERIOD_US, BUFFER_SIZE, shedStepNames, NUM_SHED_STEPS);
+    printf("\nDeadline monitor: shed above %d%% load, recover under %d%%, steps:", DEADLINE_MONITOR_HIGH_PCT,
+           DEADLINE_MONITOR_LOW_PCT);
+    for (int i = 1; i < NUM_SHED_STEPS; i++)
+    {
+        printf(" %s%s", SHED_STEPS[i].name, i + 1 < NUM_SHED_STEPS ? "," : "\n");
     }
-    printf("Ring buffer pre-filled with %lu samples.\n", ringBufferAvailable());
+#endif
 
     // ============================================================================
     // DMA SETUP FOR NON-BLOCKING I2C TRANSFERS
     // ============================================================================
-    // DMA enables 44.1kHz operation by offloading I2C communication to hardware.
+    // DMA enables 40kHz operation by offloading I2C communication to hardware.
     // The CPU only queues transfers (<1μs), while DMA handles the actual I2C
     // protocol (START, address, data, STOP) asynchronously.
+    // MCP4725::beginAsync() sets the I2C target address once and claims a 16-bit DMA
+    // channel into the I2C data_cmd register (DREQ = I2C TX). In DMA block mode it also
+    // claims the sample clock (DMA pacing timer or PWM slice, DAC_SAMPLE_CLOCK) and the pacing
+    // channel that issue one sample per DAC_SAMPLE_RATE tick.
 
     printf("\nSetting up DMA for I2C...\n");
 
-    // Configure I2C peripheral with target address (done once at startup)
-    // The I2C peripheral remembers the target address for all transfers
-    i2c_hw_t *i2c_hw = i2c_get_hw(DAC_I2C_PORT);
-    i2c_hw->enable = 0;            // Disable to modify settings
-    i2c_hw->tar = DAC_I2C_ADDRESS; // Set target address (0x60)
-    i2c_hw->enable = 1;            // Re-enable
-
-    // Claim an unused DMA channel for our I2C transfers
-    dma_chan = dma_claim_unused_channel(true);
-    dma_channel_config dma_cfg = dma_channel_get_default_config(dma_chan);
-
-    // DMA CONFIGURATION:
-    // - Transfer size: 16-bit (matches I2C data_cmd register width)
-    // - Read increment: YES (read successive bytes from our buffer)
-    // - Write increment: NO (always write to same I2C register)
-    // - DREQ: I2C TX (DMA waits for I2C FIFO to have space)
-    channel_config_set_transfer_data_size(&dma_cfg, DMA_SIZE_16);
-    channel_config_set_read_increment(&dma_cfg, true);
-    channel_config_set_write_increment(&dma_cfg, false);
-    channel_config_set_dreq(&dma_cfg, i2c_get_dreq(DAC_I2C_PORT, true)); // TX DREQ
-
-    // Configure the DMA channel:
-    // - Write to: I2C data_cmd register (feeds TX FIFO)
-    // - Read from: dma_i2c_buffer (set per-transfer in interrupt)
-    // - Count: 3 words (16-bit each) = MCP4725 command + 2 data bytes
-    // - Don't start yet: transfers are triggered from timer interrupt
-    dma_channel_configure(
-        dma_chan,
-        &dma_cfg,
-        &i2c_hw->data_cmd, // Destination: I2C data_cmd register
-        NULL,              // Source: set dynamically in interrupt
-        3,                 // Transfer count: 3 x 16-bit words
-        false              // Don't start automatically
-    );
-    printf("DMA channel %d configured for I2C.\n", dma_chan);
-    printf("  Transfer size: 16-bit (I2C data_cmd register)\n");
-    printf("  DREQ: I2C1 TX (hardware paced)\n");
+#if DAC_OUTPUT_MODE == DAC_OUTPUT_TIMER_IRQ
+    const uint32_t pacedRate = 0; // Timer IRQ submits each sample
+#else
+    const uint32_t pacedRate = DAC_SAMPLE_RATE;
+#endif
+    if (!dac.beginAsync(pacedRate, (MCP4725::SampleClock)DAC_SAMPLE_CLOCK, (MCP4725::WireFormat)DAC_STREAM))
+    {
+        printf("ERROR: Failed to set up DAC DMA!\n");
+        haltBlinking();
+    }
+#if CLOCK_GOVERNOR
+    // Levels depend on what the DAC setup can be retimed to (no DAC_STREAM, fan-out or PWM clock)
+    governor.init(&dac, BUFFER_SIZE * TIMER_PERIOD_US);
+#endif
+#if DAC_STREAM
+    printf("  Target: 0x%02X @ 2MHz I2C, one open transaction (18 SCL cycles per sample)\n", DAC_I2C_ADDRESS);
+#else
     printf("  Target: 0x%02X @ 2MHz I2C (~12μs per transfer)\n", DAC_I2C_ADDRESS);
+#endif
+#if DAC_CHANNELS == 2
+    if (dacChannels == 2)
+    {
+        printf("  Fan-out: 0x%02X after every sample, same words block (STOP_DET IRQ switches the target)\n",
+               DAC1_I2C_ADDRESS);
+    }
+#endif
 
+#if DAC_OUTPUT_MODE == DAC_OUTPUT_TIMER_IRQ
     // Set up hardware timer interrupt
     printf("\nSetting up hardware timer...\n");
 
@@ -344,11 +1389,50 @@ int main()
     hw_set_bits(&timer_hw->inte, 1u << 0);
 
     // Set first alarm
-    timer_hw->alarm[0] = timer_hw->timerawl + TIMER_PERIOD_US;
+    timerNextAlarm = timer_hw->timerawl + TIMER_PERIOD_US;
+    timer_hw->alarm[0] = timerNextAlarm;
 
     printf("Timer interrupt enabled at %d Hz.\n", DAC_SAMPLE_RATE);
+#else
+    // One completion callback per block, from the driver's DMA IRQ
+    dac.setCompletionCallback(dacBlockComplete);
+
+    blockActive = true;
+    dacUpdates += BUFFER_SIZE;
+    dac.submitPacedBlock(dacBlockSamplePtrs[0], BUFFER_SIZE);
+
+    printf("  Block IRQ rate: %.1f Hz (%d samples per block)\n", dac.getPacedRate() / BUFFER_SIZE, BUFFER_SIZE);
+#endif
+
+#if ELASTIC_RESAMPLER
+    // Heavy's local-clock schedule starts with the output
+    startHeavySchedule();
+#endif
+    const uint32_t outputStartUs = time_us_32(); // The timer counts from reset: boot ROM, runtime init and main()
+
+#if CONTROL_SCAN
+    if (controlsActive)
+    {
+        controls.begin(CONTROL_SCAN_RATE_HZ, TIMER_PERIOD_US, dacTransferUs);
+        printf("  Control rate: %d reads/s, %d Hz per channel\n", CONTROL_SCAN_RATE_HZ,
+               CONTROL_SCAN_RATE_HZ / ControlScanner::NUM_CHANNELS);
+    }
+#endif
+
+#if GATE_INPUTS
+    // Edges are timed against the output clock, so capture starts once the output runs (GPIO IRQ on core 0)
+    printf("\nEnabling gate inputs...\n");
+    gates.init();
+#endif
+
+#if HEAVY_ON_CORE1
+    // Heavy context and the producer side of the queue belong to core 1 from here on
+    printf("\nLaunching Heavy producer on core 1...\n");
+    multicore_launch_core1(core1Entry);
+#endif
 
     printf("\n=== Starting Audio Loop ===\n");
+    printf("Output started %lu us after reset%s\n", outputStartUs, FAST_BOOT ? " (fast boot)" : "");
     printf("Generating 440Hz tone with timer-driven DAC updates...\n");
     printf("Press Ctrl+C to stop.\n\n");
 
@@ -357,72 +1441,150 @@ int main()
     while (true)
     {
         /*
-        This code manages the process of keeping a ring buffer filled with audio samples to ensure smooth playback and avoid underruns.
-        It first checks how many samples are currently available in the ring buffer (ringBufferAvailable()) and how much free space remains (ringBufferFree()).
-        The goal is to maintain the buffer above a certain "low watermark" (here, 50% full, or 256 samples) to prevent situations where the buffer empties out (causing audio glitches)
-        or fills up too quickly (causing overruns).
+        This code keeps the output block queue filled with audio to ensure smooth playback and avoid underruns.
+        The queue holds DAC_BLOCK_COUNT blocks of BUFFER_SIZE samples, each pre-formatted as MCP4725 I2C words.
 
-        If the number of available samples drops below the low watermark, the code generates more audio data by calling hv_processInline, which fills audioBuffer with new samples.
-        It then loops through these samples, converting each floating-point value to a 12-bit DAC value using audioToDAC, and writes the result into the ring buffer.
-         Before writing, it calculates the next write position and checks if this would collide with the read index, which would indicate a buffer overrun (an unlikely event given the logic,
-         but checked for safety). If an overrun is detected, it increments the bufferOverruns counter and stops writing.
+        Whenever the IRQ side has handed a whole block back, produceAudio() runs Heavy for one block (renderHeavyBlock:
+        hv_440tone_process_block() with HEAVY_FIXED_BLOCK, else hv_processInline()), converts the whole block with
+        audioBlockToDacWords() straight into the free block's I2C words, then publishes the block. There are no
+        per-sample bounds checks: a block is either entirely free or entirely queued.
 
-        If the buffer is already sufficiently full, the code waits briefly (sleep_us(500)) before checking again. This approach helps maintain a steady flow of audio data,
-        reducing the risk of both underruns (buffer running empty) and overruns (buffer overflowing), which are critical for real-time audio applications.
+        With ELASTIC_RESAMPLER, Heavy runs on its own schedule into the resampler FIFO instead, and produceAudio()
+        fills the free block from the resampler. With DEADLINE_MONITOR, renderOutputBlock() may shed the block (mono,
+        or a fade to mid-scale instead of rendering) when the producer runs out of time.
 
-        */
+        When every block is queued, the loop sleeps with __wfe() instead of polling. The IRQ that hands a block back
+        issues __sev(), so the producer wakes exactly when there is work to do, without adding poll jitter.
 
-        // Check if ring buffer needs refilling
-        uint32_t available = ringBufferAvailable();
-        uint32_t free = ringBufferFree();
+        */
 
-        // Keep buffer topped up - generate samples when below watermark (50% = 256 samples)
-        // This prevents boom/bust cycles and reduces underruns
-        if (available < BUFFER_LOW_WATERMARK)
+#if HEAVY_ON_CORE1
+        // Core 1 owns the Heavy context - core 0 only services IRQs and prints status
+        sleep_ms(1);
+#else
+        if (!produceAudio())
         {
-            // Process audio from Heavy
-            hv_processInline(heavyContext, NULL, audioBuffer, BUFFER_SIZE);
-            samplesGenerated += BUFFER_SIZE;
-
-            // Convert and write to ring buffer (use left channel)
-            for (int i = 0; i < BUFFER_SIZE; i++)
-            {
-                uint32_t nextWrite = (writeIndex + 1) & RING_BUFFER_MASK;
-
-                // Check for buffer overrun (should never happen with our logic)
-                if (nextWrite == readIndex)
-                {
-                    bufferOverruns++;
-                    break;
-                }
+            // Every block is queued - sleep until the next IRQ (block hand-back or sample tick)
+            waitForWork();
+        }
+#endif
 
-                ringBuffer[writeIndex] = audioToDAC(audioBuffer[i]);
-                writeIndex = nextWrite;
-            }
+#if USB_CAPTURE
+        usbCapture.service();
+#endif
+#if CLOCK_GOVERNOR
+        governor.update();
+#endif
+#if FAST_BOOT
+        // Start-up log to the UART, a FIFO's worth at a time, until printf can have the UART back
+        bootLog.service();
+#endif
+#if EVENT_LOG
+        // UART commands: 'e' dumps the glitch log, 'c' clears it (a register read unless a key came in)
+        const int command = uart_is_readable(uart_default) ? getchar_timeout_us(0) : PICO_ERROR_TIMEOUT;
+        if (command == 'e')
+        {
+            eventLog.dump();
         }
-        else
+        else if (command == 'c')
         {
-            // Ring buffer is full, wait a bit
-            sleep_us(500);
+            eventLog.clear();
+            printf("Event log cleared\n");
         }
+#endif
 
         // Print status every 5 seconds
         uint32_t now = to_ms_since_boot(get_absolute_time());
         if (now - lastPrintTime >= 5000)
         {
-            uint32_t buffered = ringBufferAvailable();
-            float fillPercent = (buffered * 100.0f) / RING_BUFFER_SIZE;
+            uint32_t buffered = dacBlocksQueued() * BUFFER_SIZE;
+            float fillPercent = (buffered * 100.0f) / (DAC_BLOCK_COUNT * BUFFER_SIZE);
 
             // Calculate actual DAC update rate
             uint64_t currentTime = time_us_64();
             uint32_t dacDelta = dacUpdates - lastDacCount;
             float elapsedSec = (currentTime - lastMeasureTime) / 1000000.0f;
             float actualDacRate = dacDelta / elapsedSec;
+#if ELASTIC_RESAMPLER
+            // The resampler reads HEAVY_SAMPLE_RATE-clocked input at the DAC rate times its step
+            float predictedFreq = 440.0f * (actualDacRate * (1.0f + resampler.getCorrectionPpm() * 1e-6f) / HEAVY_SAMPLE_RATE);
+#else
             float predictedFreq = 440.0f * (actualDacRate / HEAVY_SAMPLE_RATE);
+#endif
 
             printf("DAC: %lu (%.0f Hz actual) | Heavy: %.0f Hz | Freq: %.1f Hz | Buffer: %lu (%.1f%%) | U/O: %lu/%lu\n",
                    dacUpdates, actualDacRate, HEAVY_SAMPLE_RATE, predictedFreq,
                    buffered, fillPercent, bufferUnderruns, bufferOverruns);
+#if ELASTIC_RESAMPLER
+            printf("  Resampler: %+.1f ppm | Fill: %lu (target %lu, error %+.2f) | Starved: %lu\n",
+                   resampler.getCorrectionPpm(), resampler.fill(), resampler.getTarget(), resampler.getError(),
+                   resampler.getStarvedCount());
+#endif
+            if (dac.getAsyncErrorCount() != 0)
+            {
+                printf("  I2C aborts: %lu (last %d, IC_TX_ABRT_SOURCE 0x%08lx)\n", dac.getAsyncErrorCount(),
+                       (int)dac.getLastAsyncError(), dac.getLastAbortSource());
+            }
+            if (dac.getFanOutLateCount() != 0)
+            {
+                printf("  Fan-out late: %lu samples (DAC1 held its value, the sample period was too short)\n",
+                       dac.getFanOutLateCount());
+            }
+#if CONTROL_SCAN
+            if (controlsActive)
+            {
+                controls.printStatus();
+            }
+#endif
+#if USB_CAPTURE
+            usbCapture.printStatus();
+#endif
+#if CLOCK_GOVERNOR
+            governor.printStatus();
+#endif
+#if DEADLINE_MONITOR
+            deadline.printStatus();
+            if (shedBlocks != 0)
+            {
+                printf("  Shed: %lu blocks faded out instead of rendered\n", shedBlocks);
+            }
+#endif
+#if GATE_INPUTS
+            gates.printStatus();
+            if (gateLateEdges != 0)
+            {
+                printf("  Gate edges late: %lu (raise GATE_LATENCY_SAMPLES)\n", gateLateEdges);
+            }
+#endif
+#if EVENT_LOG
+            if (eventLog.getEntryCount() != 0)
+            {
+                eventLog.printStatus();
+            }
+#endif
+#if CYCLE_PROFILE
+#if CLOCK_GOVERNOR
+            // Cycles only convert to time at the clock they were counted at: a switch restarts the profile
+            if (governor.getSwitchCount() != profileSwitches)
+            {
+                profileSwitches = governor.getSwitchCount();
+                cyclesPerUs = cycleProfileStart();
+                printf("  Cycle profile restarted: clk_sys now %lu MHz\n", cyclesPerUs);
+            }
+            else
+#endif
+            {
+                cycleStatPrint(&profIrq, cyclesPerUs);
+                cycleStatPrint(&profHeavy, cyclesPerUs);
+                cycleStatPrint(&profConvert, cyclesPerUs);
+            }
+#endif
+#if XIP_STATS
+            xipStatsPrint();
+            xipSectionPrint(&xipIrq);
+            xipSectionPrint(&xipHeavy);
+            xipSectionPrint(&xipConvert);
+#endif
 
             lastDacCount = dacUpdates;
             lastMeasureTime = currentTime;